@@ -101,6 +101,11 @@ public:
    */
   float getFOV() const { return fov; }
 
+  /**
+   * Get viewport height in pixels
+   */
+  float getScreenHeight() const { return scrHeight; }
+
   /**
    * Set camera FOV
    */
@@ -12,6 +12,9 @@ struct ClothSettings {
   float damping = 0.0f;
   float gravityScale = 1.0f;
   int solverSubsteps = 4;
+  // Distance particles keep from the solver's static distance fields,
+  // terrain and moving cloth obstacles
+  float collisionThickness = 0.01f;
   std::vector<uint32_t> pinnedParticleIndices;
 };
 
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <app/Component.hpp>
+#include <app/ComponentType.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace sauce {
+
+// Where a component lives in a registry: the pool of its concrete type and
+// its id there. Ids stay put while the pool's storage moves around.
+struct ComponentRef {
+  ComponentTypeId type = 0;
+  uint32_t id = 0;
+};
+
+// Components of one concrete type, stored by value and packed. Each component
+// keeps an id for as long as it lives; removing one moves the last into its
+// place and only that one's dense position changes.
+class ComponentPool {
+public:
+  virtual ~ComponentPool() = default;
+
+  virtual Component* get(uint32_t id) = 0;
+  virtual void erase(uint32_t id) = 0;
+  // Moves the component with id out of source, a pool of the same type, and
+  // returns its id here
+  virtual uint32_t adopt(ComponentPool& source, uint32_t id) = 0;
+  // Empty pool of the same type
+  virtual std::unique_ptr<ComponentPool> makeEmpty() const = 0;
+
+  size_t size() const { return idOf.size(); }
+
+protected:
+  // Id for the component just appended at the back of the dense storage
+  uint32_t allocateId() {
+    const auto dense = static_cast<uint32_t>(idOf.size());
+    uint32_t id;
+    if (!freeIds.empty()) {
+      id = freeIds.back();
+      freeIds.pop_back();
+      denseOf[id] = dense;
+    } else {
+      id = static_cast<uint32_t>(denseOf.size());
+      denseOf.push_back(dense);
+    }
+    idOf.push_back(id);
+    return id;
+  }
+
+  // Frees id whose component was at dense, after the last component moved there
+  void releaseId(uint32_t id, uint32_t dense) {
+    const uint32_t last = idOf.back();
+    idOf[dense] = last;
+    denseOf[last] = dense;
+    idOf.pop_back();
+    freeIds.push_back(id);
+  }
+
+  // Dense position by id, and id by dense position
+  std::vector<uint32_t> denseOf;
+  std::vector<uint32_t> idOf;
+  std::vector<uint32_t> freeIds;
+};
+
+template <typename T>
+class TypedComponentPool final : public ComponentPool {
+public:
+  template <typename... Args>
+  uint32_t emplace(Args&&... args) {
+    components.emplace_back(std::forward<Args>(args)...);
+    return allocateId();
+  }
+
+  T& at(uint32_t id) { return components[denseOf[id]]; }
+
+  Component* get(uint32_t id) override { return &at(id); }
+
+  void erase(uint32_t id) override {
+    const uint32_t dense = denseOf[id];
+    if (dense + 1 != components.size()) {
+      // Components are not assignable (their name is const), so the last one
+      // is rebuilt in the freed place
+      std::destroy_at(&components[dense]);
+      std::construct_at(&components[dense], std::move(components.back()));
+    }
+    components.pop_back();
+    releaseId(id, dense);
+  }
+
+  uint32_t adopt(ComponentPool& source, uint32_t id) override {
+    auto& typed = static_cast<TypedComponentPool&>(source);
+    components.push_back(std::move(typed.at(id)));
+    typed.erase(id);
+    return allocateId();
+  }
+
+  std::unique_ptr<ComponentPool> makeEmpty() const override {
+    return std::make_unique<TypedComponentPool>();
+  }
+
+private:
+  std::vector<T> components;
+};
+
+// Owns components by value, one pool per concrete component type, and keeps
+// one sparse set per component type id mapping an entity's index in its
+// scene to the entity's most recently added component of that type. The
+// dense arrays of a set hold only the entities that have the type, packed, so
+// a system touching one or two types walks those arrays instead of every
+// entity and every component list.
+//
+// Entities are facades over a registry: they hold the refs of their
+// components. An entity outside any scene stores its components in a
+// registry of its own and moves them into the scene's when added. An Entity
+// bound to a scene keeps its set entries up to date as components are added
+// and removed.
+class ComponentRegistry {
+public:
+  static constexpr uint32_t kAbsent = std::numeric_limits<uint32_t>::max();
+
+  struct Set {
+    // By entity index: position in the dense arrays, or kAbsent
+    std::vector<uint32_t> sparse;
+    std::vector<uint32_t> entities;
+    std::vector<ComponentRef> components;
+
+    size_t size() const { return entities.size(); }
+
+    bool contains(uint32_t entity) const {
+      return entity < sparse.size() && sparse[entity] != kAbsent;
+    }
+
+    ComponentRef get(uint32_t entity) const { return components[sparse[entity]]; }
+  };
+
+  ComponentRegistry() = default;
+  // Entities hold refs into the pools
+  ComponentRegistry(const ComponentRegistry&) = delete;
+  ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+
+  template <typename T, typename... Args>
+  ComponentRef emplace(Args&&... args) {
+    const ComponentTypeId type = componentTypeId<T>();
+    if (type >= pools.size()) {
+      pools.resize(type + 1);
+    }
+    if (!pools[type]) {
+      pools[type] = std::make_unique<TypedComponentPool<T>>();
+    }
+    auto& pool = static_cast<TypedComponentPool<T>&>(*pools[type]);
+    return { type, pool.emplace(std::forward<Args>(args)...) };
+  }
+
+  // Moves a component out of source into this registry
+  ComponentRef adopt(ComponentRegistry& source, ComponentRef ref) {
+    if (ref.type >= pools.size()) {
+      pools.resize(ref.type + 1);
+    }
+    ComponentPool& from = *source.pools[ref.type];
+    if (!pools[ref.type]) {
+      pools[ref.type] = from.makeEmpty();
+    }
+    return { ref.type, pools[ref.type]->adopt(from, ref.id) };
+  }
+
+  Component* get(ComponentRef ref) const { return pools[ref.type]->get(ref.id); }
+
+  void destroy(ComponentRef ref) { pools[ref.type]->erase(ref.id); }
+
+  // Sets entity's entry for type, adding it when missing
+  void set(ComponentTypeId type, uint32_t entity, ComponentRef component) {
+    if (type >= sets.size()) {
+      sets.resize(type + 1);
+    }
+    Set& set = sets[type];
+    if (entity >= set.sparse.size()) {
+      set.sparse.resize(entity + 1, kAbsent);
+    }
+    if (set.sparse[entity] != kAbsent) {
+      set.components[set.sparse[entity]] = component;
+      return;
+    }
+    set.sparse[entity] = static_cast<uint32_t>(set.entities.size());
+    set.entities.push_back(entity);
+    set.components.push_back(component);
+  }
+
+  // Drops entity's entry for type; the last dense entry takes its place
+  void erase(ComponentTypeId type, uint32_t entity) {
+    if (type >= sets.size() || !sets[type].contains(entity)) {
+      return;
+    }
+    Set& set = sets[type];
+    const uint32_t slot = set.sparse[entity];
+    const uint32_t last = set.entities.back();
+    set.entities[slot] = last;
+    set.components[slot] = set.components.back();
+    set.sparse[last] = slot;
+    set.sparse[entity] = kAbsent;
+    set.entities.pop_back();
+    set.components.pop_back();
+  }
+
+  // Set of one type; nullptr when no entity ever had the type
+  const Set* getSet(ComponentTypeId type) const {
+    return type < sets.size() ? &sets[type] : nullptr;
+  }
+
+  void clear() {
+    pools.clear();
+    sets.clear();
+  }
+
+private:
+  // By concrete component type id
+  std::vector<std::unique_ptr<ComponentPool>> pools;
+  // By component type id, base types included
+  std::vector<Set> sets;
+};
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <app/Component.hpp>
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sauce
+{
+
+// Dense id of a component type, handed out the first time the type is used.
+// Ids are dense so they can index masks and per-type tables directly, which
+// rules out deriving them at compile time from the type alone: no translation
+// unit sees every component type. The price is that an id depends on the order
+// in which types are first used, so ids differ between runs and builds and are
+// never saved or sent anywhere; within one process they are stable.
+using ComponentTypeId = uint32_t;
+
+// Types past this many make componentTypeId throw std::length_error; raise it
+// (it sizes ComponentMask) when the engine outgrows it
+inline constexpr ComponentTypeId kMaxComponentTypes = 64;
+
+// One bit per component type id
+using ComponentMask = std::bitset<kMaxComponentTypes>;
+
+namespace detail
+{
+
+// Atomic because different types may take their first id on different
+// threads at once
+inline ComponentTypeId nextComponentTypeId()
+{
+  static std::atomic<ComponentTypeId> next{0};
+  const ComponentTypeId id = next.fetch_add(1, std::memory_order_relaxed);
+  if (id >= kMaxComponentTypes) {
+    throw std::length_error("sauce: more than kMaxComponentTypes component types");
+  }
+  return id;
+}
+
+template <typename T>
+concept HasComponentBase = requires { typename T::ComponentBase; };
+
+template <typename T>
+constexpr size_t componentTypeDepth()
+{
+  if constexpr (HasComponentBase<T>) {
+    static_assert(std::is_base_of_v<typename T::ComponentBase, T>,
+                  "ComponentBase must be a base class of the component");
+    return 1 + componentTypeDepth<typename T::ComponentBase>();
+  } else {
+    return 1;
+  }
+}
+
+} // namespace detail
+
+template <typename T>
+ComponentTypeId componentTypeId()
+{
+  static_assert(std::is_base_of_v<Component, T> && !std::is_same_v<Component, T>,
+                "component types derive from sauce::Component");
+  static const ComponentTypeId id = detail::nextComponentTypeId();
+  return id;
+}
+
+namespace detail
+{
+
+template <typename T, size_t N>
+void fillComponentTypeIds(std::array<ComponentTypeId, N>& ids, size_t at)
+{
+  ids[at] = componentTypeId<std::remove_const_t<T>>();
+  if constexpr (HasComponentBase<T>) {
+    fillComponentTypeIds<typename T::ComponentBase>(ids, at + 1);
+  }
+}
+
+} // namespace detail
+
+// Ids a component of type T is found under: T itself, then each class named
+// by ComponentBase up the chain. A component deriving from another component
+// declares `using ComponentBase = <direct parent>;` so getComponent on the
+// parent type finds it.
+template <typename T>
+std::span<const ComponentTypeId> componentTypeIds()
+{
+  static const auto ids = [] {
+    std::array<ComponentTypeId, detail::componentTypeDepth<T>()> result{};
+    detail::fillComponentTypeIds<T>(result, 0);
+    return result;
+  }();
+  return ids;
+}
+
+}
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <iterator>
+#include <span>
+#include <string>
 #include <utility>
 
 #include <app/Component.hpp>
+#include <app/ComponentRegistry.hpp>
+#include <app/ComponentType.hpp>
+#include <app/EntityNameIndex.hpp>
 
 
 namespace sauce {
@@ -20,7 +27,16 @@ public:
 	Entity(Entity&& other) noexcept
 		: name(std::move(other.name)),
 		  active(other.active),
-		  components(std::move(other.components)) {
+		  components(std::move(other.components)),
+		  componentMask(other.componentMask),
+		  componentSlots(std::move(other.componentSlots)),
+		  componentIndex(std::move(other.componentIndex)),
+		  ownRegistry(std::move(other.ownRegistry)),
+		  registry(other.registry),
+		  nameIndex(other.nameIndex),
+		  registryIndex(other.registryIndex),
+		  bound(other.bound) {
+		other.forgetComponents();
 		rebindComponentOwners();
 	}
 
@@ -29,15 +45,36 @@ public:
 			return *this;
 		}
 
+		unbindScene();
+		destroyComponents();
 		name = std::move(other.name);
 		active = other.active;
 		components = std::move(other.components);
+		componentMask = other.componentMask;
+		componentSlots = std::move(other.componentSlots);
+		componentIndex = std::move(other.componentIndex);
+		ownRegistry = std::move(other.ownRegistry);
+		registry = other.registry;
+		nameIndex = other.nameIndex;
+		registryIndex = other.registryIndex;
+		bound = other.bound;
+		other.forgetComponents();
 		rebindComponentOwners();
 		return *this;
 	}
 
+	~Entity() {
+		unbindScene();
+		destroyComponents();
+	}
+
 	std::string get_name() const { return name; }
-	void set_name(const std::string& newName) { name = newName; }
+	void set_name(const std::string& newName) {
+		if (nameIndex) {
+			nameIndex->rename(name, newName, registryIndex);
+		}
+		name = newName;
+	}
 	bool getActive() const { return active; }
 	void setActive(bool active) { this->active = active; }
 
@@ -49,9 +86,14 @@ public:
 	 */
 	template <typename T, typename... Args>
 	void addComponent(Args &&...args) {
-		auto component = std::make_unique<T>(std::forward<Args>(args)...);
-		component->setOwner(this);
-		components.push_back(std::move(component));
+		if (!registry) {
+			ownRegistry = std::make_unique<ComponentRegistry>();
+			registry = ownRegistry.get();
+		}
+		const ComponentRef ref = registry->emplace<T>(std::forward<Args>(args)...);
+		registry->get(ref)->setOwner(this);
+		components.push_back({ ref, componentTypeIds<T>() });
+		rebuildComponentIndex();
 	}
 
 	/**
@@ -59,11 +101,8 @@ public:
 	 */
 	template <typename T>
 	void removeComponent() {
-		for (auto it = components.rbegin(); it != components.rend(); ++it) {
-			if (dynamic_cast<T*>(it->get()) != nullptr) {
-				components.erase(std::next(it).base());
-				return;
-			}
+		if (T* component = getComponent<T>()) {
+			removeComponentByPointer(component);
 		}
 	}
 
@@ -72,14 +111,10 @@ public:
 	 *
 	 * @param name Name of the component to remove
 	 */
-  template <typename T>
+	template <typename T>
 	void removeComponent(const std::string& name) {
-		for (auto it = components.rbegin(); it != components.rend(); ++it) {
-			auto* component = dynamic_cast<T*>(it->get());
-			if (component != nullptr && component->name == name) {
-				components.erase(std::next(it).base());
-				return;
-			}
+		if (T* component = getComponent<T>(name)) {
+			removeComponentByPointer(component);
 		}
 	}
 
@@ -88,59 +123,111 @@ public:
 	 */
 	void removeComponentByPointer(Component* target) {
 		for (auto it = components.begin(); it != components.end(); ++it) {
-			if (it->get() == target) {
+			if (registry->get(it->ref) == target) {
+				const ComponentRef ref = it->ref;
 				components.erase(it);
+				rebuildComponentIndex();
+				registry->destroy(ref);
 				return;
 			}
 		}
 	}
 
 	/**
-	 * Returns a raw pointer to the most recently added component of a specified type
+	 * Whether the entity has a component of a specified type, in one bit test
+	 */
+	template <typename T>
+	bool hasComponent() const {
+		return componentMask.test(componentTypeId<T>());
+	}
+
+	/**
+	 * Bit i set when the entity has a component of the type with id i
+	 */
+	const ComponentMask& getComponentMask() const { return componentMask; }
+
+	/**
+	 * Returns a raw pointer to the most recently added component of a specified type.
+	 * Components live by value in their registry's per-type pools, shared by
+	 * every entity of the scene. Adding a component of the same type to any
+	 * entity may grow the pool and move all of them, destroying one moves the
+	 * pool's last component into its place, and adding the entity to a scene
+	 * moves its components into the scene's pools. Look the component up
+	 * again rather than keeping the pointer, and name it across frames by the
+	 * entity's EntityHandle.
 	 */
 	template <typename T>
 	T* getComponent() {
-		for (auto it = components.rbegin(); it != components.rend(); ++it) {
-			auto* component = dynamic_cast<T*>(it->get());
-			if (component != nullptr) {
-				return component;
-			}
-		}
-		return nullptr;
+		const ComponentTypeId type = componentTypeId<T>();
+		const size_t count = componentCount(type);
+		return count ? static_cast<T*>(componentAt(type, count - 1)) : nullptr;
 	}
 
 	template <typename T>
 	const T* getComponent() const {
-		for (auto it = components.rbegin(); it != components.rend(); ++it) {
-			auto* component = dynamic_cast<const T*>(it->get());
-			if (component != nullptr) {
-				return component;
-			}
-		}
-		return nullptr;
+		const ComponentTypeId type = componentTypeId<T>();
+		const size_t count = componentCount(type);
+		return count ? static_cast<const T*>(componentAt(type, count - 1)) : nullptr;
 	}
 
+	/**
+	 * Live view of the components of one type, in the order they were added.
+	 * Every access goes through the entity's slot table, so a view stays valid
+	 * while components are added and removed, for as long as the entity lives
+	 * at the same address. Nothing is allocated.
+	 */
+	template <typename T>
+	class ComponentView {
+	public:
+		class iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = T*;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T* const*;
+			using reference = T*;
+
+			iterator() = default;
+			T* operator*() const { return (*view)[index]; }
+			iterator& operator++() { ++index; return *this; }
+			iterator operator++(int) { iterator previous = *this; ++index; return previous; }
+			bool operator==(const iterator& other) const { return index == other.index; }
+
+		private:
+			friend class ComponentView;
+			iterator(const ComponentView* view, size_t index) : view(view), index(index) {}
+
+			const ComponentView* view = nullptr;
+			size_t index = 0;
+		};
+
+		size_t size() const { return entity->componentCount(type); }
+		bool empty() const { return size() == 0; }
+		T* operator[](size_t i) const { return static_cast<T*>(entity->componentAt(type, i)); }
+		T* front() const { return (*this)[0]; }
+		T* back() const { return (*this)[size() - 1]; }
+		iterator begin() const { return iterator(this, 0); }
+		iterator end() const { return iterator(this, size()); }
+
+	private:
+		friend class Entity;
+		ComponentView(const Entity* entity, ComponentTypeId type) : entity(entity), type(type) {}
+
+		const Entity* entity;
+		ComponentTypeId type;
+	};
+
 	/**
 	 * Returns raw pointers to all components of a specified type
 	 */
 	template <typename T>
-	std::vector<T*> getComponents() {
-		std::vector<T*> result;
-		for (auto& comp : components) {
-			auto* c = dynamic_cast<T*>(comp.get());
-			if (c) result.push_back(c);
-		}
-		return result;
+	ComponentView<T> getComponents() {
+		return ComponentView<T>(this, componentTypeId<T>());
 	}
 
 	template <typename T>
-	std::vector<const T*> getComponents() const {
-		std::vector<const T*> result;
-		for (const auto& comp : components) {
-			auto* c = dynamic_cast<const T*>(comp.get());
-			if (c) result.push_back(c);
-		}
-		return result;
+	ComponentView<const T> getComponents() const {
+		return ComponentView<const T>(this, componentTypeId<T>());
 	}
 
 	/*
@@ -150,27 +237,175 @@ public:
 	 */
 	template <typename T>
 	T* getComponent(const std::string& name) {
-		for (auto it = components.rbegin(); it != components.rend(); ++it) {
-			auto* component = dynamic_cast<T*>(it->get());
-			if (component != nullptr && component->name == name) {
-				return component;
+		const auto view = getComponents<T>();
+		for (size_t i = view.size(); i-- > 0;) {
+			if (view[i]->name == name) {
+				return view[i];
 			}
 		}
 		return nullptr;
-  }
+	}
 
 private:
-	void rebindComponentOwners() {
-		for (auto& component : components) {
-			if (component) {
-				component->setOwner(this);
+	friend class Scene;
+
+	struct OwnedComponent {
+		ComponentRef ref;
+		// Type ids the component is indexed under, from componentTypeIds
+		std::span<const ComponentTypeId> types;
+	};
+	// Range of componentIndex holding one type's components
+	struct ComponentSlot {
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	size_t componentCount(ComponentTypeId type) const {
+		return type < componentSlots.size() ? componentSlots[type].count : 0;
+	}
+
+	Component* componentAt(ComponentTypeId type, size_t i) const {
+		return registry->get(componentIndex[componentSlots[type].first + i]);
+	}
+
+	// Regroups the components by type id, keeping the order they were added
+	// in within each type. Adding and removing are rare next to lookups, so
+	// they pay for the whole regrouping.
+	void rebuildComponentIndex() {
+		const ComponentMask previousMask = componentMask;
+		componentMask.reset();
+		componentSlots.clear();
+		size_t indexed = 0;
+		for (const auto& owned : components) {
+			for (ComponentTypeId type : owned.types) {
+				if (type >= componentSlots.size()) {
+					componentSlots.resize(type + 1);
+				}
+				++componentSlots[type].count;
+				componentMask.set(type);
+			}
+			indexed += owned.types.size();
+		}
+
+		uint32_t first = 0;
+		for (auto& slot : componentSlots) {
+			slot.first = first;
+			first += slot.count;
+			slot.count = 0;
+		}
+		componentIndex.resize(indexed);
+		for (const auto& owned : components) {
+			for (ComponentTypeId type : owned.types) {
+				ComponentSlot& slot = componentSlots[type];
+				componentIndex[slot.first + slot.count++] = owned.ref;
+			}
+		}
+		publishComponents(previousMask | componentMask);
+	}
+
+	/**
+	 * Registers the entity's components and name with a scene's registry and
+	 * name index under index, first moving the components into that registry
+	 * when they are stored elsewhere
+	 */
+	void bindScene(ComponentRegistry* newRegistry, EntityNameIndex* newNameIndex, uint32_t index) {
+		if (registry != newRegistry) {
+			for (auto& owned : components) {
+				owned.ref = newRegistry->adopt(*registry, owned.ref);
+			}
+			ownRegistry.reset();
+			registry = newRegistry;
+			rebuildComponentIndex();
+		}
+		nameIndex = newNameIndex;
+		registryIndex = index;
+		bound = true;
+		publishComponents(componentMask);
+		if (nameIndex) {
+			nameIndex->add(name, registryIndex);
+		}
+	}
+
+	/**
+	 * Drops the entity's entries from the scene's registry sets and name
+	 * index. The components stay stored in the registry.
+	 */
+	void unbindScene() {
+		if (bound) {
+			for (ComponentTypeId type = 0; type < kMaxComponentTypes; ++type) {
+				if (componentMask.test(type)) {
+					registry->erase(type, registryIndex);
+				}
 			}
 		}
+		if (nameIndex) {
+			nameIndex->remove(name, registryIndex);
+		}
+		nameIndex = nullptr;
+		bound = false;
+	}
+
+	void destroyComponents() {
+		for (const auto& owned : components) {
+			registry->destroy(owned.ref);
+		}
+		components.clear();
+	}
+
+	// Leaves a moved-from entity without components or registry
+	void forgetComponents() {
+		components.clear();
+		componentMask.reset();
+		componentSlots.clear();
+		componentIndex.clear();
+		registry = nullptr;
+		nameIndex = nullptr;
+		bound = false;
+	}
+
+	// Refreshes the registry entries of the given types
+	void publishComponents(const ComponentMask& types) {
+		if (!bound) {
+			return;
+		}
+		for (ComponentTypeId type = 0; type < kMaxComponentTypes; ++type) {
+			if (!types.test(type)) {
+				continue;
+			}
+			const size_t count = componentCount(type);
+			if (count) {
+				registry->set(type, registryIndex, componentIndex[componentSlots[type].first + count - 1]);
+			} else {
+				registry->erase(type, registryIndex);
+			}
+		}
+	}
+
+	void rebindComponentOwners() {
+		for (const auto& owned : components) {
+			registry->get(owned.ref)->setOwner(this);
+		}
 	}
 
 	std::string name;
 	bool active = true;
-	std::vector<std::unique_ptr<Component>> components;
+	// In the order they were added
+	std::vector<OwnedComponent> components;
+	ComponentMask componentMask;
+	// By type id
+	std::vector<ComponentSlot> componentSlots;
+	// Components grouped by type, a component appearing under each of its ids
+	std::vector<ComponentRef> componentIndex;
+	// Storage of an entity outside any scene
+	std::unique_ptr<ComponentRegistry> ownRegistry;
+	// Registry storing the components: ownRegistry, or the scene's once the
+	// entity is added to one
+	ComponentRegistry* registry = nullptr;
+	// Name index of the scene holding the entity, and the entity's index there
+	EntityNameIndex* nameIndex = nullptr;
+	uint32_t registryIndex = 0;
+	// Whether the entity's components are in the registry's sets
+	bool bound = false;
 };
 
 }
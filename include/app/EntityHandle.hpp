@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace sauce {
+
+// Names an entity of a Scene wherever the scene currently stores it. index is
+// a slot in the scene's slot table and generation the slot's use count when
+// the entity was added: destroying the entity bumps the generation, so a
+// stale handle stops resolving even after the slot is reused.
+struct EntityHandle {
+  static constexpr uint32_t kNullIndex = std::numeric_limits<uint32_t>::max();
+
+  uint32_t index = kNullIndex;
+  uint32_t generation = 0;
+
+  // Whether the handle was ever set; Scene::isValid tells whether it is live
+  explicit operator bool() const { return index != kNullIndex; }
+  bool operator==(const EntityHandle& other) const = default;
+};
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sauce {
+
+// Entity indices by name, for O(1) lookup of a scene's entities by name.
+// Names need not be unique: each name keeps the indices of every entity
+// carrying it in ascending order, so find returns the first of them in scene
+// order, as a front-to-back scan would.
+class EntityNameIndex {
+public:
+  static constexpr uint32_t kNotFound = UINT32_MAX;
+
+  void add(std::string_view name, uint32_t entity) {
+    auto it = entries.find(name);
+    if (it == entries.end()) {
+      it = entries.emplace(std::string(name), std::vector<uint32_t>()).first;
+    }
+    auto& indices = it->second;
+    indices.insert(std::lower_bound(indices.begin(), indices.end(), entity), entity);
+  }
+
+  void remove(std::string_view name, uint32_t entity) {
+    const auto it = entries.find(name);
+    if (it == entries.end()) {
+      return;
+    }
+    auto& indices = it->second;
+    const auto at = std::lower_bound(indices.begin(), indices.end(), entity);
+    if (at != indices.end() && *at == entity) {
+      indices.erase(at);
+    }
+    if (indices.empty()) {
+      entries.erase(it);
+    }
+  }
+
+  void rename(std::string_view oldName, std::string_view newName, uint32_t entity) {
+    remove(oldName, entity);
+    add(newName, entity);
+  }
+
+  // Lowest index of an entity named name, or kNotFound
+  uint32_t find(std::string_view name) const {
+    const auto it = entries.find(name);
+    return it == entries.end() ? kNotFound : it->second.front();
+  }
+
+  // Number of entities named name
+  size_t count(std::string_view name) const {
+    const auto it = entries.find(name);
+    return it == entries.end() ? 0 : it->second.size();
+  }
+
+  void clear() { entries.clear(); }
+
+private:
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+  };
+
+  std::unordered_map<std::string, std::vector<uint32_t>, NameHash, std::equal_to<>> entries;
+};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace sauce {
+
+// What to do with time the simulation could not step through in one frame
+enum class PhysicsCatchUp {
+  // Discard the backlog beyond maxStepsPerFrame: the simulation runs slower
+  // than wall-clock time while the machine is overloaded, but never spirals
+  Drop,
+  // Keep the backlog (up to maxBacklogSteps) and work it off over the next
+  // frames, so brief hitches are caught up and simulation time stays on pace
+  Carry,
+};
+
+// Turns variable frame times into a whole number of fixed physics steps per
+// frame, plus the fraction of a step left over for interpolating render state
+// between the last two physics states.
+class FixedStepScheduler {
+public:
+  explicit FixedStepScheduler(double tickrate = 60.0,
+                              int maxStepsPerFrame = 4,
+                              PhysicsCatchUp catchUp = PhysicsCatchUp::Drop);
+
+  // Adds a frame's elapsed time and returns how many steps to run this frame
+  int advance(double frameSeconds);
+
+  double getStepSeconds() const { return stepSeconds; }
+  double getTickrate() const { return 1.0 / stepSeconds; }
+  // Accumulated time past the last step as a fraction of a step, clamped to 1
+  // while a carried backlog is pending
+  float getInterpolationAlpha() const;
+
+  void setTickrate(double tickrate);
+  void setMaxStepsPerFrame(int steps);
+  void setCatchUp(PhysicsCatchUp policy) { catchUp = policy; }
+  void setMaxBacklogSteps(int steps);
+  void reset() { accumulator = 0.0; }
+
+private:
+  double stepSeconds;
+  double accumulator = 0.0;
+  int maxStepsPerFrame;
+  int maxBacklogSteps = 30;
+  PhysicsCatchUp catchUp;
+};
+
+} // namespace sauce
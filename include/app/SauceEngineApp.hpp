@@ -14,6 +14,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <app/BufferUtils.hpp>
+#include <app/FixedStepScheduler.hpp>
+#include <app/SimulationLODScheduler.hpp>
 #include <app/GraphicsPipeline.hpp>
 #include <app/Scene.hpp>
 #include <app/Instance.hpp>
@@ -37,6 +39,8 @@
 #include <app/ui/components/TextColored.hpp>
 #include <app/ui/components/TextWrapped.hpp>
 
+#include <physics/PhysicsProfiler.hpp>
+
 #ifdef NDEBUG
 constexpr bool enableValidationLayers = false;
 #else
@@ -57,7 +61,11 @@ private:
 
   std::chrono::steady_clock::time_point lastFrameTime = std::chrono::steady_clock::now();
   double deltaFrame = 0.0f;
-  double deltaUpdate = 0.0;
+  FixedStepScheduler physicsScheduler;
+  SimulationLODScheduler simulationLOD;
+  // Fixed physics ticks run since startup
+  uint64_t physicsTick = 0;
+  physics::PhysicsProfiler physicsProfiler;
 
   float lastX = 0.0f;
   float lastY = 0.0f;
@@ -95,7 +103,9 @@ private:
   void frameLoadedSceneCamera();
   void setupSceneRenderer();
   void setupXPBDSolver();
-  void syncRigidBodiesToTransforms();
+  // Writes body poses to transforms, alpha of the way from the previous physics step to the last
+  // (per body, across its own last step when simulationLOD slows it down)
+  void syncRigidBodiesToTransforms(float alpha = 1.0f);
   void applyClothImpulse();
   void recordSceneCommandBuffer(vk::raii::CommandBuffer& cmd, uint32_t imageIndex);
 
@@ -104,6 +114,12 @@ public:
   void setCustomUIBuilder(std::function<void(sauce::ui::ImGuiComponentManager&)> builder);
   void setSceneFile(const std::string& path) { sceneFile = path; }
   void setIBLFile(const std::string& path) { iblFile = path; }
+  void setPhysicsTickrate(double tickrate) { physicsScheduler.setTickrate(tickrate); }
+  void setPhysicsCatchUp(PhysicsCatchUp policy, int maxStepsPerFrame) {
+    physicsScheduler.setCatchUp(policy);
+    physicsScheduler.setMaxStepsPerFrame(maxStepsPerFrame);
+  }
+  void setSimulationLOD(const SimulationLODSettings& settings) { simulationLOD.setSettings(settings); }
 
 private:
   std::string sceneFile;
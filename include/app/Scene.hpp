@@ -1,10 +1,20 @@
 #pragma once
 
 #include <app/Camera.hpp>
+#include <app/ComponentRegistry.hpp>
 #include <app/Entity.hpp>
+#include <app/EntityHandle.hpp>
+#include <app/EntityNameIndex.hpp>
 #include <app/components/LightComponent.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -23,6 +33,106 @@ namespace editor {
   class EditorApp;
 }
 
+/**
+ * Entities having every component type in Ts, found by walking the packed
+ * set of the rarest of those types and probing the others. Iterating yields
+ * (Entity&, Ts&...) per match, the most recently added component when an
+ * entity has several of a type. Adding or removing entities or components
+ * invalidates the view and its iterators.
+ */
+template <typename... Ts>
+class SceneView {
+public:
+  using value_type = std::tuple<Entity&, Ts&...>;
+
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = SceneView::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    iterator() = default;
+    value_type operator*() const { return view->at(view->lead->entities[position]); }
+    iterator& operator++() {
+      ++position;
+      skipMisses();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    bool operator==(const iterator& other) const { return position == other.position; }
+
+  private:
+    friend class SceneView;
+    iterator(const SceneView* view, size_t position) : view(view), position(position) { skipMisses(); }
+
+    void skipMisses() {
+      while (position < view->lead->size() && !view->matches(view->lead->entities[position])) {
+        ++position;
+      }
+    }
+
+    const SceneView* view = nullptr;
+    size_t position = 0;
+  };
+
+  iterator begin() const { return lead ? iterator(this, 0) : iterator(); }
+  iterator end() const { return lead ? iterator(this, lead->size()) : iterator(); }
+  bool empty() const { return begin() == end(); }
+
+  /**
+   * Calls fn(Entity&, Ts&...) for every match
+   */
+  template <typename Fn>
+  void each(Fn&& fn) const {
+    for (auto&& row : *this) {
+      std::apply(fn, row);
+    }
+  }
+
+private:
+  friend class Scene;
+
+  SceneView(std::vector<Entity>& entities, const ComponentRegistry& registry)
+      : entities(&entities), registry(&registry), sets{ registry.getSet(componentTypeId<Ts>())... } {
+    for (const auto* set : sets) {
+      if (!set) {
+        lead = nullptr;
+        return;
+      }
+      if (!lead || set->size() < lead->size()) {
+        lead = set;
+      }
+    }
+  }
+
+  bool matches(uint32_t entity) const {
+    for (const auto* set : sets) {
+      if (set != lead && !set->contains(entity)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  value_type at(uint32_t entity) const { return at(entity, std::index_sequence_for<Ts...>{}); }
+
+  template <size_t... I>
+  value_type at(uint32_t entity, std::index_sequence<I...>) const {
+    return value_type((*entities)[entity], *static_cast<Ts*>(registry->get(sets[I]->get(entity)))...);
+  }
+
+  std::vector<Entity>* entities;
+  const ComponentRegistry* registry;
+  std::array<const ComponentRegistry::Set*, sizeof...(Ts)> sets;
+  const ComponentRegistry::Set* lead = nullptr;
+};
+
 class Scene {
 public:
   /**
@@ -34,19 +144,95 @@ public:
     pCamera = std::make_unique<sauce::Camera>( cameraCreateInfo );
   }
 
+  // Entities point at the scene's component registry and name index
+  Scene(const Scene&) = delete;
+  Scene& operator=(const Scene&) = delete;
+
+  /**
+   * Entities packed in no particular order. Adding an entity may move all of
+   * them and destroying one moves the last into its place, so hold
+   * EntityHandles rather than Entity pointers or indices across either.
+   */
   const std::vector<sauce::Entity>& getEntities() const {
     return entities;
   }
 
   /**
-   * Adds an entity to the scene
+   * Adds an entity to the scene, reusing a freed slot when there is one
+   * @return handle of the entity, valid until it is destroyed
+   */
+  EntityHandle addEntity(sauce::Entity&& entity);
+
+  /**
+   * Destroys the entity in O(1), moving the last entity into its place
+   * @return false when the handle is stale or null
+   */
+  bool destroyEntity(EntityHandle handle);
+
+  /**
+   * Destroys the entity at index of getEntities, as destroyEntity
+   */
+  void removeEntity(size_t index);
+
+  /**
+   * Removes every entity; every handle goes stale
+   */
+  void clearEntities();
+
+  /**
+   * Whether handle names a live entity of this scene
+   */
+  bool isValid(EntityHandle handle) const {
+    return handle.index < entitySlots.size() && entitySlots[handle.index].generation == handle.generation &&
+           entitySlots[handle.index].entity != kFreeSlot;
+  }
+
+  /**
+   * The entity named by handle, or nullptr when the handle is stale
+   */
+  sauce::Entity* getEntity(EntityHandle handle) {
+    return isValid(handle) ? &entities[entitySlots[handle.index].entity] : nullptr;
+  }
+  const sauce::Entity* getEntity(EntityHandle handle) const {
+    return isValid(handle) ? &entities[entitySlots[handle.index].entity] : nullptr;
+  }
+
+  /**
+   * Handle of the entity at index of getEntities
+   */
+  EntityHandle getHandle(size_t index) const {
+    const uint32_t slot = entitySlotOf[index];
+    return { slot, entitySlots[slot].generation };
+  }
+
+  /**
+   * Handle of an entity stored in this scene, such as one from view
+   */
+  EntityHandle getHandle(const sauce::Entity& entity) const {
+    return getHandle(static_cast<size_t>(&entity - entities.data()));
+  }
+
+  /**
+   * Iterates the entities having all of the component types Ts, e.g.
+   * for (auto [entity, transform, body] : scene.view<TransformComponent, RigidBodyComponent>())
+   */
+  template <typename... Ts>
+  SceneView<Ts...> view() {
+    static_assert(sizeof...(Ts) > 0, "view needs at least one component type");
+    return SceneView<Ts...>(entities, componentRegistry);
+  }
+
+  /**
+   * Gets an entity by name (returns nullptr if not found), in one hash
+   * lookup. With several entities of that name, the first one in the scene.
    */
-  void addEntity(sauce::Entity&& entity);
+  sauce::Entity* getEntity(std::string_view name);
+  const sauce::Entity* getEntity(std::string_view name) const;
 
   /**
-   * Gets an entity by name (returns nullptr if not found)
+   * Number of entities named name
    */
-  sauce::Entity* getEntity(const std::string& name);
+  size_t countEntities(std::string_view name) const { return nameIndex.count(name); }
 
   /**
    * Loads a GLTF model and creates entities with components
@@ -78,6 +264,10 @@ public:
     return *pCamera;
   }
 
+  /**
+   * Entities in place; add and remove them through the scene so its
+   * handles, component registry and name index follow
+   */
   std::vector<sauce::Entity>& getEntitiesMut() {
     return entities;
   }
@@ -90,7 +280,30 @@ public:
   const std::vector<GPULight>& collectGPULights();
 
 private:
+  static constexpr uint32_t kFreeSlot = std::numeric_limits<uint32_t>::max();
+
+  struct EntitySlot {
+    // Bumped whenever the slot's entity is destroyed
+    uint32_t generation = 0;
+    // Index of the slot's entity in entities, or kFreeSlot
+    uint32_t entity = kFreeSlot;
+  };
+
+  // Moves the last entity into index and drops the last place
+  void eraseEntityAt(size_t index);
+
+  // Every entity's components in per-type pools, with the per-type sets for
+  // view(). It and nameIndex are declared ahead of entities, which drop their
+  // entries from both when destroyed.
+  ComponentRegistry componentRegistry;
+  // Entity indices by name, for getEntity
+  EntityNameIndex nameIndex;
   std::vector<sauce::Entity> entities;
+  // Slot of each entity, parallel to entities
+  std::vector<uint32_t> entitySlotOf;
+  std::vector<EntitySlot> entitySlots;
+  // Slots without an entity, reused last freed first
+  std::vector<uint32_t> freeSlots;
 
   std::unique_ptr<sauce::Camera> pCamera;
 
@@ -99,8 +312,8 @@ private:
 
   // Helper functions for GLTF loading
   void loadGLTFNodeHierarchy(std::shared_ptr<modeling::ModelNode> node,
-                             Entity* parentEntity,
-                             std::unordered_map<modeling::ModelNode*, Entity*>& nodeToEntityMap,
+                             EntityHandle parentEntity,
+                             std::unordered_map<modeling::ModelNode*, EntityHandle>& nodeToEntityMap,
                              const std::string& filePath);
   void loadGLTFFlattened(std::shared_ptr<modeling::Model> model, const std::string& filePath);
 
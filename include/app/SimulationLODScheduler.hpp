@@ -0,0 +1,146 @@
+#pragma once
+
+#include <app/EntityHandle.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace sauce {
+
+// Rate one simulated object runs at
+struct SimulationLOD {
+  // The object steps on one physics tick out of tickDivisor, each step
+  // covering every tick since its last one
+  int tickDivisor = 1;
+  // Solver substeps per step of the object
+  int substeps = 1;
+};
+
+// Names a simulated object across frames: its entity, and which of the
+// entity's simulated components it is. Components move in memory as others
+// are added and destroyed, so their addresses cannot serve as keys.
+struct SimulationKey {
+  EntityHandle entity;
+  uint32_t component = 0;
+
+  bool operator==(const SimulationKey& other) const = default;
+};
+
+struct SimulationKeyHash {
+  size_t operator()(const SimulationKey& key) const {
+    const uint64_t entity = (static_cast<uint64_t>(key.entity.generation) << 32) | key.entity.index;
+    return std::hash<uint64_t>{}(entity) ^ (std::hash<uint32_t>{}(key.component) * 0x9e3779b97f4a7c15ull);
+  }
+};
+
+struct SimulationLODSettings {
+  // Objects at least this many pixels tall simulate on every tick; each
+  // halving of the height below it doubles the tick divisor
+  float fullRatePixels = 120.0f;
+  // Objects this far from the camera run at maxTickDivisor whatever their size
+  float farDistance = 200.0f;
+  // Largest tick divisor, rounded down to a power of two
+  int maxTickDivisor = 8;
+  // Budget demotions never take an object below this many substeps
+  int minSubsteps = 1;
+  // Time all physics steps of one frame may take. Once reportFrameCost has
+  // calibrated the cost model, the least visible objects are demoted until
+  // the frame's predicted cost fits. 0 disables the budget.
+  float frameBudgetMs = 0.0f;
+};
+
+// Picks each simulated object's tick divisor and substep count every frame,
+// from its distance to the camera, its height on screen and a per-frame
+// physics time budget, then tells the caller which objects step on which
+// fixed tick. An object on a divisor of d steps once every d ticks over d
+// ticks of time, and is drawn interpolated between its last two steps.
+//
+// Per frame: beginFrame, add every simulated object, assign, then for each
+// fixed tick call beginStep per object and step those it returns a span for.
+class SimulationLODScheduler {
+public:
+  struct View {
+    glm::vec3 position = glm::vec3(0.0f);
+    // Vertical field of view in degrees, as Camera::getFOV
+    float fovDegrees = 90.0f;
+    float viewportHeight = 1080.0f;
+  };
+
+  explicit SimulationLODScheduler(SimulationLODSettings settings = {});
+
+  // Starts a frame whose first fixed tick follows tick. Last frame's objects
+  // are dropped; their step history stays for as long as they are added again.
+  void beginFrame(const View& view, uint64_t tick);
+
+  // Registers an object for this frame and returns its slot. key identifies
+  // the object across frames. cost is the work of one step at full substeps,
+  // in any unit shared by every object (such as particles times substeps).
+  size_t add(const SimulationKey& key, const glm::vec3& center, float radius, float cost, int substeps = 1);
+
+  // Assigns every object added this frame its LOD for the given number of ticks
+  void assign(int ticksThisFrame);
+
+  const SimulationLOD& getLOD(size_t slot) const { return objects[slot].lod; }
+
+  // Ticks the object's step on tick covers, recording the step, or 0 when it
+  // does not step on tick
+  int beginStep(size_t slot, uint64_t tick);
+
+  // How far between its last two steps to draw the object added under key,
+  // given the last completed tick and FixedStepScheduler::getInterpolationAlpha.
+  // Objects the scheduler does not know step every tick and get alpha itself.
+  float getInterpolationAlpha(const SimulationKey& key, uint64_t tick, float alpha) const;
+
+  // Measured duration of this frame's physics steps, calibrating the time a
+  // unit of cost takes
+  void reportFrameCost(double milliseconds);
+
+  // Predicted duration of the frame's ticks under the current assignment; 0
+  // before any calibration
+  double getPredictedFrameMs() const { return predictedFrameMs; }
+
+  const SimulationLODSettings& getSettings() const { return settings; }
+  void setSettings(const SimulationLODSettings& newSettings);
+
+private:
+  struct History {
+    uint64_t lastTick = 0;
+    // First tick the object may step on again
+    uint64_t nextTick = 0;
+    // Ticks the last step covered; 0 before the first step
+    uint64_t span = 0;
+    uint64_t lastFrame = 0;
+  };
+  struct Object {
+    History* history = nullptr;
+    float pixels = 0.0f;
+    float distance = 0.0f;
+    float cost = 0.0f;
+    int fullSubsteps = 1;
+    SimulationLOD lod;
+  };
+
+  double stepCost(const Object& object) const;
+  double predictFrameMs(int ticksThisFrame) const;
+
+  SimulationLODSettings settings;
+  View view;
+  uint64_t frameTick = 0;
+  uint64_t frame = 0;
+  std::vector<Object> objects;
+  std::unordered_map<SimulationKey, History, SimulationKeyHash> histories;
+  std::vector<size_t> demotionOrder;
+
+  // Calibrated milliseconds per unit of cost; 0 until the first report
+  double msPerCost = 0.0;
+  // Cost of the steps run since the last report
+  double executedCost = 0.0;
+  double predictedFrameMs = 0.0;
+};
+
+} // namespace sauce
@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace sauce {
 
@@ -18,6 +19,9 @@ public:
   ClothComponent();
   explicit ClothComponent(std::shared_ptr<modeling::Mesh> sourceMesh);
   ClothComponent(std::shared_ptr<modeling::Mesh> sourceMesh, const ClothSettings& settings);
+  // Pools store components by value and move them as they grow; the
+  // particle data moves rather than being copied
+  ClothComponent(ClothComponent&&) noexcept = default;
 
   void setOwner(Entity* newOwner) override;
 
@@ -42,7 +46,12 @@ public:
   void syncSimulationTransform();
   void markRuntimeMeshDirty() { runtimeMeshDirty = true; }
   bool isRuntimeMeshDirty() const { return runtimeMeshDirty; }
-  bool syncRuntimeMesh(bool regenerateTangents = true);
+  // Records particle positions before a physics step so syncRuntimeMesh can
+  // blend between the last two steps
+  void captureStepStart();
+  // Writes particle positions into the runtime mesh, interpolated between the
+  // start (alpha 0) and end (alpha 1) of the last captured step
+  bool syncRuntimeMesh(bool regenerateTangents = true, float alpha = 1.0f);
 
   size_t getParticleCount() const;
   size_t getTriangleCount() const;
@@ -58,6 +67,7 @@ private:
   std::optional<physics::ClothData> clothData;
   ClothSettings settings;
   modeling::Transform lastSimulationTransform;
+  std::vector<glm::vec3> stepStartPositions;
   bool runtimeMeshDirty = false;
   std::string lastBuildError;
 };
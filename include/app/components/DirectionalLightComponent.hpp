@@ -7,6 +7,9 @@ namespace sauce {
 
 class DirectionalLightComponent : public LightComponent {
 public:
+    // getComponent<LightComponent>() finds this component too
+    using ComponentBase = LightComponent;
+
     DirectionalLightComponent();
     DirectionalLightComponent(const glm::vec3& color, float intensity);
     ~DirectionalLightComponent() override = default;
@@ -5,6 +5,10 @@
 #include "app/modeling/Material.hpp"
 #include <memory>
 
+namespace physics {
+class SignedDistanceField;
+}
+
 namespace sauce {
 
 class MeshRendererComponent : public Component {
@@ -17,11 +21,14 @@ public:
     std::shared_ptr<modeling::Mesh> getMesh() const { return mesh; }
     std::shared_ptr<modeling::Material> getMaterial() const { return material; }
     const std::string& getModelPath() const { return modelPath; }
+    // Baked at import for static meshes that opt in; null otherwise
+    const std::shared_ptr<const physics::SignedDistanceField>& getDistanceField() const { return distanceField; }
 
     // Setters
     void setMesh(std::shared_ptr<modeling::Mesh> mesh) { this->mesh = mesh; }
     void setMaterial(std::shared_ptr<modeling::Material> material) { this->material = material; }
     void setModelPath(const std::string& path) { modelPath = path; }
+    void setDistanceField(std::shared_ptr<const physics::SignedDistanceField> field) { distanceField = std::move(field); }
 
     // Component interface
     virtual void render() override;
@@ -31,6 +38,7 @@ private:
     std::shared_ptr<modeling::Mesh> mesh;
     std::shared_ptr<modeling::Material> material;
     std::string modelPath;
+    std::shared_ptr<const physics::SignedDistanceField> distanceField;
 };
 
 } // namespace sauce
@@ -26,6 +26,9 @@ static_assert(sizeof(GPUPointLight) == 96, "GPUPointLight must be 96 bytes to ma
 
 class PointLightComponent : public LightComponent {
 public:
+    // getComponent<LightComponent>() finds this component too
+    using ComponentBase = LightComponent;
+
     PointLightComponent();
     PointLightComponent(const glm::vec3& color, float intensity, float range = 0.0f);
     ~PointLightComponent() override = default;
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "app/Component.hpp"
+#include "app/modeling/ColliderInfo.hpp"
 #include "app/modeling/Mesh.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <memory>
+#include <optional>
 
 namespace sauce {
 
@@ -22,7 +24,8 @@ public:
       glm::mat3 invInertiaTensor = glm::mat3(1.0f)
       ) : 
     position(initPosition), velocity(initVelocity),
-    orientation(initOrientation), angularVelocity(initAngularVelocity), externalForces(externalForces),
+    orientation(initOrientation), previousPosition(initPosition), previousOrientation(initOrientation),
+    angularVelocity(initAngularVelocity), externalForces(externalForces),
     invMass(invMass), invInertiaTensor(invInertiaTensor) {}
 
   void offsetExternalForce(glm::vec3 force) {
@@ -48,10 +51,49 @@ public:
   void setInvInertiaTensor(const glm::mat3& I)      { invInertiaTensor = I; }
   void clearExternalForces()                        { externalForces = glm::vec3(0.0f); }
 
-  // approximate center of mass given a mesh
-  static glm::vec3 meshCenterOfMass(std::shared_ptr<modeling::Mesh> m);
-  // approximate inverse mass given a mesh
-  static float meshInvMass(std::shared_ptr<modeling::Mesh> m);
+  // Sleeping bodies skip integration and narrowphase until something touches their island
+  bool             isSleeping()                     const { return sleeping; }
+  int              getSleepCounter()                const { return sleepCounter; }
+  void setSleeping(bool s)                          { sleeping = s; if (!s) sleepCounter = 0; }
+  void setSleepCounter(int n)                       { sleepCounter = n; }
+  void wake()                                       { setSleeping(false); }
+
+  // Analytic collision shape; without one the body collides through its mesh
+  const std::optional<modeling::ColliderInfo>& getCollider() const { return collider; }
+  void setCollider(const modeling::ColliderInfo& c) { collider = c; }
+  void clearCollider()                              { collider.reset(); }
+
+  // Pose at the start of the last physics step, for render interpolation
+  void storePreviousPose() {
+    previousPosition = position;
+    previousOrientation = orientation;
+  }
+  glm::vec3 getInterpolatedPosition(float alpha) const {
+    return glm::mix(previousPosition, position, alpha);
+  }
+  glm::quat getInterpolatedOrientation(float alpha) const {
+    return glm::slerp(previousOrientation, orientation, alpha);
+  }
+
+  // Copies the simulated state (pose, velocities, sleep) from another body
+  void copyDynamicStateFrom(const RigidBodyComponent& other) {
+    position = other.position;
+    previousPosition = other.previousPosition;
+    previousOrientation = other.previousOrientation;
+    velocity = other.velocity;
+    orientation = other.orientation;
+    angularVelocity = other.angularVelocity;
+    sleeping = other.sleeping;
+    sleepCounter = other.sleepCounter;
+  }
+
+  // Mesh-derived mass properties at unit density, read from the mesh's cached
+  // MassProperties. Meshes that enclose no volume fall back to the vertex
+  // average, an inverse mass of 1 and an identity inverse inertia.
+  static glm::vec3 meshCenterOfMass(const std::shared_ptr<modeling::Mesh>& m);
+  static float meshInvMass(const std::shared_ptr<modeling::Mesh>& m);
+  // Inverse inertia tensor in body space for a body with the given inverse mass
+  static glm::mat3 meshInvInertiaTensor(const std::shared_ptr<modeling::Mesh>& m, float invMass);
 
   // No implementation for this for now
   virtual void render() override {};
@@ -65,12 +107,20 @@ private:
   glm::vec3 centerOfMass;
   glm::vec3 velocity;
   glm::quat orientation;
+  glm::vec3 previousPosition;
+  glm::quat previousOrientation;
   glm::vec3 angularVelocity;
 
   glm::vec3 externalForces;
 
   float invMass;
   glm::mat3 invInertiaTensor;
+
+  bool sleeping = false;
+  // consecutive solver steps spent below the sleep velocity thresholds
+  int sleepCounter = 0;
+
+  std::optional<modeling::ColliderInfo> collider;
 };
 
 }
@@ -19,6 +19,9 @@ static_assert(sizeof(GPUSpotLight) == 64, "GPUSpotLight must be 64 bytes to matc
 
 class SpotLightComponent : public LightComponent {
 public:
+    // getComponent<LightComponent>() finds this component too
+    using ComponentBase = LightComponent;
+
     SpotLightComponent();
     SpotLightComponent(const glm::vec3& color, float intensity, float range = 0.0f,
                        const glm::vec3& direction = glm::vec3(0.0f, -1.0f, 0.0f),
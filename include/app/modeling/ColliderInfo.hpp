@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace sauce::modeling {
+
+// Analytic collision shape for a rigid body, in the body's local frame. Bodies
+// without one collide through their mesh. Only the fields of the chosen shape
+// are used; a plane's normal and offset are measured from the body's origin.
+// ConvexHull uses the cached hull of the body's mesh (Mesh::getConvexHull),
+// moved by offset.
+struct ColliderInfo {
+  enum class Shape { Sphere, Box, Capsule, Plane, ConvexHull };
+
+  Shape shape = Shape::Sphere;
+  glm::vec3 offset = glm::vec3(0.0f);
+  float radius = 0.5f;                       // sphere, capsule
+  glm::vec3 halfExtents = glm::vec3(0.5f);   // box
+  float halfHeight = 0.5f;                   // capsule segment along local Y
+  glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f); // plane
+};
+
+} // namespace sauce::modeling
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace sauce::modeling {
+
+class Mesh;
+
+// Convex hull of a point set in the points' frame, as vertices plus outward
+// facing triangles (counter-clockwise seen from outside). Hulls are built with
+// quickhull and capped at maxVertices: the farthest remaining point is added
+// first, so a capped hull is the best inner approximation quickhull reached
+// with that many vertices.
+struct ConvexHull {
+    static constexpr size_t kDefaultMaxVertices = 64;
+
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+
+    bool empty() const { return vertices.empty(); }
+
+    // Hull vertex farthest along direction
+    glm::vec3 support(const glm::vec3& direction) const;
+
+    // Distance of the farthest vertex from the origin of the hull's frame
+    float boundingRadius() const;
+
+    // Flat or collinear inputs give only the extreme points found, with no
+    // triangles; fewer than two distinct points give an empty hull
+    static ConvexHull fromPoints(std::span<const glm::vec3> points, size_t maxVertices = kDefaultMaxVertices);
+    static ConvexHull fromMesh(const Mesh& mesh, size_t maxVertices = kDefaultMaxVertices);
+};
+
+} // namespace sauce::modeling
@@ -93,6 +93,8 @@ private:
     void parseLightsExtension(const tinygltf::Model& gltfModel);
     void applyNodeLight(const tinygltf::Node& gltfNode, std::shared_ptr<ModelNode> node);
     void applyNodeCloth(const tinygltf::Node& gltfNode, std::shared_ptr<ModelNode> node);
+    // "collider" object in node extras: analytic rigid-body shape
+    void applyNodeCollider(const tinygltf::Node& gltfNode, std::shared_ptr<ModelNode> node);
 
     std::vector<LightInfo> parsedLights; // populated by parseLightsExtension
 
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace sauce::modeling {
+
+class Mesh;
+
+// Volume, center of mass and inertia tensor of a closed triangle mesh at unit
+// density, in the mesh's local frame. The inertia tensor is taken about the
+// center of mass; scale it by the body's mass over volume for other densities.
+struct MassProperties {
+    float volume = 0.0f;
+    glm::vec3 centerOfMass = glm::vec3(0.0f);
+    glm::mat3 inertia = glm::mat3(0.0f);
+
+    // False for flat or empty meshes that enclose no volume; centerOfMass is
+    // then the vertex average and inertia is left at zero. Open meshes give
+    // arbitrary results.
+    bool hasVolume() const { return volume > 0.0f; }
+
+    // Inverse inertia tensor for a body of the given inverse mass, or the
+    // identity when the mesh has no volume to integrate
+    glm::mat3 inverseInertia(float invMass) const;
+
+    // Sums the signed tetrahedra formed by each triangle and the origin in one
+    // pass over the mesh's index buffer. Either winding works as long as it is
+    // consistent across the mesh.
+    static MassProperties fromMesh(const Mesh& mesh);
+};
+
+} // namespace sauce::modeling
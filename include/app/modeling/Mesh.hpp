@@ -1,9 +1,12 @@
 #pragma once
 
 #include "app/Vertex.hpp"
+#include "app/modeling/ConvexHull.hpp"
+#include "app/modeling/MassProperties.hpp"
 #include "app/modeling/PropertyValue.hpp"
 #include <vector>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vulkan/vulkan_raii.hpp>
 
@@ -19,7 +22,12 @@ public:
     ~Mesh();
 
     const std::vector<sauce::Vertex>& getVertices() const { return vertices; }
-    std::vector<sauce::Vertex>& getVerticesMutable() { return vertices; }
+    // Drops the cached mass properties and hull, since the caller may move vertices
+    std::vector<sauce::Vertex>& getVerticesMutable() {
+        massProperties.reset();
+        convexHull.reset();
+        return vertices;
+    }
     const std::vector<uint32_t>& getIndices() const { return indices; }
 
     size_t getVertexCount() const { return vertices.size(); }
@@ -29,6 +37,26 @@ public:
 
     bool isValid() const;
 
+    // Computed on first use and cached until the vertices are next accessed
+    // mutably. Not synchronised: different meshes may be queried concurrently,
+    // the same mesh may not.
+    const MassProperties& getMassProperties() const {
+        if (!massProperties) {
+            massProperties = MassProperties::fromMesh(*this);
+        }
+        return *massProperties;
+    }
+
+    // Hull of the vertices, capped at ConvexHull::kDefaultMaxVertices and cached
+    // like the mass properties. Colliders share the returned hull, so it stays
+    // valid after the cache is dropped.
+    const std::shared_ptr<const ConvexHull>& getConvexHull() const {
+        if (!convexHull) {
+            convexHull = std::make_shared<const ConvexHull>(ConvexHull::fromMesh(*this));
+        }
+        return convexHull;
+    }
+
     void initVulkanResources(
         vk::raii::Device& device,
         vk::raii::PhysicalDevice& physicalDevice);
@@ -62,6 +90,8 @@ private:
     std::vector<sauce::Vertex> vertices;
     std::vector<uint32_t> indices;
     std::unordered_map<std::string, PropertyValue> metadata;
+    mutable std::optional<MassProperties> massProperties;
+    mutable std::shared_ptr<const ConvexHull> convexHull;
 
     // GPU resources (optional, for Phase 6)
     std::unique_ptr<vk::raii::Buffer> vertexBuffer;
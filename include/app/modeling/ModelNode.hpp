@@ -2,6 +2,7 @@
 
 #include "app/modeling/Transform.hpp"
 #include "app/modeling/ClothInfo.hpp"
+#include "app/modeling/ColliderInfo.hpp"
 #include "app/modeling/Mesh.hpp"
 #include "app/modeling/Material.hpp"
 #include "app/modeling/PropertyValue.hpp"
@@ -61,6 +62,10 @@ public:
     void setClothInfo(const ClothInfo& info) { clothInfo = info; }
     bool hasCloth() const { return clothInfo.has_value(); }
 
+    const std::optional<ColliderInfo>& getColliderInfo() const { return colliderInfo; }
+    void setColliderInfo(const ColliderInfo& info) { colliderInfo = info; }
+    bool hasCollider() const { return colliderInfo.has_value(); }
+
     // Metadata access (for GLTF extensions)
     const std::unordered_map<std::string, PropertyValue>& getMetadata() const { return metadata; }
     void setMetadata(const std::string& key, const PropertyValue& value);
@@ -77,6 +82,7 @@ private:
     std::vector<MeshMaterialPair> meshMaterialPairs;
     std::optional<LightInfo> lightInfo;
     std::optional<ClothInfo> clothInfo;
+    std::optional<ColliderInfo> colliderInfo;
     std::unordered_map<std::string, PropertyValue> metadata;
 };
 
@@ -1,20 +1,83 @@
 #pragma once
 
 #include <app/ui/ImGuiComponent.hpp>
+#include <app/ui/components/PlotHistogram.hpp>
+#include <app/ui/components/PlotLines.hpp>
+#include <physics/PhysicsProfiler.hpp>
 #include <imgui.h>
 
+#include <cstdio>
+#include <vector>
+
 namespace sauce::ui {
 
 class DebugStatsWindow : public ImGuiComponent {
 public:
-    DebugStatsWindow() : ImGuiComponent("DebugStatsWindow") {}
+    // With a profiler the window adds a physics panel over its rolling history
+    explicit DebugStatsWindow(const physics::PhysicsProfiler* physicsProfiler = nullptr)
+        : ImGuiComponent("DebugStatsWindow"),
+          profiler(physicsProfiler),
+          frameTimePlot("Physics ms", {}),
+          stagePlot("Stage p99 ms", {}) {}
 
     void render() override {
         ImGui::Begin("SauceEngine Debug");
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
         ImGui::Text("Frame Time: %.3f ms", 1000.0f / ImGui::GetIO().Framerate);
+
+        if (profiler && !profiler->empty() &&
+            ImGui::CollapsingHeader("Physics", ImGuiTreeNodeFlags_DefaultOpen)) {
+            renderPhysics();
+        }
         ImGui::End();
     }
+
+private:
+    void renderPhysics() {
+        char overlay[64];
+        std::snprintf(overlay, sizeof(overlay), "avg %.2f  p99 %.2f",
+                      profiler->averageTotal(), profiler->percentileTotal(0.99f));
+        std::vector<float> totals;
+        profiler->totalHistory(totals);
+        frameTimePlot.setValues(std::move(totals));
+        frameTimePlot.setOverlay(overlay);
+        frameTimePlot.render();
+
+        // One bar per stage, in ProfileStage order
+        std::vector<float> stageP99(physics::kProfileStageCount);
+        for (size_t s = 0; s < physics::kProfileStageCount; ++s) {
+            stageP99[s] = profiler->percentile(static_cast<physics::ProfileStage>(s), 0.99f);
+        }
+        stagePlot.setValues(std::move(stageP99));
+        stagePlot.render();
+
+        if (ImGui::BeginTable("PhysicsStages", 3, ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("Stage");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("p99 ms");
+            ImGui::TableHeadersRow();
+            for (size_t s = 0; s < physics::kProfileStageCount; ++s) {
+                const auto stage = static_cast<physics::ProfileStage>(s);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(physics::profileStageName(stage));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", profiler->average(stage));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", profiler->percentile(stage, 0.99f));
+            }
+            ImGui::EndTable();
+        }
+
+        const physics::PhysicsSample& last = profiler->sample(0);
+        ImGui::Text("Steps: %u  Bodies: %u  Pairs: %u", last.steps, last.bodies, last.pairs);
+        ImGui::Text("Contacts: %u  Constraints: %u  Iterations: %u", last.contacts, last.constraints, last.iterations);
+        ImGui::Text("Residual: %.2e  Arena overflows: %u", last.residual, last.arenaOverflows);
+    }
+
+    const physics::PhysicsProfiler* profiler;
+    PlotLines frameTimePlot;
+    PlotHistogram stagePlot;
 };
 
 }
@@ -14,7 +14,12 @@ namespace sauce::ui
 
 		void render() override;
 
+		void setValues(std::vector<float> newValues);
+		// Text drawn over the plot, e.g. the latest value
+		void setOverlay(std::string text);
+
 	private:
 		std::vector<float> values;
+		std::string overlay;
 	};
 }
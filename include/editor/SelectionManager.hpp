@@ -1,6 +1,7 @@
 #pragma once
 
 #include <app/Entity.hpp>
+#include <app/EntityHandle.hpp>
 
 namespace sauce {
 class Scene;
@@ -10,15 +11,17 @@ namespace sauce::editor {
 
 class SelectionManager {
 public:
-  void select(int index) { selectedIndex = index; }
-  void deselect() { selectedIndex = -1; }
-  int getSelectedIndex() const { return selectedIndex; }
-  bool hasSelection() const { return selectedIndex >= 0; }
+  void select(sauce::EntityHandle handle) { selected = handle; }
+  void deselect() { selected = {}; }
+  sauce::EntityHandle getSelected() const { return selected; }
+  bool isSelected(sauce::EntityHandle handle) const { return selected && selected == handle; }
+  bool hasSelection() const { return static_cast<bool>(selected); }
 
+  // nullptr when nothing is selected or the selected entity was destroyed
   sauce::Entity* getSelectedEntity(sauce::Scene& scene);
 
 private:
-  int selectedIndex = -1;
+  sauce::EntityHandle selected;
 };
 
 } // namespace sauce::editor
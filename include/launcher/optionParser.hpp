@@ -12,16 +12,19 @@
 struct AppOptions {
     static constexpr unsigned int DEFAULT_SCR_WIDTH = 1280;
     static constexpr unsigned int DEFAULT_SCR_HEIGHT = 720;
-    static constexpr double DEFAULT_TICKRATE = 128.0;
+    static constexpr double DEFAULT_TICKRATE = 60.0;
+    static constexpr unsigned int DEFAULT_MAX_PHYSICS_STEPS = 4;
 
     unsigned int scr_width, scr_height;
     double tickrate;
+    unsigned int max_physics_steps;
+    std::string physics_catchup; // "drop" or "carry"
     std::string scene_file;
     std::string ibl_file;
     bool help;
 
     AppOptions(int argc, const char *argv[]);
-    AppOptions(): scr_width(DEFAULT_SCR_WIDTH), scr_height(DEFAULT_SCR_HEIGHT), tickrate(DEFAULT_TICKRATE), scene_file(), ibl_file(), help(false) {}
+    AppOptions(): scr_width(DEFAULT_SCR_WIDTH), scr_height(DEFAULT_SCR_HEIGHT), tickrate(DEFAULT_TICKRATE), max_physics_steps(DEFAULT_MAX_PHYSICS_STEPS), physics_catchup("drop"), scene_file(), ibl_file(), help(false) {}
 
     boost::program_options::options_description getHelpMessage() const;
 
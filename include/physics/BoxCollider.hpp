@@ -0,0 +1,30 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <array>
+
+namespace physics {
+
+// Oriented box in world space
+struct BoxCollider : public Collider {
+
+  BoxCollider() : Collider(ColliderType::Box) {}
+
+  // Stores contact info if the box intersects collider. If no intersection, info is not modified
+  virtual bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
+
+  // World-space direction of local axis i (0 = x, 1 = y, 2 = z)
+  glm::vec3 axis(int i) const;
+  std::array<glm::vec3, 8> corners() const;
+
+  glm::vec3 center = glm::vec3(0.0f);
+  glm::vec3 halfExtents = glm::vec3(0.5f);
+  glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+};
+
+}
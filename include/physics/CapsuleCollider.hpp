@@ -0,0 +1,29 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace physics {
+
+// Swept sphere around a segment along the local Y axis, in world space
+struct CapsuleCollider : public Collider {
+
+  CapsuleCollider() : Collider(ColliderType::Capsule) {}
+
+  // Stores contact info if the capsule intersects collider. If no intersection, info is not modified
+  virtual bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
+
+  // Segment end points
+  glm::vec3 pointA() const;
+  glm::vec3 pointB() const;
+
+  glm::vec3 center = glm::vec3(0.0f);
+  glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+  float halfHeight = 0.5f;
+  float radius = 0.5f;
+
+};
+
+}
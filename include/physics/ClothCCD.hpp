@@ -0,0 +1,91 @@
+#pragma once
+
+#include <physics/RigidPose.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace sauce::modeling {
+class Mesh;
+}
+
+namespace physics {
+
+struct ClothParticle;
+struct ClothTopology;
+
+// A triangle mesh moving rigidly over one cloth step, from startPose at the
+// start of the step to endPose at its end
+struct ClothObstacle {
+  std::shared_ptr<const sauce::modeling::Mesh> mesh;
+  RigidPose startPose;
+  RigidPose endPose;
+};
+
+// A first crossing found by a swept test: the time in [0, 1] and, at that
+// time, the barycentric coordinates of the point on the triangle, or the
+// parameters along both edges (x: the first edge, y: the second)
+struct TimeOfImpact {
+  float time = 1.0f;
+  glm::vec3 coordinates = glm::vec3(0.0f);
+};
+
+// Earliest time at which a point moving linearly from p0 to p1 touches the
+// triangle moving linearly from a0, b0, c0 to a1, b1, c1. The point and the
+// triangle's plane meet at the real roots of a cubic in t, and the first
+// root inside the triangle is the impact.
+bool pointTriangleImpact(const glm::vec3& p0, const glm::vec3& p1,
+                         const std::array<glm::vec3, 3>& triangle0, const std::array<glm::vec3, 3>& triangle1,
+                         TimeOfImpact& impact);
+
+// Earliest time at which edge (p, q) and edge (r, s), each end moving
+// linearly from its *0 to its *1 position, cross. Coplanarity of the four
+// ends is again a cubic in t.
+bool edgeEdgeImpact(const glm::vec3& p0, const glm::vec3& q0, const glm::vec3& p1, const glm::vec3& q1,
+                    const glm::vec3& r0, const glm::vec3& s0, const glm::vec3& r1, const glm::vec3& s1,
+                    TimeOfImpact& impact);
+
+// Buffers reused by solveClothCCD across calls
+struct ClothCCDScratch {
+  struct SweptBox {
+    glm::vec3 min;
+    glm::vec3 max;
+    // Particle, cloth edge or obstacle triangle, by kind
+    uint32_t index;
+    uint8_t kind;
+  };
+  std::vector<glm::vec3> vertexStart;
+  std::vector<glm::vec3> vertexEnd;
+  std::vector<uint32_t> triangles;
+  std::vector<SweptBox> boxes;
+  std::vector<uint32_t> activeCloth;
+  std::vector<uint32_t> activeTriangles;
+  std::vector<TimeOfImpact> particleImpacts;
+  std::vector<uint32_t> particleTriangles;
+  // Candidate (cloth edge, obstacle triangle) pairs
+  std::vector<std::array<uint32_t, 2>> edgeTriangles;
+};
+
+// Continuous collision of one cloth substep against moving obstacles. Each
+// particle travels from previousPosition to predictedPosition while the
+// obstacles move over [stepBegin, stepEnd] of their step. Candidates come
+// from a sweep-and-prune over the swept boxes of particles, cloth edges and
+// obstacle triangles. A particle that would cross a triangle is put back on
+// the side it came from, thickness off the triangle's end position; a cloth
+// edge that would cross a triangle edge is pushed apart from it the same way,
+// split over its two particles by inverse mass. Returns the number of
+// impacts resolved.
+size_t solveClothCCD(std::span<ClothParticle> particles,
+                     const ClothTopology& topology,
+                     std::span<const ClothObstacle> obstacles,
+                     float stepBegin,
+                     float stepEnd,
+                     float thickness,
+                     ClothCCDScratch& scratch);
+
+} // namespace physics
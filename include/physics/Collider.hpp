@@ -4,16 +4,39 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
+#include <vector>
+
 namespace physics {
 
+// Shape kinds the narrowphase pair table handles: primitives with closed-form
+// contacts, and convex hulls through GJK/EPA. The order indexes the table;
+// Custom colliders (hierarchies) dispatch virtually.
+enum class ColliderType : uint8_t {
+  Sphere,
+  Box,
+  Capsule,
+  Plane,
+  Convex,
+  Custom,
+};
+
+constexpr size_t kPrimitiveColliderTypes = static_cast<size_t>(ColliderType::Custom);
+
 struct Collider {
 
+  explicit Collider(ColliderType type = ColliderType::Custom) : type(type) {}
+  virtual ~Collider() = default;
+
+  ColliderType getType() const { return type; }
+
   // Stores contact info if sphere intersects collider. If no intersection, info is not modified
   virtual bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const = 0;
 
+private:
+  ColliderType type;
 };
 
 
 
 }
-
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <physics/ContactInfo.hpp>
+#include <physics/RigidPose.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+struct Collider;
+
+// Contact points of one body pair kept across steps. GJK/EPA finds a single
+// contact per step; keeping the earlier ones, anchored to both bodies and
+// re-measured at their current poses, builds up a manifold that supports a
+// resting hull at up to kMaxPoints places.
+class ContactManifold {
+public:
+  static constexpr size_t kMaxPoints = 4;
+  // A cached point is dropped once its two anchors slide further apart along
+  // the surface than this, or when a new contact lands this close to it
+  static constexpr float kPersistenceDistance = 0.02f;
+
+  // Re-measures the cached points at the bodies' poses and drops those that
+  // separated by more than maxSeparation or slid apart
+  void refresh(const RigidPose& poseA, const RigidPose& poseB, float maxSeparation);
+
+  // Adds a contact by its world-space points on A and B and its normal (A
+  // toward B). A normal that turned since the last contact clears the cache.
+  void add(const RigidPose& poseA, const RigidPose& poseB,
+           const glm::vec3& pointA, const glm::vec3& pointB, const glm::vec3& normal);
+
+  void clear() { count = 0; }
+  size_t size() const { return count; }
+
+  // The cached points as contacts from a to b, midway between their anchors
+  void appendContacts(const Collider* a, const Collider* b, std::vector<ContactInfo>& info) const;
+
+  // Step that last touched this manifold; the solver evicts stale pairs by it
+  uint64_t lastStep = 0;
+
+private:
+  struct Point {
+    glm::vec3 localA;
+    glm::vec3 localB;
+    glm::vec3 worldA;
+    glm::vec3 worldB;
+    float depth;
+  };
+
+  std::array<Point, kMaxPoints + 1> points;
+  size_t count = 0;
+  glm::vec3 normal = glm::vec3(0.0f);
+};
+
+} // namespace physics
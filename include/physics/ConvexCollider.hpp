@@ -0,0 +1,34 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+#include <physics/RigidPose.hpp>
+
+#include <app/modeling/ConvexHull.hpp>
+
+#include <glm/glm.hpp>
+
+#include <memory>
+
+namespace physics {
+
+// Convex hull placed in world space by pose, optionally rounded by margin
+// (the hull swept by a sphere of that radius). Contacts against spheres,
+// boxes, capsules and other hulls come from GJK/EPA; against planes from the
+// hull's vertices.
+struct ConvexCollider : public Collider {
+
+  ConvexCollider() : Collider(ColliderType::Convex) {}
+
+  // Stores contact info if the hull intersects collider. If no intersection, info is not modified
+  virtual bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
+
+  // World-space point of the (rounded) hull farthest along direction
+  glm::vec3 support(const glm::vec3& direction) const;
+
+  std::shared_ptr<const sauce::modeling::ConvexHull> hull;
+  RigidPose pose;
+  float margin = 0.0f;
+
+};
+
+}
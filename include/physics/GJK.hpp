@@ -0,0 +1,30 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+
+#include <glm/glm.hpp>
+
+#include <optional>
+
+namespace physics {
+
+// Deepest overlap of two convex colliders: moving b by normal * depth
+// separates them. pointA and pointB are the deepest points of each shape
+// inside the other, so pointA - pointB = normal * depth.
+struct Penetration {
+  glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+  float depth = 0.0f;
+  glm::vec3 pointA = glm::vec3(0.0f);
+  glm::vec3 pointB = glm::vec3(0.0f);
+};
+
+// World-space point of a sphere, box, capsule or convex hull farthest along
+// direction. Planes and Custom colliders have no support mapping.
+glm::vec3 supportPoint(const Collider& collider, const glm::vec3& direction);
+
+// GJK decides whether two convex colliders overlap; when they do, EPA expands
+// the final simplex to the face of their Minkowski difference nearest the
+// origin. Empty when the shapes are apart or only touch.
+std::optional<Penetration> penetration(const Collider& a, const Collider& b);
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+#include <physics/RigidPose.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sauce::modeling {
+class Mesh;
+}
+
+namespace physics {
+
+// Terrain stored as a regular grid of 16-bit heights over the local XZ plane,
+// Y up, placed in the world by pose. Sample (i, j) sits at local
+// (origin.x + i * spacing.x, heightOffset + heights[j * columns + i] * heightScale, origin.y + j * spacing.y).
+// Each cell is split into two triangles along its (i, j) - (i + 1, j + 1)
+// diagonal. A point finds the triangle under it with one cell lookup, so
+// contacts cost O(1) per point whatever the terrain size, and the grid takes
+// two bytes per sample against the vertices, triangles and nodes of a
+// triangle hierarchy.
+//
+// Contacts use the plane of the triangle under each tested point (sphere
+// centers, capsule end caps, box corners, hull vertices), so terrain features
+// narrower than a shape are not resolved against it.
+class HeightfieldCollider : public Collider {
+public:
+  struct Surface {
+    float height = 0.0f;
+    // Upward unit normal of the triangle, in the local frame
+    glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+  };
+
+  HeightfieldCollider() : Collider(ColliderType::Custom) {}
+
+  // Row-major samples, x fastest, such as a 16-bit height image decoded with
+  // stbi_load_16. Empty when there are fewer than 2 x 2 samples or the span
+  // does not hold columns * rows of them.
+  static std::optional<HeightfieldCollider> fromHeights(std::span<const uint16_t> heights,
+                                                        uint32_t columns, uint32_t rows,
+                                                        glm::vec2 spacing, float heightScale,
+                                                        float heightOffset = 0.0f);
+
+  // Heights of a mesh whose vertices form a regular grid in its local XZ
+  // plane (any vertex order, any triangulation), quantized to 16 bits over
+  // the mesh's height range. Empty when the vertices are not such a grid.
+  static std::optional<HeightfieldCollider> fromMesh(const sauce::modeling::Mesh& mesh);
+
+  // Contacts against spheres, capsules, boxes and hulls, normals pointing from
+  // the terrain toward the other collider. Points beyond the grid's edges
+  // never touch it.
+  bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
+
+  // Triangle under the local point (x, z); empty outside the grid
+  std::optional<Surface> surface(float x, float z) const;
+
+  // World-space distance of p above the triangle under it, measured along
+  // that triangle's world normal. False when p is not over the grid.
+  bool pointDistance(const glm::vec3& p, float& distance, glm::vec3& normal) const;
+
+  // Builds the min/max pyramid raycast descends: level 0 bounds each cell,
+  // every further level bounds 2 x 2 blocks of the one below
+  void buildMipPyramid();
+
+  // Closest hit along the world-space ray within maxDistance, in multiples of
+  // direction. Walks the cells the ray crosses, or with the pyramid built
+  // skips every block whose height range the ray passes over.
+  bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+               float& distance, glm::vec3& normal) const;
+
+  uint32_t getColumns() const { return columns; }
+  uint32_t getRows() const { return rows; }
+  glm::vec2 getSpacing() const { return spacing; }
+  size_t getMipLevelCount() const { return mipLevels.size(); }
+  // Bytes held by the heights and the pyramid
+  size_t getMemoryBytes() const;
+
+  RigidPose pose;
+
+private:
+  struct MinMax {
+    uint16_t min = 0;
+    uint16_t max = 0;
+  };
+  struct MipLevel {
+    uint32_t columns = 0;
+    uint32_t rows = 0;
+    std::vector<MinMax> bounds;
+  };
+
+  float sampleHeight(uint32_t i, uint32_t j) const {
+    return heightOffset + heightScale * static_cast<float>(heights[j * columns + i]);
+  }
+  // Triangle of cell (i, j) under the point at (fx, fz) within the cell
+  Surface cellSurface(uint32_t i, uint32_t j, float fx, float fz) const;
+  // Nearest hit of the local ray with the two triangles of cell (i, j)
+  bool intersectCell(uint32_t i, uint32_t j, const glm::vec3& origin, const glm::vec3& direction,
+                     float& t, glm::vec3& normal) const;
+  bool raycastCells(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                    float& t, glm::vec3& normal) const;
+  bool raycastPyramid(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                      float& t, glm::vec3& normal) const;
+  bool pointContact(const glm::vec3& p, float radius, const Collider* other,
+                    std::vector<ContactInfo>& info) const;
+
+  uint32_t columns = 0;
+  uint32_t rows = 0;
+  glm::vec2 origin = glm::vec2(0.0f);
+  glm::vec2 spacing = glm::vec2(1.0f);
+  float heightScale = 1.0f;
+  float heightOffset = 0.0f;
+  std::vector<uint16_t> heights;
+  std::vector<MipLevel> mipLevels;
+};
+
+} // namespace physics
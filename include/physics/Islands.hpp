@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace physics {
+
+// Pair of rigid-body indices whose bounds overlap in the broadphase
+struct BodyPair {
+  uint32_t a;
+  uint32_t b;
+};
+
+// Disjoint-set forest with path halving and union by size
+class UnionFind {
+public:
+  explicit UnionFind(size_t count = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : parent(resource), size(resource) {
+    reset(count);
+  }
+
+  void reset(size_t count);
+  uint32_t find(uint32_t i);
+  void unite(uint32_t a, uint32_t b);
+
+private:
+  std::pmr::vector<uint32_t> parent;
+  std::pmr::vector<uint32_t> size;
+};
+
+// Group of dynamic bodies connected through broadphase pairs. Static bodies
+// (inverse mass 0) never join an island so a shared floor does not merge
+// everything resting on it into one island.
+// Both index lists allocate from the resource the island was made with.
+struct Island {
+  explicit Island(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : bodyIndices(resource), pairIndices(resource) {}
+
+  std::pmr::vector<uint32_t> bodyIndices;
+  std::pmr::vector<uint32_t> pairIndices;
+};
+
+// Builds islands over bodyCount bodies. isStatic[i] is nonzero for bodies that
+// do not propagate connectivity; pairs between two static bodies are dropped.
+// Bodies without any pair become singleton islands. The islands and all
+// scratch memory come from resource.
+std::pmr::vector<Island> buildIslands(size_t bodyCount,
+                                      std::span<const BodyPair> pairs,
+                                      std::span<const uint8_t> isStatic,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+} // namespace physics
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+#include <physics/ContactInfo.hpp>
+
+#include <vector>
+
+namespace physics {
+
+// Contact generation between two colliders. Primitive pairs go through a
+// table indexed by both ColliderTypes; pairs involving a Custom collider fall
+// back to its virtual checkCollision. Normals point from a toward b, and info
+// is left untouched when there is no contact.
+bool collide(const Collider& a, const Collider& b, std::vector<ContactInfo>& info);
+
+// Groups contacts[first, end) into patches of similar normal and reduces
+// each to at most four that best represent it. Works in place, so it never
+// allocates.
+void reduceManifold(std::vector<ContactInfo>& contacts, size_t first = 0);
+
+}
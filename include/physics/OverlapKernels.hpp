@@ -0,0 +1,82 @@
+#pragma once
+
+#include <physics/AABB.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace physics {
+
+// Structure-of-arrays views over sphere and box batches. Every array holds at
+// least as many elements as the index ranges passed to the kernels.
+struct SphereSoA {
+  const float* x = nullptr;
+  const float* y = nullptr;
+  const float* z = nullptr;
+  const float* radius = nullptr;
+};
+
+struct AABBSoA {
+  const float* minX = nullptr;
+  const float* minY = nullptr;
+  const float* minZ = nullptr;
+  const float* maxX = nullptr;
+  const float* maxY = nullptr;
+  const float* maxZ = nullptr;
+};
+
+// Rays sharing one traversal in intersectRayPacketAABB
+inline constexpr size_t kRayPacketWidth = 4;
+
+struct RayPacketSoA {
+  float originX[kRayPacketWidth];
+  float originY[kRayPacketWidth];
+  float originZ[kRayPacketWidth];
+  float invDirectionX[kRayPacketWidth];
+  float invDirectionY[kRayPacketWidth];
+  float invDirectionZ[kRayPacketWidth];
+};
+
+// Batched overlap kernels. Each one-vs-many test checks the elements in
+// [begin, end), appends the indices that pass to out in increasing order and
+// returns how many it wrote; out needs room for end - begin indices. Touching
+// counts as overlapping. Builds with AVX2 run 8 lanes, SSE2 builds 4, and
+// anything else uses the scalar versions below.
+size_t overlapSphereSpheres(const glm::vec3& center, float radius, const SphereSoA& spheres,
+                            size_t begin, size_t end, uint32_t* out);
+size_t overlapSphereAABBs(const glm::vec3& center, float radius, const AABBSoA& boxes,
+                          size_t begin, size_t end, uint32_t* out);
+size_t overlapAABBAABBs(const AABB& box, const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out);
+
+// Slab test of one ray against many boxes. Boxes entered within maxDistance
+// are appended to out with their entry distance (0 when the origin is inside)
+// in tEnter at the same position.
+size_t intersectRayAABBs(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance,
+                         const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out, float* tEnter);
+
+// Slab test of a packet of rays against one box. Returns a bit per lane that
+// enters the box within maxDistance[lane], with the entry distance in tEnter.
+uint32_t intersectRayPacketAABB(const RayPacketSoA& packet, const float* maxDistance,
+                                const glm::vec3& min, const glm::vec3& max, float* tEnter);
+
+// Lanes per instruction of the kernels above, for benchmarks and logs
+size_t overlapKernelWidth();
+
+// Reference implementations, also used for the tails the vector loops leave
+namespace scalar {
+
+size_t overlapSphereSpheres(const glm::vec3& center, float radius, const SphereSoA& spheres,
+                            size_t begin, size_t end, uint32_t* out);
+size_t overlapSphereAABBs(const glm::vec3& center, float radius, const AABBSoA& boxes,
+                          size_t begin, size_t end, uint32_t* out);
+size_t overlapAABBAABBs(const AABB& box, const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out);
+size_t intersectRayAABBs(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance,
+                         const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out, float* tEnter);
+uint32_t intersectRayPacketAABB(const RayPacketSoA& packet, const float* maxDistance,
+                                const glm::vec3& min, const glm::vec3& max, float* tEnter);
+
+} // namespace scalar
+
+} // namespace physics
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace physics {
+
+// Pipeline stages timed by PhysicsProfiler. NormalRegeneration and GpuUpload
+// run on the render side after the physics steps of a frame.
+enum class ProfileStage : uint8_t {
+  Broadphase,
+  Narrowphase,
+  Solve,
+  ClothSubsteps,
+  NormalRegeneration,
+  GpuUpload,
+};
+inline constexpr size_t kProfileStageCount = 6;
+
+const char* profileStageName(ProfileStage stage);
+
+// Timings and counters for one frame. Stage times and counters add up over
+// every physics step run in the frame; residual is the largest one seen.
+struct PhysicsSample {
+  std::array<float, kProfileStageCount> stageMs {};
+  uint32_t steps = 0;
+  uint32_t bodies = 0;
+  uint32_t pairs = 0;
+  uint32_t contacts = 0;     // broadphase pairs that produced at least one contact
+  uint32_t constraints = 0;
+  uint32_t iterations = 0;
+  float residual = 0.0f;     // largest constraint violation after the last iteration
+  uint32_t arenaOverflows = 0;  // step arena blocks taken from the heap; zero once warmed up
+
+  float stage(ProfileStage s) const { return stageMs[static_cast<size_t>(s)]; }
+  float totalMs() const;
+};
+
+// Fixed-size ring buffer of the last kHistorySize frame samples. The solver
+// and the app record into current() between beginSample and endSample; the
+// debug UI reads the committed history. Not thread-safe: record from the
+// thread that drives the physics steps.
+class PhysicsProfiler {
+public:
+  static constexpr size_t kHistorySize = 240;
+
+  void beginSample();
+  void endSample();
+
+  PhysicsSample& current() { return pending; }
+  void addTime(ProfileStage stage, float ms) { pending.stageMs[static_cast<size_t>(stage)] += ms; }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  // age 0 is the most recent committed sample
+  const PhysicsSample& sample(size_t age) const;
+
+  // Stage time of every committed sample, oldest first
+  void stageHistory(ProfileStage stage, std::vector<float>& out) const;
+  void totalHistory(std::vector<float>& out) const;
+
+  // Rolling statistics over the committed samples
+  float average(ProfileStage stage) const;
+  float percentile(ProfileStage stage, float p) const;
+  float averageTotal() const;
+  float percentileTotal(float p) const;
+
+  void clear();
+
+private:
+  std::array<PhysicsSample, kHistorySize> history {};
+  size_t next = 0;
+  size_t count = 0;
+  PhysicsSample pending;
+};
+
+// Adds the time until destruction to a stage; does nothing without a profiler
+class ProfileScope {
+public:
+  ProfileScope(PhysicsProfiler* target, ProfileStage timedStage)
+      : profiler(target), stage(timedStage) {
+    if (profiler) {
+      start = std::chrono::steady_clock::now();
+    }
+  }
+  ~ProfileScope() {
+    if (profiler) {
+      const auto end = std::chrono::steady_clock::now();
+      profiler->addTime(stage, std::chrono::duration<float, std::milli>(end - start).count());
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  PhysicsProfiler* profiler;
+  ProfileStage stage;
+  std::chrono::steady_clock::time_point start;
+};
+
+} // namespace physics
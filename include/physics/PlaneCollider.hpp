@@ -0,0 +1,25 @@
+#pragma once
+
+#include <physics/Collider.hpp>
+
+#include <glm/glm.hpp>
+
+namespace physics {
+
+// Infinite half-space below the plane dot(normal, x) = offset; everything on
+// the negative side of the normal is solid
+struct PlaneCollider : public Collider {
+
+  PlaneCollider() : Collider(ColliderType::Plane) {}
+
+  // Stores contact info if collider reaches below the plane. If no intersection, info is not modified
+  virtual bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
+
+  float signedDistance(const glm::vec3& p) const { return glm::dot(normal, p) - offset; }
+
+  glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+  float offset = 0.0f;
+
+};
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace physics {
+
+// Rotation + translation placing a collider's local frame in world space
+struct RigidPose {
+  glm::vec3 position = glm::vec3(0.0f);
+  glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+  glm::vec3 transformPoint(const glm::vec3& p) const { return position + orientation * p; }
+  glm::vec3 transformVector(const glm::vec3& v) const { return orientation * v; }
+  glm::vec3 inverseTransformPoint(const glm::vec3& p) const { return glm::conjugate(orientation) * (p - position); }
+  glm::vec3 inverseTransformVector(const glm::vec3& v) const { return glm::conjugate(orientation) * v; }
+
+  // Pose of `other` expressed in this pose's local frame
+  RigidPose relative(const RigidPose& other) const {
+    return { inverseTransformPoint(other.position), glm::conjugate(orientation) * other.orientation };
+  }
+};
+
+} // namespace physics
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <physics/AABB.hpp>
+#include <physics/OverlapKernels.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace sauce {
+class Scene;
+}
+
+namespace physics {
+
+// Ray for scene queries. Distances are measured in multiples of direction, so
+// a unit direction gives world-space distances.
+struct QueryRay {
+  glm::vec3 origin = glm::vec3(0.0f);
+  glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+  float maxDistance = std::numeric_limits<float>::max();
+};
+
+struct RaycastHit {
+  uint32_t id = std::numeric_limits<uint32_t>::max();
+  float distance = 0.0f;
+  glm::vec3 point = glm::vec3(0.0f);
+
+  bool hit() const { return id != std::numeric_limits<uint32_t>::max(); }
+};
+
+// Spatial queries over the bounds of scene objects: closest-hit and any-hit
+// raycasts, sphere and box overlaps, and a batched raycast that traces packets
+// of rays through the hierarchy together. The hierarchy is flattened in
+// depth-first order like SphereBVH. Leaves hold up to kMaxLeafProxies proxies
+// whose bounds are kept structure-of-arrays and tested with the batched
+// kernels from OverlapKernels.hpp.
+class SceneQuery {
+public:
+  // Bounded object in the query structure; id is reported back by queries
+  struct Proxy {
+    AABB bounds;
+    uint32_t id = 0;
+  };
+
+  // Rays traced together by raycastBatch
+  static constexpr size_t kPacketWidth = kRayPacketWidth;
+  static constexpr size_t kMaxLeafProxies = 8;
+
+  SceneQuery() = default;
+
+  // One proxy per mesh of every active entity, bounding the mesh in world
+  // space. The id is the entity's index in Scene::getEntities(), shared by
+  // all proxies of an entity.
+  static SceneQuery fromScene(const sauce::Scene& scene);
+
+  void build(std::vector<Proxy> proxies);
+
+  // Closest proxy the ray enters; a ray starting inside a proxy hits it at 0
+  bool raycast(const QueryRay& ray, RaycastHit& hit) const;
+  // Whether the ray hits anything, stopping at the first hit found
+  bool raycastAny(const QueryRay& ray) const;
+
+  // Ids of every proxy whose bounds overlap the sphere or box, appended to ids
+  void overlapSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& ids) const;
+  void overlapAABB(const AABB& box, std::vector<uint32_t>& ids) const;
+
+  // Closest hit for every ray, hits[i] for rays[i]. Rays are traced in packets
+  // of kPacketWidth sharing one traversal, and large batches are split across
+  // TaskPool::shared(). Coherent rays (camera or sensor fans) benefit most.
+  void raycastBatch(std::span<const QueryRay> rays, std::vector<RaycastHit>& hits) const;
+
+  bool empty() const { return nodes.empty(); }
+  size_t getProxyCount() const { return proxies.size(); }
+
+private:
+  struct Node {
+    glm::vec3 min;
+    uint32_t skipIndex;
+    glm::vec3 max;
+    uint32_t firstProxy : 28;
+    uint32_t proxyCount : 4; // 0 for interior nodes
+
+    bool isLeaf() const { return proxyCount != 0; }
+  };
+  static_assert(sizeof(Node) == 32, "SceneQuery::Node should fill half a cache line");
+
+  void buildNode(std::vector<Proxy>& items, size_t start, size_t end);
+  void tracePacket(const QueryRay* rays, size_t count, RaycastHit* hits) const;
+  AABBSoA proxyBounds() const;
+
+  std::vector<Node> nodes;
+  std::vector<Proxy> proxies;
+  // Bounds of proxies[i], structure-of-arrays for the leaf kernels
+  std::vector<float> proxyMinX, proxyMinY, proxyMinZ;
+  std::vector<float> proxyMaxX, proxyMaxY, proxyMaxZ;
+};
+
+} // namespace physics
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <physics/RigidPose.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace sauce::modeling {
+class Mesh;
+}
+
+namespace physics {
+
+// Narrow-band signed distance field of a closed triangle mesh, in the mesh's
+// local frame (negative inside). Space is divided into bricks of kBrickCells^3
+// cells. Only bricks within bandWidth of the surface store samples, quantized
+// to 16 bits; every other brick is only tagged inside or outside. A query reads
+// one brick and interpolates trilinearly, so its cost does not depend on the
+// triangle count.
+class SignedDistanceField {
+public:
+  // Cells per brick side; a brick stores kBrickCells + 1 samples per side so
+  // interpolation never reads a neighbouring brick
+  static constexpr int kBrickCells = 7;
+  static constexpr int kBrickSamples = kBrickCells + 1;
+
+  struct Sample {
+    float distance = 0.0f;
+    // Unit direction of increasing distance; zero where the field is flat
+    // (outside the band)
+    glm::vec3 gradient = glm::vec3(0.0f);
+  };
+
+  SignedDistanceField() = default;
+
+  // Bakes the field on TaskPool::shared(), one brick per task. Distances
+  // further than bandWidth from the surface are clamped to +-bandWidth.
+  static SignedDistanceField fromMesh(const sauce::modeling::Mesh& mesh, float cellSize, float bandWidth);
+
+  // Reads <cacheDirectory>/<cacheKey>.sdf when it exists and matches the
+  // mesh, otherwise bakes the field and writes it there. An empty directory
+  // disables the cache.
+  static SignedDistanceField loadOrBake(const sauce::modeling::Mesh& mesh, float cellSize, float bandWidth,
+                                        const std::filesystem::path& cacheDirectory);
+
+  // Hash of the mesh geometry and bake parameters that names its cache file
+  static uint64_t cacheKey(const sauce::modeling::Mesh& mesh, float cellSize, float bandWidth);
+
+  bool save(const std::filesystem::path& path, uint64_t key) const;
+  // Empty when the file is missing, truncated or was baked under another key
+  static std::optional<SignedDistanceField> load(const std::filesystem::path& path, uint64_t key);
+
+  float distance(const glm::vec3& p) const;
+  Sample sample(const glm::vec3& p) const;
+
+  bool empty() const { return brickSlots.empty(); }
+  float getCellSize() const { return cellSize; }
+  float getBandWidth() const { return bandWidth; }
+  size_t getBrickCount() const { return samples.size() / (kBrickSamples * kBrickSamples * kBrickSamples); }
+  // Bytes held by the brick table and samples
+  size_t getMemoryBytes() const {
+    return brickSlots.size() * sizeof(uint32_t) + samples.size() * sizeof(int16_t);
+  }
+
+private:
+  // Brick slot values for bricks without samples
+  static constexpr uint32_t kOutsideBrick = 0xffffffffu;
+  static constexpr uint32_t kInsideBrick = 0xfffffffeu;
+
+  glm::vec3 origin = glm::vec3(0.0f);
+  float cellSize = 0.0f;
+  float bandWidth = 0.0f;
+  glm::ivec3 brickDims = glm::ivec3(0);
+  // Per brick: first sample of its block in samples, or one of the tags above
+  std::vector<uint32_t> brickSlots;
+  // kBrickSamples^3 per stored brick, x fastest, scaled so +-32767 is +-bandWidth
+  std::vector<int16_t> samples;
+};
+
+// A baked field placed in the world, for particle contacts against static geometry
+struct DistanceFieldCollider {
+  std::shared_ptr<const SignedDistanceField> field;
+  RigidPose pose;
+};
+
+} // namespace physics
@@ -2,39 +2,83 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include <app/modeling/Mesh.hpp>
 #include <app/Scene.hpp>
 #include <physics/Collider.hpp>
+#include <physics/RigidPose.hpp>
 #include <physics/SphereCollider.hpp>
 #include <app/Entity.hpp>
 #include <app/components/MeshRendererComponent.hpp>
 
 namespace physics {
 
-struct SphereBVHNode: public Collider {
-    SphereCollider sphere;
-    std::unique_ptr<SphereBVHNode> left;
-    std::unique_ptr<SphereBVHNode> right;
-    
-    std::vector<uint32_t> triangleIndices;
-
-    bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const;
+// One node of a flattened sphere hierarchy. Nodes are stored in depth-first
+// order, so an interior node's left child is the next node and its right child
+// starts at the left child's skipIndex. skipIndex is the node that follows this
+// whole subtree, which lets a traversal reject a subtree with a single jump.
+struct SphereBVHNode {
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+    uint32_t skipIndex = 0;
+    uint32_t firstTriangle = 0; // offset into SphereBVH's triangle index array
+    uint32_t triangleCount = 0; // 0 for interior nodes
+    uint32_t padding = 0;
 
-    static std::unique_ptr<SphereBVHNode> fromMesh(sauce::modeling::Mesh& mesh);
-    bool isLeaf() const;
+    bool isLeaf() const { return triangleCount != 0; }
 };
+static_assert(sizeof(SphereBVHNode) == 32, "SphereBVHNode should fill half a cache line");
 
 class SphereBVH: public Collider {
 public:
-    static SphereBVH fromScene(const sauce::Scene& scene);
+    // Median splits the longest centroid axis at the middle triangle; BinnedSAH
+    // picks the split plane by the surface area heuristic. Both fork subtrees
+    // of large meshes onto TaskPool::shared().
+    enum class BuildStrategy {
+        Median,
+        BinnedSAH,
+    };
+
+    SphereBVH() = default;
+
+    // Hierarchy over the triangles of one mesh, in the mesh's local frame
+    static SphereBVH fromMesh(const sauce::modeling::Mesh& mesh, BuildStrategy strategy = BuildStrategy::BinnedSAH);
+    // Hierarchy over the triangles of every mesh in the scene
+    static SphereBVH fromScene(const sauce::Scene& scene, BuildStrategy strategy = BuildStrategy::BinnedSAH);
+
+    // Sphere query: reports a contact against every leaf sphere the collider overlaps
+    bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
 
-    bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const;
+    // Mesh-vs-mesh narrowphase: simultaneous traversal of two hierarchies built
+    // with fromMesh, each placed in world space by its pose. Leaf pairs run
+    // triangle-triangle tests; the contacts are reduced to a manifold and
+    // reported in world space with normals pointing from A toward B.
+    static bool collide(const SphereBVH& treeA, const sauce::modeling::Mesh& meshA, const RigidPose& poseA,
+                        const SphereBVH& treeB, const sauce::modeling::Mesh& meshB, const RigidPose& poseB,
+                        std::vector<ContactInfo>& info);
 
-    SphereBVHNode *getRoot() const;
+    // Deforming meshes: recompute every bounding sphere bottom-up from the mesh's
+    // current vertex positions in O(n), keeping the topology from fromMesh.
+    // The triangle count must not have changed since the build.
+    void refit(const sauce::modeling::Mesh& mesh);
+
+    // Refits, or rebuilds from scratch when the triangle count changed or the
+    // refitted cost exceeds maxCostGrowth times the cost right after the last
+    // build. Returns true when the tree was rebuilt.
+    bool refitOrRebuild(const sauce::modeling::Mesh& mesh, float maxCostGrowth = 2.0f);
+
+    // Sum of squared node radii: proportional to the sphere surface area a
+    // query expects to test, so it grows as refits loosen the tree
+    float getCost() const;
+
+    bool empty() const { return nodes.empty(); }
+    const std::vector<SphereBVHNode>& getNodes() const { return nodes; }
+    const std::vector<uint32_t>& getTriangleIndices() const { return triangleIndices; }
 
 private:
-    std::unique_ptr<SphereBVHNode> root;
-    
-    SphereBVH(std::unique_ptr<SphereBVHNode> root) : root(std::move(root)) {}
+    std::vector<SphereBVHNode> nodes;
+    std::vector<uint32_t> triangleIndices;
+    float buildCost = 0.0f;
+    BuildStrategy strategy = BuildStrategy::BinnedSAH;
 };
 }
@@ -8,6 +8,8 @@ namespace physics {
 
 struct SphereCollider : public Collider {
 
+  SphereCollider() : Collider(ColliderType::Sphere) {}
+
   // Stores contact info if spheres intersect. If no intersection, info is not modified
   virtual bool checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const override;
 
@@ -17,4 +19,3 @@ struct SphereCollider : public Collider {
 };
 
 }
-
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace physics {
+
+// Linear allocator for memory that only lives for one physics step. Allocations
+// bump an offset into one owned block and deallocate does nothing; reset()
+// hands the whole block back at once. A step that outgrows the block is served
+// from the heap, and the next reset() regrows the block past that step's
+// high-water mark, so a simulation of steady size stops touching the heap after
+// its first step. Not thread-safe: allocate from one thread only.
+class StepArena : public std::pmr::memory_resource {
+public:
+  explicit StepArena(size_t initialCapacity = 0);
+  ~StepArena() override;
+
+  StepArena(const StepArena&) = delete;
+  StepArena& operator=(const StepArena&) = delete;
+
+  // Releases everything allocated since the last reset. Nothing allocated
+  // from the arena may be used afterwards.
+  void reset();
+
+  size_t capacity() const { return blockSize; }
+  // Bytes handed out since the last reset, including heap overflow
+  size_t bytesUsed() const { return offset + overflowBytes; }
+  // Heap allocations made because a step outgrew the block, since construction
+  size_t overflowCount() const { return overflows; }
+
+private:
+  struct Overflow;
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void*, size_t, size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  void releaseOverflow();
+
+  std::byte* block = nullptr;
+  size_t blockSize = 0;
+  size_t offset = 0;
+  size_t overflowBytes = 0;
+  size_t overflows = 0;
+  Overflow* overflowChunks = nullptr;
+};
+
+} // namespace physics
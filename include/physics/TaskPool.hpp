@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace physics {
+
+// Fixed-size worker pool for fork/join style physics jobs. The calling thread
+// participates in every job, so a pool with zero workers degrades to a plain loop.
+class TaskPool {
+public:
+  // threadCount = 0 picks hardware_concurrency() - 1 workers
+  explicit TaskPool(unsigned threadCount = 0);
+  ~TaskPool();
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  // Number of threads that execute a job, including the caller
+  unsigned getConcurrency() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+  // Invokes fn(i) for every i in [0, count) and blocks until all calls return.
+  // Calls made from inside a running job execute serially on the calling thread.
+  void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+  // Process-wide pool shared by the solver, BVH builder and loaders
+  static TaskPool& shared();
+
+private:
+  void workerLoop();
+  void runIndices(const std::function<void(size_t)>& fn, size_t count);
+
+  std::vector<std::thread> workers;
+
+  std::mutex dispatchMutex;
+  std::mutex mutex;
+  std::condition_variable wakeCondition;
+  std::condition_variable doneCondition;
+
+  const std::function<void(size_t)>* job = nullptr;
+  size_t jobCount = 0;
+  std::atomic<size_t> nextIndex { 0 };
+  size_t activeWorkers = 0;
+  uint64_t generation = 0;
+  bool stopping = false;
+};
+
+} // namespace physics
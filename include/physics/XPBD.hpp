@@ -1,32 +1,113 @@
 #pragma once
 
+#include <physics/ClothCCD.hpp>
+#include <physics/ContactInfo.hpp>
+#include <physics/ContactManifold.hpp>
+#include <physics/Islands.hpp>
+#include <physics/SignedDistanceField.hpp>
+#include <physics/StepArena.hpp>
+
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 namespace sauce {
 struct ClothSettings;
 class RigidBodyComponent;
+namespace modeling {
+class Mesh;
+}
 }
 
 namespace physics {
 
 struct ClothData;
 struct Constraint;
+struct NarrowphaseChunk;
+class HeightfieldCollider;
+class PhysicsProfiler;
+class SphereBVH;
 struct Vertex;
 
 struct XPBDSolver {
+  XPBDSolver();
+  ~XPBDSolver();
 
   // Gauss-Seidel iterations per rigid-body solve pass
   int solverIterations = 10;
 
-  void solvePositions(std::vector<sauce::RigidBodyComponent>& rigidBodies,
-                      std::vector<std::unique_ptr<Constraint>>& constraints,
-                      float deltatime);
+  // Rigid-body substeps per solvePositions call. Above 1 the solver runs small
+  // steps instead of iterations: contacts are still detected once for the whole
+  // step, then every substep integrates (including orientation), projects each
+  // contact once and derives linear and angular velocity from its motion.
+  // solverIterations is ignored for rigid bodies in this mode.
+  int substeps = 1;
+
+  // Solve independent contact islands concurrently on TaskPool::shared()
+  bool parallelIslands = true;
+
+  // Run the narrowphase concurrently on TaskPool::shared(). The step's pairs are
+  // cut into chunks of fixed size, each writing its own contact buffer, and the
+  // buffers are merged in pair order, so the contacts are the same for any
+  // thread count.
+  bool parallelNarrowphase = true;
+
+  // An island whose bodies all stay below both speed thresholds for sleepStepThreshold
+  // consecutive steps goes to sleep: no integration and no narrowphase until an awake
+  // body touches it again.
+  bool enableSleeping = true;
+  float sleepLinearThreshold = 0.05f;
+  float sleepAngularThreshold = 0.05f;
+  int sleepStepThreshold = 60;
+
+  // Narrowphase on the triangle meshes (dual SphereBVH traversal) instead of the
+  // bodies' bounding spheres
+  bool meshContacts = false;
+
+  // Detect contacts at the start of each step over the bodies' swept motion, so
+  // fast bodies collide with what they would pass through within one step.
+  // Triangle-mesh pairs (meshContacts) still detect at the end of the step.
+  bool speculativeContacts = true;
+
+  // Static geometry the cloth collides with: every substep pushes particles
+  // that end up within ClothSettings::collisionThickness of a field's surface
+  // back out along its gradient, one O(1) lookup per particle and field
+  std::vector<DistanceFieldCollider> distanceFields;
+
+  // Static terrain. Rigid bodies collide with it through their analytic
+  // collider (mesh bodies through their bounding sphere) and cloth particles
+  // keep ClothSettings::collisionThickness above it; either costs one cell
+  // lookup per tested point.
+  std::vector<std::shared_ptr<const HeightfieldCollider>> heightfields;
+
+  // Moving triangle meshes the cloth may not pass through, however fast they
+  // move: every substep sweeps particles and cloth edges against the part of
+  // each obstacle's motion the substep covers (continuous collision), so low
+  // ClothSettings::solverSubsteps do not let thin cloth tunnel
+  std::vector<ClothObstacle> clothObstacles;
+
+  // When set, each solve adds its stage timings and counters to the
+  // profiler's current sample
+  PhysicsProfiler* profiler = nullptr;
+
+  // One rigid-body step. Everything the step needs only while it runs (bounds,
+  // pairs, islands, contact constraints) comes from the solver's StepArena,
+  // which is reset at the start of each call, so a scene of steady size makes
+  // no heap allocations once the arena has grown to fit it.
+  //
+  // bodyDeltaTimes, when it has one entry per body, gives each body its own
+  // step length, so bodies on a lower simulation rate cover the ticks they
+  // skipped. A body with a step of 0 is held in place as a static obstacle.
+  void solvePositions(std::vector<sauce::RigidBodyComponent>& rigidBodies, float deltatime,
+                      std::span<const float> bodyDeltaTimes = {});
 
   // Cloth-only pipeline: external acceleration, substepped XPBD on particle arrays (rigid bodies
-  // untouched). Lambdas reset at the start of each substep.
+  // untouched) and contacts against distanceFields and heightfields. Lambdas reset at the start of each substep.
   void solveCloth(ClothData& cloth,
                   const sauce::ClothSettings& settings,
                   float deltatime,
@@ -39,6 +120,42 @@ struct XPBDSolver {
 
   std::vector<std::unique_ptr<Constraint>> generateCollisionConstraints(
       std::vector<sauce::RigidBodyComponent>& rigidBodies);
+
+  // Bounding-sphere broadphase. Pairs in which neither body is awake and dynamic are skipped.
+  std::vector<BodyPair> findBroadphasePairs(std::vector<sauce::RigidBodyComponent>& rigidBodies);
+
+  // Islands built during the last solvePositions call; they live in the step
+  // arena and are released by the next call
+  const std::pmr::vector<Island>& getIslands() const { return islands; }
+
+  // Per-step scratch memory. Its overflowCount() only grows on steps that
+  // outgrew the arena and had to fall back to the heap.
+  const StepArena& getStepArena() const { return stepArena; }
+
+  // Collision hierarchy for a mesh, built on first use and cached by the solver
+  const SphereBVH* getMeshBVH(const std::shared_ptr<sauce::modeling::Mesh>& mesh);
+
+  // Call after a cached mesh's vertices moved: refits its hierarchy, rebuilding
+  // only once the refitted spheres have grown past meshBVHRebuildThreshold
+  void updateMeshBVH(const std::shared_ptr<sauce::modeling::Mesh>& mesh);
+  float meshBVHRebuildThreshold = 2.0f;
+
+private:
+  struct MeshBVH {
+    std::shared_ptr<sauce::modeling::Mesh> mesh;
+    std::unique_ptr<SphereBVH> tree;
+  };
+
+  StepArena stepArena;
+  std::pmr::vector<Island> islands { &stepArena };
+  // Narrowphase output per chunk of pairs, kept across steps so the buffers
+  // keep their capacity
+  std::vector<NarrowphaseChunk> narrowphaseChunks;
+  ClothCCDScratch clothCCDScratch;
+  std::unordered_map<const sauce::modeling::Mesh*, MeshBVH> meshBVHs;
+  // Persistent contacts of the pairs with a convex hull, keyed by body indices
+  std::unordered_map<uint64_t, ContactManifold> contactManifolds;
+  uint64_t stepIndex = 0;
 };
 
 } // namespace physics
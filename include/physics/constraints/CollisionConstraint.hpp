@@ -4,19 +4,31 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 
 namespace physics {
 
 // Position Based Dynamics Collision constraint
-struct CollisionConstraint : public Constraint {
+struct CollisionConstraint final : public Constraint {
   CollisionConstraint() = default;
 
-  // Construct from two vertex indices plus collision geometry.
+  // Construct from two vertex indices plus collision geometry. restDist is the
+  // separation along the normal (A -> B) at which the bodies just touch.
   CollisionConstraint(uint32_t a, uint32_t b, glm::vec3 normal, float depth,
-                      float comp = 0.0f)
-      : Constraint(comp), indexA(a), indexB(b), contactNormal(normal), penetrationDepth(depth) {}
+                      float comp = 0.0f, float restDist = 0.0f)
+      : Constraint(comp), indexA(a), indexB(b), contactNormal(normal), penetrationDepth(depth),
+        restDistance(restDist) {}
+
+  // Construct from two bodies touching at a point. armA and armB run from
+  // each body's center to the contact point in that body's own frame, so the
+  // point turns with the bodies and a push off their centers makes them spin.
+  // restDist is then the separation of the two attached points.
+  CollisionConstraint(uint32_t a, uint32_t b, glm::vec3 normal, float depth,
+                      glm::vec3 localArmA, glm::vec3 localArmB, float comp = 0.0f, float restDist = 0.0f)
+      : Constraint(comp), indexA(a), indexB(b), contactNormal(normal), penetrationDepth(depth),
+        restDistance(restDist), armA(localArmA), armB(localArmB) {}
 
   // Construct from single vertex colliding with a static surface.
   CollisionConstraint(uint32_t a, glm::vec3 contactPt, glm::vec3 normal,
@@ -24,7 +36,7 @@ struct CollisionConstraint : public Constraint {
       : Constraint(comp), indexA(a), indexB(UINT32_MAX), contactPoint(contactPt),
         contactNormal(normal), isStaticCollision(true) {}
 
-  void solve(std::vector<physics::Vertex>& vertices, float deltatime) override {
+  void solve(std::span<physics::Vertex> vertices, float deltatime) override {
     if (isStaticCollision) {
       solveStatic(vertices, deltatime);
     } else {
@@ -32,26 +44,92 @@ struct CollisionConstraint : public Constraint {
     }
   }
 
+  // Velocity pass of the small-steps solver: a contact that pushed this
+  // substep ends it with no normal velocity, so depenetration does not turn
+  // into a bounce (no restitution)
+  void solveVelocity(std::span<physics::Vertex> vertices) const {
+    if (lambda <= 0.0f) return;
+    if (isStaticCollision) {
+      if (indexA >= vertices.size() || vertices[indexA].invMass <= 1e-8f) return;
+      vertices[indexA].velocity -= std::max(0.0f, glm::dot(vertices[indexA].velocity, contactNormal)) * contactNormal;
+      return;
+    }
+    if (indexA >= vertices.size() || indexB >= vertices.size()) return;
+
+    physics::Vertex& va = vertices[indexA];
+    physics::Vertex& vb = vertices[indexB];
+    const glm::vec3 rA = va.orientation * armA;
+    const glm::vec3 rB = vb.orientation * armB;
+    const float w1 = generalizedInvMass(va, rA);
+    const float w2 = generalizedInvMass(vb, rB);
+    if (w1 + w2 <= 1e-8f) return;
+
+    const glm::vec3 pointVelocityA = va.velocity + glm::cross(va.angularVelocity, rA);
+    const glm::vec3 pointVelocityB = vb.velocity + glm::cross(vb.angularVelocity, rB);
+    const float vn = glm::dot(pointVelocityB - pointVelocityA, contactNormal);
+    if (vn <= 0.0f) return;
+    const glm::vec3 impulse = (vn / (w1 + w2)) * contactNormal;
+    if (va.invMass > 0.0f) {
+      va.velocity += va.invMass * impulse;
+      va.angularVelocity += va.invInertiaTensor * glm::cross(rA, impulse);
+    }
+    if (vb.invMass > 0.0f) {
+      vb.velocity -= vb.invMass * impulse;
+      vb.angularVelocity -= vb.invInertiaTensor * glm::cross(rB, impulse);
+    }
+  }
+
+  // Remaining penetration: how far the one-sided constraint is below zero
+  float residual(std::span<const physics::Vertex> vertices) const override {
+    if (isStaticCollision) {
+      if (indexA >= vertices.size()) return 0.0f;
+      return std::max(0.0f, -glm::dot(vertices[indexA].position - contactPoint, contactNormal));
+    }
+    if (indexA >= vertices.size() || indexB >= vertices.size()) return 0.0f;
+    return std::max(0.0f, -separation(vertices[indexA], vertices[indexB]));
+  }
+
   uint32_t indexA = 0;
   uint32_t indexB = 0;
   glm::vec3 contactPoint = glm::vec3(0.0f);
   glm::vec3 contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
   float penetrationDepth = 0.0f;
+  float restDistance = 0.0f;
+  // Body-frame lever arms from each center to the contact point
+  glm::vec3 armA = glm::vec3(0.0f);
+  glm::vec3 armB = glm::vec3(0.0f);
   bool isStaticCollision = false;
 
 private:
-  // Dynamic collision, vertex to vertex
-  void solveDynamic(std::vector<physics::Vertex>& vertices, float deltatime) {
+  // Inverse mass a body shows to a push along the normal at arm r:
+  // m^-1 + (r x n) . I^-1 (r x n). Bodies that cannot move show none.
+  float generalizedInvMass(const physics::Vertex& v, const glm::vec3& r) const {
+    if (v.invMass <= 0.0f) return 0.0f;
+    const glm::vec3 rn = glm::cross(r, contactNormal);
+    return v.invMass + glm::dot(rn, v.invInertiaTensor * rn);
+  }
+
+  // Separation of the two attached points along the normal, less restDistance
+  float separation(const physics::Vertex& va, const physics::Vertex& vb) const {
+    const glm::vec3 pointA = va.position + va.orientation * armA;
+    const glm::vec3 pointB = vb.position + vb.orientation * armB;
+    return glm::dot(pointB - pointA, contactNormal) - restDistance;
+  }
+
+  // Dynamic collision between two bodies, pushed apart at the contact point
+  void solveDynamic(std::span<physics::Vertex> vertices, float deltatime) {
     if (indexA >= vertices.size() || indexB >= vertices.size()) return;
 
     physics::Vertex& va = vertices[indexA];
     physics::Vertex& vb = vertices[indexB];
 
-    const float w1 = va.invMass;
-    const float w2 = vb.invMass;
+    const glm::vec3 rA = va.orientation * armA;
+    const glm::vec3 rB = vb.orientation * armB;
+    const float w1 = generalizedInvMass(va, rA);
+    const float w2 = generalizedInvMass(vb, rB);
     if (w1 + w2 <= 1e-8f) return;
 
-    const float C = glm::dot(va.position - vb.position, contactNormal) - penetrationDepth;
+    const float C = separation(va, vb);
 
     if (C >= -1e-8f) return;
 
@@ -60,23 +138,26 @@ private:
     const float denom = w1 + w2 + alphaTilde;
     const float deltaLambda = (-C - alphaTilde * lambda) / denom;
 
-    const glm::vec3 deltaP_a = (w1 * deltaLambda) * contactNormal;
-    const glm::vec3 deltaP_b = (w2 * deltaLambda) * contactNormal;
+    const glm::vec3 impulse = deltaLambda * contactNormal;
 
-    va.position += deltaP_a;
-    vb.position -= deltaP_b;
-
-    // Orientation corrections
-    const glm::vec3 dOmega_a = va.invInertiaTensor * glm::cross(contactNormal, deltaP_a);
-    const glm::vec3 dOmega_b = vb.invInertiaTensor * glm::cross(contactNormal, deltaP_b);
-    va.orientation = glm::normalize(va.orientation + 0.5f * glm::quat(0.0f, dOmega_a) * va.orientation);
-    vb.orientation = glm::normalize(vb.orientation - 0.5f * glm::quat(0.0f, dOmega_b) * vb.orientation);
+    // Only touch bodies that can move: static bodies may be shared between
+    // islands that are solved concurrently
+    if (va.invMass > 0.0f) {
+      va.position -= va.invMass * impulse;
+      const glm::vec3 dOmega_a = va.invInertiaTensor * glm::cross(rA, -impulse);
+      va.orientation = glm::normalize(va.orientation + 0.5f * glm::quat(0.0f, dOmega_a) * va.orientation);
+    }
+    if (vb.invMass > 0.0f) {
+      vb.position += vb.invMass * impulse;
+      const glm::vec3 dOmega_b = vb.invInertiaTensor * glm::cross(rB, impulse);
+      vb.orientation = glm::normalize(vb.orientation + 0.5f * glm::quat(0.0f, dOmega_b) * vb.orientation);
+    }
 
     lambda += deltaLambda;
   }
 
   // Static collision, a single vertex against a fixed surface point
-  void solveStatic(std::vector<physics::Vertex>& vertices, float deltatime) {
+  void solveStatic(std::span<physics::Vertex> vertices, float deltatime) {
     if (indexA >= vertices.size()) return;
 
     physics::Vertex& va = vertices[indexA];
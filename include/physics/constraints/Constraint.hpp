@@ -2,7 +2,7 @@
 
 #include <physics/Vertex.hpp>
 
-#include <vector>
+#include <span>
 
 namespace physics {
 
@@ -10,7 +10,9 @@ struct Constraint {
   Constraint() = default;
   explicit Constraint(float comp) : compliance(comp) {}
   virtual ~Constraint() = default;
-  virtual void solve(std::vector<physics::Vertex>& vertices, float deltatime) = 0;
+  virtual void solve(std::span<physics::Vertex> vertices, float deltatime) = 0;
+  // Remaining violation at the current positions, reported by the profiler
+  virtual float residual(std::span<const physics::Vertex>) const { return 0.0f; }
   void resetLambda() { lambda = 0.0f; }
   float compliance = 0.0f;
 
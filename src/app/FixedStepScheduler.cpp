@@ -0,0 +1,51 @@
+#include "app/FixedStepScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sauce {
+
+FixedStepScheduler::FixedStepScheduler(double tickrate, int maxStepsPerFrame, PhysicsCatchUp catchUp)
+    : stepSeconds(1.0 / 60.0), maxStepsPerFrame(std::max(1, maxStepsPerFrame)), catchUp(catchUp) {
+  setTickrate(tickrate);
+}
+
+int FixedStepScheduler::advance(double frameSeconds) {
+  if (std::isfinite(frameSeconds) && frameSeconds > 0.0) {
+    accumulator += frameSeconds;
+  }
+
+  // The epsilon keeps frame times that sum to whole steps from rounding down
+  const int due = static_cast<int>(std::floor(accumulator / stepSeconds + 1e-6));
+  const int steps = std::min(due, maxStepsPerFrame);
+  accumulator = std::max(0.0, accumulator - steps * stepSeconds);
+
+  // Whatever is still owed beyond this frame's steps
+  if (catchUp == PhysicsCatchUp::Drop) {
+    accumulator = std::min(accumulator, stepSeconds * 0.999999);
+  } else {
+    accumulator = std::min(accumulator, stepSeconds * maxBacklogSteps);
+  }
+  return steps;
+}
+
+float FixedStepScheduler::getInterpolationAlpha() const {
+  return static_cast<float>(std::min(1.0, accumulator / stepSeconds));
+}
+
+void FixedStepScheduler::setTickrate(double tickrate) {
+  if (std::isfinite(tickrate) && tickrate > 0.0) {
+    stepSeconds = 1.0 / tickrate;
+  }
+  accumulator = std::min(accumulator, stepSeconds);
+}
+
+void FixedStepScheduler::setMaxStepsPerFrame(int steps) {
+  maxStepsPerFrame = std::max(1, steps);
+}
+
+void FixedStepScheduler::setMaxBacklogSteps(int steps) {
+  maxBacklogSteps = std::max(1, steps);
+}
+
+} // namespace sauce
@@ -13,7 +13,6 @@
 #include <limits>
 
 #include <physics/XPBD.hpp>
-#include <physics/constraints/Constraint.hpp>
 
 namespace sauce {
 
@@ -67,6 +66,33 @@ SceneBounds computeSceneBounds(const Scene& scene) {
   return bounds;
 }
 
+// Radius around the body's position that holds its collider, for the
+// simulation LOD's screen size; bodies without one count as a unit sphere
+float bodyBoundingRadius(const RigidBodyComponent& rigidBody) {
+  const auto& collider = rigidBody.getCollider();
+  if (!collider) {
+    return 1.0f;
+  }
+  float radius = 1.0f;
+  switch (collider->shape) {
+    case modeling::ColliderInfo::Shape::Sphere: radius = collider->radius; break;
+    case modeling::ColliderInfo::Shape::Capsule: radius = collider->radius + collider->halfHeight; break;
+    case modeling::ColliderInfo::Shape::Box: radius = glm::length(collider->halfExtents); break;
+    default: break;
+  }
+  return radius + glm::length(collider->offset);
+}
+
+// Simulation LOD keys: an entity's rigid body is component 0 and its cloths
+// follow in the order they were added
+SimulationKey rigidBodyKey(EntityHandle entity) {
+  return { entity, 0 };
+}
+
+SimulationKey clothKey(EntityHandle entity, size_t cloth) {
+  return { entity, static_cast<uint32_t>(cloth + 1) };
+}
+
 } // namespace
 
 SauceEngineApp::SauceEngineApp() {
@@ -138,6 +164,7 @@ void SauceEngineApp::initVulkan() {
     pRenderer = std::make_unique<sauce::Renderer>(rendererCreateInfo);
 
     pSolver = std::make_unique<physics::XPBDSolver>();
+    pSolver->profiler = &physicsProfiler;
 
     // Initialize ImGui
     sauce::ImGuiRendererCreateInfo imguiCreateInfo{
@@ -158,7 +185,7 @@ void SauceEngineApp::initVulkan() {
 
     // Add default UI components
     pImGuiComponentManager->addComponent(std::make_unique<sauce::ui::HelloWorldWindow>());
-    pImGuiComponentManager->addComponent(std::make_unique<sauce::ui::DebugStatsWindow>());
+    pImGuiComponentManager->addComponent(std::make_unique<sauce::ui::DebugStatsWindow>(&physicsProfiler));
   }
 
 void SauceEngineApp::initWindow() {
@@ -243,6 +270,8 @@ void SauceEngineApp::applyClothImpulse() {
     const Camera& camera = pScene->getCameraRO();
     const glm::vec3 impulseDirection = glm::normalize(camera.getFront());
     constexpr float kImpulseStrength = 2.0f;
+    // The predicted positions run one physics step ahead
+    const float physicsDt = static_cast<float>(physicsScheduler.getStepSeconds());
 
     for (auto& entity : pScene->getEntitiesMut()) {
       if (!entity.getActive()) {
@@ -293,7 +322,7 @@ void SauceEngineApp::applyClothImpulse() {
               impulseDirection * (kImpulseStrength * falloff);
 
           particle.velocity += deltaVelocity;
-          particle.predictedPosition += deltaVelocity * (1.0f / 128.0f);
+          particle.predictedPosition += deltaVelocity * physicsDt;
         }
       }
     }
@@ -304,29 +333,92 @@ void SauceEngineApp::mainLoop() {
       auto currentFrameTime = std::chrono::steady_clock::now();
       deltaFrame = std::chrono::duration<float>(currentFrameTime - lastFrameTime).count();
       lastFrameTime = currentFrameTime;
-      deltaUpdate += deltaFrame;
 
       glfwPollEvents();
       processInput(deltaFrame);
-      syncRigidBodiesToTransforms();
 
       pImGuiRenderer->newFrame();
       buildExampleUI();
 
-      // Run XPBD only if 1/TICKRATE seconds passed since last physics run 
+      // Run as many fixed physics steps as the scheduler owes this frame
 
       auto rigidBodies = std::vector<RigidBodyComponent>();
-      auto constraints = std::vector<std::unique_ptr<physics::Constraint>>();
+      auto rigidBodySources = std::vector<RigidBodyComponent*>();
+      auto rigidBodyKeys = std::vector<SimulationKey>();
 
-      for (auto& entity: pScene->getEntities()) {
+      for (auto& entity: pScene->getEntitiesMut()) {
         auto rigidBody = entity.getComponent<RigidBodyComponent>();
-        if (rigidBody) rigidBodies.push_back(*rigidBody);
+        if (rigidBody) {
+          rigidBodies.push_back(*rigidBody);
+          rigidBodySources.push_back(rigidBody);
+          rigidBodyKeys.push_back(rigidBodyKey(pScene->getHandle(entity)));
+        }
+      }
+
+      // Cloth collides with the distance fields of static meshes, placed by
+      // the rigid body created alongside each mesh
+      pSolver->distanceFields.clear();
+      for (auto& entity : pScene->getEntitiesMut()) {
+        if (!entity.getActive()) {
+          continue;
+        }
+        const auto meshRenderers = entity.getComponents<MeshRendererComponent>();
+        const auto bodies = entity.getComponents<RigidBodyComponent>();
+        for (size_t i = 0; i < meshRenderers.size() && i < bodies.size(); ++i) {
+          if (meshRenderers[i]->getDistanceField()) {
+            pSolver->distanceFields.push_back(
+                { meshRenderers[i]->getDistanceField(), { bodies[i]->getPosition(), bodies[i]->getOrientation() } });
+          }
+        }
+      }
+
+      const float physicsDt = static_cast<float>(physicsScheduler.getStepSeconds());
+      const int physicsSteps = physicsScheduler.advance(deltaFrame);
+
+      // Every dynamic body and cloth gets a tick divisor and substep count for
+      // this frame's ticks from its distance, screen size and the physics budget
+      constexpr size_t kUnscheduled = std::numeric_limits<size_t>::max();
+      const auto& camera = pScene->getCameraRO();
+      simulationLOD.beginFrame({ camera.getPos(), camera.getFOV(), camera.getScreenHeight() }, physicsTick);
+      // A rigid step's work per body, in the cloth's particle-substep units
+      const float rigidBodyCost = static_cast<float>(pSolver->solverIterations * std::max(1, pSolver->substeps));
+      std::vector<size_t> bodySlots(rigidBodies.size(), kUnscheduled);
+      for (size_t i = 0; i < rigidBodies.size(); ++i) {
+        if (rigidBodies[i].getInvMass() > 0.0f) {
+          bodySlots[i] = simulationLOD.add(rigidBodyKeys[i], rigidBodies[i].getPosition(),
+                                           bodyBoundingRadius(rigidBodies[i]), rigidBodyCost);
+        }
+      }
+      std::vector<std::pair<ClothComponent*, size_t>> clothSlots;
+      for (auto& entity : pScene->getEntitiesMut()) {
+        if (!entity.getActive()) {
+          continue;
+        }
+        const EntityHandle handle = pScene->getHandle(entity);
+        const auto cloths = entity.getComponents<ClothComponent>();
+        for (size_t c = 0; c < cloths.size(); ++c) {
+          ClothComponent* clothComp = cloths[c];
+          const physics::ClothData* cloth = clothComp->getClothData();
+          if (!cloth || cloth->empty()) {
+            clothSlots.emplace_back(clothComp, kUnscheduled);
+            continue;
+          }
+          glm::vec3 minPos = cloth->particles.front().position;
+          glm::vec3 maxPos = minPos;
+          for (const auto& particle : cloth->particles) {
+            minPos = glm::min(minPos, particle.position);
+            maxPos = glm::max(maxPos, particle.position);
+          }
+          const int substeps = std::max(1, clothComp->getSettings().solverSubsteps);
+          clothSlots.emplace_back(clothComp, simulationLOD.add(
+              clothKey(handle, c), 0.5f * (minPos + maxPos), 0.5f * glm::length(maxPos - minPos),
+              static_cast<float>(cloth->particles.size() * substeps), substeps));
+        }
       }
+      simulationLOD.assign(physicsSteps);
 
-      constexpr float kPhysicsDt = 1.0f / 128.0f;
-      constexpr int kMaxPhysicsStepsPerFrame = 2;
-      constexpr float kMaxPhysicsAccumulation =
-          kPhysicsDt * static_cast<float>(kMaxPhysicsStepsPerFrame);
+      physicsProfiler.beginSample();
+      const auto physicsStart = std::chrono::steady_clock::now();
       auto& clothPhysicalDevice =
           const_cast<vk::raii::PhysicalDevice&>(*physicalDevice);
       auto& clothCommandPool =
@@ -334,42 +426,78 @@ void SauceEngineApp::mainLoop() {
       auto& clothQueue =
           const_cast<vk::raii::Queue&>(pRenderer->getQueue());
 
-      if (deltaUpdate > kMaxPhysicsAccumulation) {
-        deltaUpdate = kMaxPhysicsAccumulation;
-      }
+      // Bodies and cloth off their tick stay put; the ones due step over
+      // every tick since their last step
+      std::vector<float> bodyDeltaTimes(rigidBodies.size(), physicsDt);
+      for (int step = 0; step < physicsSteps; ++step) {
+        ++physicsTick;
+        for (size_t i = 0; i < rigidBodies.size(); ++i) {
+          if (bodySlots[i] != kUnscheduled) {
+            bodyDeltaTimes[i] = physicsDt * static_cast<float>(simulationLOD.beginStep(bodySlots[i], physicsTick));
+          }
+          if (bodyDeltaTimes[i] > 0.0f) {
+            rigidBodies[i].storePreviousPose();
+          }
+        }
+        pSolver->solvePositions(rigidBodies, physicsDt, bodyDeltaTimes);
 
-      int physicsStepsThisFrame = 0;
-      while (deltaUpdate >= kPhysicsDt &&
-             physicsStepsThisFrame < kMaxPhysicsStepsPerFrame) {
-        pSolver->solvePositions(rigidBodies, constraints, kPhysicsDt);
-        for (auto& entity : pScene->getEntitiesMut()) {
-          if (!entity.getActive()) {
+        // Cloth sweeps continuously against the mesh bodies that moved this tick
+        pSolver->clothObstacles.clear();
+        for (size_t i = 0; i < rigidBodies.size() && !clothSlots.empty(); ++i) {
+          if (bodySlots[i] == kUnscheduled || bodyDeltaTimes[i] <= 0.0f) {
             continue;
           }
+          auto* owner = rigidBodySources[i]->getOwner();
+          auto* meshRenderer = owner ? owner->getComponent<MeshRendererComponent>() : nullptr;
+          if (!meshRenderer || !meshRenderer->getMesh() || owner->hasComponent<ClothComponent>()) {
+            continue;
+          }
+          pSolver->clothObstacles.push_back({
+              meshRenderer->getMesh(),
+              { rigidBodies[i].getInterpolatedPosition(0.0f), rigidBodies[i].getInterpolatedOrientation(0.0f) },
+              { rigidBodies[i].getPosition(), rigidBodies[i].getOrientation() },
+          });
+        }
 
-          for (auto* clothComp : entity.getComponents<ClothComponent>()) {
-            clothComp->syncSimulationTransform();
-
-            physics::ClothData* cloth = clothComp->getClothData();
-            if (cloth && !cloth->empty()) {
-              pSolver->solveCloth(
-                *cloth,
-                clothComp->getSettings(),
-                kPhysicsDt);
-              clothComp->markRuntimeMeshDirty();
-            }
+        for (auto& [clothComp, slot] : clothSlots) {
+          clothComp->syncSimulationTransform();
+
+          physics::ClothData* cloth = clothComp->getClothData();
+          const int ticks = slot != kUnscheduled ? simulationLOD.beginStep(slot, physicsTick) : 0;
+          if (cloth && !cloth->empty() && ticks > 0) {
+            sauce::ClothSettings settings = clothComp->getSettings();
+            settings.solverSubsteps = simulationLOD.getLOD(slot).substeps;
+            clothComp->captureStepStart();
+            pSolver->solveCloth(
+              *cloth,
+              settings,
+              physicsDt * static_cast<float>(ticks));
+            clothComp->markRuntimeMeshDirty();
           }
         }
-        deltaUpdate -= kPhysicsDt;
-        ++physicsStepsThisFrame;
       }
+      simulationLOD.reportFrameCost(
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - physicsStart).count());
+
+      // The solver steps copies; publish the results (including sleep state) to the scene
+      for (size_t i = 0; i < rigidBodies.size(); ++i) {
+        rigidBodySources[i]->copyDynamicStateFrom(rigidBodies[i]);
+      }
+
+      // Render between the last two physics states so motion stays smooth when
+      // the tick rate is below the display rate
+      const float physicsAlpha = physicsScheduler.getInterpolationAlpha();
+      syncRigidBodiesToTransforms(physicsAlpha);
 
       for (auto& entity : pScene->getEntitiesMut()) {
         if (!entity.getActive()) {
           continue;
         }
 
-        for (auto* clothComp : entity.getComponents<ClothComponent>()) {
+        const EntityHandle handle = pScene->getHandle(entity);
+        const auto cloths = entity.getComponents<ClothComponent>();
+        for (size_t c = 0; c < cloths.size(); ++c) {
+          ClothComponent* clothComp = cloths[c];
           auto runtimeMesh = clothComp->getRuntimeMesh();
           if (!runtimeMesh) {
             continue;
@@ -398,15 +526,20 @@ void SauceEngineApp::mainLoop() {
                 material && material->getTexture(modeling::TextureType::Normal);
           }
 
-          if (clothComp->isRuntimeMeshDirty() &&
-              !clothComp->syncRuntimeMesh(regenerateTangents)) {
-            continue;
+          // The interpolated pose changes every frame, not only after a step
+          {
+            physics::ProfileScope normals(&physicsProfiler, physics::ProfileStage::NormalRegeneration);
+            const float clothAlpha = simulationLOD.getInterpolationAlpha(clothKey(handle, c), physicsTick, physicsAlpha);
+            if (!clothComp->syncRuntimeMesh(regenerateTangents, clothAlpha)) {
+              continue;
+            }
           }
 
           if (!runtimeMesh->isValid()) {
             continue;
           }
 
+          physics::ProfileScope upload(&physicsProfiler, physics::ProfileStage::GpuUpload);
           if (!runtimeMesh->hasGPUData()) {
             runtimeMesh->initVulkanResources(
               logicalDevice,
@@ -423,6 +556,8 @@ void SauceEngineApp::mainLoop() {
         }
       }
 
+      physicsProfiler.endSample();
+
       pRenderer->drawFrame(logicalDevice, *pScene, pImGuiRenderer.get());
     }
 
@@ -433,20 +568,15 @@ void SauceEngineApp::buildExampleUI() {
     pImGuiComponentManager->renderAll();
   }
 
-void SauceEngineApp::syncRigidBodiesToTransforms() {
+void SauceEngineApp::syncRigidBodiesToTransforms(float alpha) {
     if (!pScene) {
       return;
     }
 
-    for (auto& entity : pScene->getEntitiesMut()) {
-      auto* rigidBody = entity.getComponent<RigidBodyComponent>();
-      auto* transform = entity.getComponent<TransformComponent>();
-      if (!rigidBody || !transform) {
-        continue;
-      }
-
-      transform->setTranslation(rigidBody->getPosition());
-      transform->setRotation(rigidBody->getOrientation());
+    for (auto [entity, rigidBody, transform] : pScene->view<RigidBodyComponent, TransformComponent>()) {
+      const float bodyAlpha = simulationLOD.getInterpolationAlpha(rigidBodyKey(pScene->getHandle(entity)), physicsTick, alpha);
+      transform.setTranslation(rigidBody.getInterpolatedPosition(bodyAlpha));
+      transform.setRotation(rigidBody.getInterpolatedOrientation(bodyAlpha));
     }
   }
 
@@ -8,22 +8,144 @@
 #include "app/components/PointLightComponent.hpp"
 #include "app/components/SpotLightComponent.hpp"
 #include "app/components/DirectionalLightComponent.hpp"
+#include "physics/SignedDistanceField.hpp"
+#include "physics/TaskPool.hpp"
+#include <filesystem>
 #include <unordered_map>
+#include <unordered_set>
 #include <iostream>
 
 namespace sauce {
 
-void Scene::addEntity(sauce::Entity&& entity) {
+namespace {
+
+// Every distinct mesh referenced by node or its descendants, and the ones
+// that collide through their convex hull
+void collectMeshes(const modeling::ModelNode& node,
+                   std::unordered_set<const modeling::Mesh*>& seen,
+                   std::vector<const modeling::Mesh*>& meshes,
+                   std::unordered_set<const modeling::Mesh*>& convexMeshes) {
+    const bool convex = node.hasCollider() &&
+        node.getColliderInfo()->shape == modeling::ColliderInfo::Shape::ConvexHull;
+    for (const auto& pair : node.getMeshMaterialPairs()) {
+        if (pair.mesh && seen.insert(pair.mesh.get()).second) {
+            meshes.push_back(pair.mesh.get());
+        }
+        if (pair.mesh && convex) {
+            convexMeshes.insert(pair.mesh.get());
+        }
+    }
+    for (const auto& child : node.getChildren()) {
+        if (child) {
+            collectMeshes(*child, seen, meshes, convexMeshes);
+        }
+    }
+}
+
+// A float tag from the mesh's metadata, or fallback when missing or not a float
+float metadataFloat(const modeling::Mesh& mesh, const std::string& key, float fallback) {
+    if (!mesh.hasMetadata(key)) {
+        return fallback;
+    }
+    const float* value = std::get_if<float>(&mesh.getMetadata().at(key));
+    return value ? *value : fallback;
+}
+
+// Static meshes opt into a distance field for cloth contacts with an
+// "SDFCellSize" tag ("SDFBandWidth" defaults to three cells). Fields are
+// cached in an sdf_cache directory next to the model, so only the first
+// import of a mesh pays for the bake.
+std::shared_ptr<const physics::SignedDistanceField> bakeDistanceField(const modeling::Mesh& mesh,
+                                                                       const std::string& filePath) {
+    const float cellSize = metadataFloat(mesh, "SDFCellSize", 0.0f);
+    if (cellSize <= 0.0f) {
+        return nullptr;
+    }
+    const float bandWidth = metadataFloat(mesh, "SDFBandWidth", 3.0f * cellSize);
+    const auto cacheDirectory = std::filesystem::path(filePath).parent_path() / "sdf_cache";
+    auto field = std::make_shared<physics::SignedDistanceField>(
+        physics::SignedDistanceField::loadOrBake(mesh, cellSize, bandWidth, cacheDirectory));
+    if (field->empty()) {
+        return nullptr;
+    }
+    return field;
+}
+
+} // namespace
+
+EntityHandle Scene::addEntity(sauce::Entity&& entity) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(entitySlots.size());
+        entitySlots.emplace_back();
+    }
+
+    const auto index = static_cast<uint32_t>(entities.size());
     entities.push_back(std::move(entity));
+    entitySlotOf.push_back(slot);
+    entitySlots[slot].entity = index;
+    entities.back().bindScene(&componentRegistry, &nameIndex, index);
+    return { slot, entitySlots[slot].generation };
 }
 
-sauce::Entity* Scene::getEntity(const std::string& name) {
-    for (auto& entity : entities) {
-        if (entity.get_name() == name) {
-            return &entity;
-        }
+bool Scene::destroyEntity(EntityHandle handle) {
+    if (!isValid(handle)) {
+        return false;
+    }
+    eraseEntityAt(entitySlots[handle.index].entity);
+    return true;
+}
+
+void Scene::removeEntity(size_t index) {
+    if (index < entities.size()) {
+        eraseEntityAt(index);
+    }
+}
+
+void Scene::eraseEntityAt(size_t index) {
+    const uint32_t slot = entitySlotOf[index];
+    entities[index].unbindScene();
+
+    const size_t last = entities.size() - 1;
+    if (index != last) {
+        // The last entity takes the freed place; only it is registered again
+        entities[last].unbindScene();
+        entities[index] = std::move(entities[last]);
+        entitySlotOf[index] = entitySlotOf[last];
+        entitySlots[entitySlotOf[index]].entity = static_cast<uint32_t>(index);
+        entities[index].bindScene(&componentRegistry, &nameIndex, static_cast<uint32_t>(index));
     }
-    return nullptr;
+    entities.pop_back();
+    entitySlotOf.pop_back();
+
+    ++entitySlots[slot].generation;
+    entitySlots[slot].entity = kFreeSlot;
+    freeSlots.push_back(slot);
+}
+
+void Scene::clearEntities() {
+    for (uint32_t slot : entitySlotOf) {
+        ++entitySlots[slot].generation;
+        entitySlots[slot].entity = kFreeSlot;
+        freeSlots.push_back(slot);
+    }
+    entities.clear();
+    entitySlotOf.clear();
+    componentRegistry.clear();
+    nameIndex.clear();
+}
+
+sauce::Entity* Scene::getEntity(std::string_view name) {
+    const uint32_t index = nameIndex.find(name);
+    return index == EntityNameIndex::kNotFound ? nullptr : &entities[index];
+}
+
+const sauce::Entity* Scene::getEntity(std::string_view name) const {
+    const uint32_t index = nameIndex.find(name);
+    return index == EntityNameIndex::kNotFound ? nullptr : &entities[index];
 }
 
 bool Scene::saveToFile(const std::string& filePath) const {
@@ -57,11 +179,11 @@ bool Scene::loadFromFile(const std::string& filePath) {
     }
 
     // Clear existing entities
-    entities.clear();
+    clearEntities();
 
     // Load entities from model
-    std::unordered_map<ModelNode*, Entity*> nodeToEntityMap;
-    loadGLTFNodeHierarchy(model->getRootNode(), nullptr, nodeToEntityMap, filePath);
+    std::unordered_map<ModelNode*, EntityHandle> nodeToEntityMap;
+    loadGLTFNodeHierarchy(model->getRootNode(), {}, nodeToEntityMap, filePath);
 
     currentFilePath = filePath;
     return true;
@@ -84,8 +206,8 @@ void Scene::loadGLTFModel(const std::string& filePath, bool preserveHierarchy) {
 
     if (preserveHierarchy) {
         // Create entity tree preserving hierarchy
-        std::unordered_map<ModelNode*, Entity*> nodeToEntityMap;
-        loadGLTFNodeHierarchy(model->getRootNode(), nullptr, nodeToEntityMap, filePath);
+        std::unordered_map<ModelNode*, EntityHandle> nodeToEntityMap;
+        loadGLTFNodeHierarchy(model->getRootNode(), {}, nodeToEntityMap, filePath);
     } else {
         // Flatten all meshes into individual entities
         loadGLTFFlattened(model, filePath);
@@ -93,8 +215,8 @@ void Scene::loadGLTFModel(const std::string& filePath, bool preserveHierarchy) {
 }
 
 void Scene::loadGLTFNodeHierarchy(std::shared_ptr<modeling::ModelNode> node,
-                                   Entity* parentEntity,
-                                   std::unordered_map<modeling::ModelNode*, Entity*>& nodeToEntityMap,
+                                   EntityHandle parentEntity,
+                                   std::unordered_map<modeling::ModelNode*, EntityHandle>& nodeToEntityMap,
                                    const std::string& filePath) {
     if (!node) {
         return;
@@ -102,8 +224,22 @@ void Scene::loadGLTFNodeHierarchy(std::shared_ptr<modeling::ModelNode> node,
 
     // Skip the artificial root node
     if (node->getName() == "__root__") {
+        // Integrate every mesh's mass properties (and hull, for convex
+        // colliders) up front, one mesh per task; the rigid bodies created
+        // below read the cached results
+        std::unordered_set<const modeling::Mesh*> seen;
+        std::vector<const modeling::Mesh*> meshes;
+        std::unordered_set<const modeling::Mesh*> convexMeshes;
+        collectMeshes(*node, seen, meshes, convexMeshes);
+        physics::TaskPool::shared().parallelFor(meshes.size(), [&](size_t i) {
+            meshes[i]->getMassProperties();
+            if (convexMeshes.contains(meshes[i])) {
+                meshes[i]->getConvexHull();
+            }
+        });
+
         for (const auto& child : node->getChildren()) {
-            loadGLTFNodeHierarchy(child, nullptr, nodeToEntityMap, filePath);
+            loadGLTFNodeHierarchy(child, {}, nodeToEntityMap, filePath);
         }
         return;
     }
@@ -127,9 +263,9 @@ void Scene::loadGLTFNodeHierarchy(std::shared_ptr<modeling::ModelNode> node,
 		  nodeTransform.getRotation(),
 		  glm::vec3(0.f,0.f,0.f)
 		  );
-		// calculate center of mass
-		glm::vec3 com=RigidBodyComponent::meshCenterOfMass(pair.mesh);
-		entity.getComponents<RigidBodyComponent>().back()->setCenterOfMass(com);
+		// center of mass, mass and inertia come from the mesh's cached mass properties
+		auto* rigidBody=entity.getComponents<RigidBodyComponent>().back();
+		rigidBody->setCenterOfMass(RigidBodyComponent::meshCenterOfMass(pair.mesh));
 		// get inverse mass from tags, or compute one
 		float invmass=1.f;
 		if (pair.mesh->hasMetadata("InvMass")) {
@@ -142,7 +278,32 @@ void Scene::loadGLTFNodeHierarchy(std::shared_ptr<modeling::ModelNode> node,
 		}
 		else
 			invmass=RigidBodyComponent::meshInvMass(pair.mesh);
-		entity.getComponents<RigidBodyComponent>().back()->setInvMass(invmass);
+		rigidBody->setInvMass(invmass);
+		rigidBody->setInvInertiaTensor(RigidBodyComponent::meshInvInertiaTensor(pair.mesh, invmass));
+		if (invmass <= 0.f)
+			entity.getComponents<MeshRendererComponent>().back()->setDistanceField(bakeDistanceField(*pair.mesh, filePath));
+    }
+
+    // The node's collider shapes every body of the node. A node with a
+    // collider but no mesh gets a body of its own; with no mesh to integrate
+    // it takes the volumeless fallback, an inverse mass of 1 and an identity
+    // inverse inertia, except for planes, which are always static.
+    if (node->hasCollider()) {
+        const auto& collider = *node->getColliderInfo();
+        if (!entity.hasComponent<RigidBodyComponent>()) {
+            const auto& nodeTransform = node->getTransform();
+            const bool plane = collider.shape == modeling::ColliderInfo::Shape::Plane;
+            entity.addComponent<RigidBodyComponent>(
+                nodeTransform.getTranslation(),
+                glm::vec3(0.0f),
+                nodeTransform.getRotation(),
+                glm::vec3(0.0f),
+                glm::vec3(0.0f),
+                plane ? 0.0f : 1.0f);
+        }
+        for (auto* rigidBody : entity.getComponents<RigidBodyComponent>()) {
+            rigidBody->setCollider(collider);
+        }
     }
 
     if (node->hasCloth()) {
@@ -179,16 +340,16 @@ void Scene::loadGLTFNodeHierarchy(std::shared_ptr<modeling::ModelNode> node,
         }
     }
 
-    // Add entity to scene
-    entities.push_back(std::move(entity));
-    Entity* entityPtr = &entities.back();
+    // Add entity to scene; children below may grow entities, so track the
+    // node by handle rather than by pointer
+    const EntityHandle handle = addEntity(std::move(entity));
 
     // Track node -> entity mapping
-    nodeToEntityMap[node.get()] = entityPtr;
+    nodeToEntityMap[node.get()] = handle;
 
     // Process children
     for (const auto& child : node->getChildren()) {
-        loadGLTFNodeHierarchy(child, entityPtr, nodeToEntityMap, filePath);
+        loadGLTFNodeHierarchy(child, handle, nodeToEntityMap, filePath);
     }
 }
 
@@ -218,17 +379,17 @@ void Scene::loadGLTFFlattened(std::shared_ptr<modeling::Model> model, const std:
         entity.addComponent<MeshRendererComponent>(allMeshes[i], material);
         entity.getComponents<MeshRendererComponent>().back()->setModelPath(filePath);
 
-        entities.push_back(std::move(entity));
+        addEntity(std::move(entity));
     }
 }
 
 const std::vector<GPULight>& Scene::collectGPULights() {
     gpuLightBuffer.clear();
-    for (auto& entity : entities) {
+    for (auto [entity, light] : view<LightComponent>()) {
         if (!entity.getActive()) continue;
 
-        auto* lc = entity.getComponent<LightComponent>();
-        if (!lc || !lc->getActive()) continue;
+        auto* lc = &light;
+        if (!lc->getActive()) continue;
 
         glm::vec3 worldPos{0.0f};
         glm::vec3 direction{0.0f, 0.0f, -1.0f};
@@ -0,0 +1,168 @@
+#include "app/SimulationLODScheduler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace sauce {
+
+SimulationLODScheduler::SimulationLODScheduler(SimulationLODSettings settings) {
+  setSettings(settings);
+}
+
+void SimulationLODScheduler::setSettings(const SimulationLODSettings& newSettings) {
+  settings = newSettings;
+  settings.maxTickDivisor = static_cast<int>(std::bit_floor(static_cast<unsigned>(std::max(1, settings.maxTickDivisor))));
+  settings.minSubsteps = std::max(1, settings.minSubsteps);
+}
+
+void SimulationLODScheduler::beginFrame(const View& newView, uint64_t tick) {
+  view = newView;
+  frameTick = tick;
+  ++frame;
+  objects.clear();
+}
+
+size_t SimulationLODScheduler::add(const SimulationKey& key, const glm::vec3& center, float radius, float cost, int substeps) {
+  auto [it, inserted] = histories.try_emplace(key);
+  History& history = it->second;
+  if (inserted) {
+    history.lastTick = frameTick;
+    history.nextTick = frameTick + 1;
+  }
+  history.lastFrame = frame;
+
+  Object object;
+  object.history = &history;
+  object.distance = glm::length(center - view.position);
+  object.cost = std::max(0.0f, cost);
+  object.fullSubsteps = std::max(1, substeps);
+
+  // Projected height in pixels of the bounding sphere; a camera inside it
+  // sees the object at any size
+  const float tanHalfFov = std::tan(0.5f * glm::radians(view.fovDegrees));
+  object.pixels = object.distance > radius && tanHalfFov > 0.0f
+                      ? view.viewportHeight * radius / (object.distance * tanHalfFov)
+                      : std::numeric_limits<float>::infinity();
+
+  objects.push_back(object);
+  return objects.size() - 1;
+}
+
+double SimulationLODScheduler::stepCost(const Object& object) const {
+  return object.cost * static_cast<double>(object.lod.substeps) / static_cast<double>(object.fullSubsteps);
+}
+
+double SimulationLODScheduler::predictFrameMs(int ticksThisFrame) const {
+  double costPerTick = 0.0;
+  for (const auto& object : objects) {
+    costPerTick += stepCost(object) / object.lod.tickDivisor;
+  }
+  return msPerCost * ticksThisFrame * costPerTick;
+}
+
+void SimulationLODScheduler::assign(int ticksThisFrame) {
+  // Objects that were not added this frame start over when they come back
+  std::erase_if(histories, [this](const auto& entry) { return entry.second.lastFrame != frame; });
+
+  const int maxDivisor = settings.maxTickDivisor;
+  for (size_t slot = 0; slot < objects.size(); ++slot) {
+    Object& object = objects[slot];
+    int divisor = 1;
+    if (object.distance >= settings.farDistance) {
+      divisor = maxDivisor;
+    } else if (object.pixels < settings.fullRatePixels) {
+      const float ratio = settings.fullRatePixels / std::max(object.pixels, 1e-6f);
+      divisor = ratio >= static_cast<float>(maxDivisor)
+                    ? maxDivisor
+                    : static_cast<int>(std::bit_ceil(static_cast<unsigned>(std::ceil(ratio))));
+    }
+    object.lod = { std::min(divisor, maxDivisor), object.fullSubsteps };
+  }
+
+  // Over budget, demote the least visible objects first, one notch per
+  // round: halve the substeps down to minSubsteps, then double the divisor
+  predictedFrameMs = predictFrameMs(std::max(0, ticksThisFrame));
+  if (settings.frameBudgetMs > 0.0f && predictedFrameMs > settings.frameBudgetMs) {
+    demotionOrder.resize(objects.size());
+    for (size_t slot = 0; slot < objects.size(); ++slot) {
+      demotionOrder[slot] = slot;
+    }
+    std::stable_sort(demotionOrder.begin(), demotionOrder.end(), [this](size_t a, size_t b) {
+      return objects[a].pixels < objects[b].pixels;
+    });
+
+    const double msPerTickCost = msPerCost * std::max(0, ticksThisFrame);
+    bool demoted = true;
+    while (demoted && predictedFrameMs > settings.frameBudgetMs) {
+      demoted = false;
+      for (size_t slot : demotionOrder) {
+        Object& object = objects[slot];
+        const double before = stepCost(object) / object.lod.tickDivisor;
+        if (object.lod.substeps > settings.minSubsteps) {
+          object.lod.substeps = std::max(settings.minSubsteps, object.lod.substeps / 2);
+        } else if (object.lod.tickDivisor < maxDivisor) {
+          object.lod.tickDivisor *= 2;
+        } else {
+          continue;
+        }
+        demoted = true;
+        predictedFrameMs -= msPerTickCost * (before - stepCost(object) / object.lod.tickDivisor);
+        if (predictedFrameMs <= settings.frameBudgetMs) {
+          break;
+        }
+      }
+    }
+  }
+
+  // A new object's first step is spread over its divisor, so objects added
+  // together do not all step on the same tick; a faster rate takes effect on
+  // the next tick it allows
+  for (size_t slot = 0; slot < objects.size(); ++slot) {
+    History& history = *objects[slot].history;
+    const uint64_t divisor = static_cast<uint64_t>(objects[slot].lod.tickDivisor);
+    if (history.span == 0 && history.nextTick == frameTick + 1) {
+      history.nextTick += slot % divisor;
+    }
+    history.nextTick = std::min(history.nextTick, history.lastTick + divisor);
+  }
+}
+
+int SimulationLODScheduler::beginStep(size_t slot, uint64_t tick) {
+  const Object& object = objects[slot];
+  History& history = *object.history;
+  if (tick < history.nextTick || tick <= history.lastTick) {
+    return 0;
+  }
+
+  history.span = tick - history.lastTick;
+  history.lastTick = tick;
+  history.nextTick = tick + static_cast<uint64_t>(object.lod.tickDivisor);
+  executedCost += stepCost(object);
+  return static_cast<int>(history.span);
+}
+
+float SimulationLODScheduler::getInterpolationAlpha(const SimulationKey& key, uint64_t tick, float alpha) const {
+  const auto it = histories.find(key);
+  if (it == histories.end()) {
+    return alpha;
+  }
+  const History& history = it->second;
+  if (history.span == 0 || tick < history.lastTick) {
+    return 1.0f;
+  }
+  const float sinceStep = static_cast<float>(tick - history.lastTick) + alpha;
+  return std::min(1.0f, sinceStep / static_cast<float>(history.span));
+}
+
+void SimulationLODScheduler::reportFrameCost(double milliseconds) {
+  if (executedCost > 0.0 && std::isfinite(milliseconds) && milliseconds >= 0.0) {
+    const double sample = milliseconds / executedCost;
+    // Smoothed so one slow frame does not swing every object's rate
+    msPerCost = msPerCost > 0.0 ? 0.9 * msPerCost + 0.1 * sample : sample;
+  }
+  executedCost = 0.0;
+}
+
+} // namespace sauce
@@ -149,6 +149,7 @@ bool ClothComponent::rebuildFromMesh(
   sourceMesh = std::move(mesh);
   runtimeMesh.reset();
   clothData.reset();
+  stepStartPositions.clear();
   settings = newSettings;
 
   if (!sourceMesh) {
@@ -209,6 +210,7 @@ bool ClothComponent::resetSimulation() {
 void ClothComponent::clear() {
   runtimeMesh.reset();
   clothData.reset();
+  stepStartPositions.clear();
   lastSimulationTransform = {};
   runtimeMeshDirty = false;
   lastBuildError.clear();
@@ -282,7 +284,19 @@ void ClothComponent::syncSimulationTransform() {
   runtimeMeshDirty = true;
 }
 
-bool ClothComponent::syncRuntimeMesh(bool regenerateTangents) {
+void ClothComponent::captureStepStart() {
+  if (!clothData.has_value()) {
+    stepStartPositions.clear();
+    return;
+  }
+
+  stepStartPositions.resize(clothData->particles.size());
+  for (size_t i = 0; i < clothData->particles.size(); ++i) {
+    stepStartPositions[i] = clothData->particles[i].position;
+  }
+}
+
+bool ClothComponent::syncRuntimeMesh(bool regenerateTangents, float alpha) {
   if (!clothData.has_value() || !runtimeMesh) {
     lastBuildError = "No cloth data or runtime mesh available.";
     return false;
@@ -295,8 +309,11 @@ bool ClothComponent::syncRuntimeMesh(bool regenerateTangents) {
   }
 
   const modeling::Transform currentTransform = getSimulationTransform(getOwner());
+  const bool interpolate = alpha < 1.0f && stepStartPositions.size() == clothData->particles.size();
   for (size_t i = 0; i < clothData->particles.size(); ++i) {
-    vertices[i].position = toLocalPosition(currentTransform, clothData->particles[i].position);
+    const glm::vec3& end = clothData->particles[i].position;
+    const glm::vec3 position = interpolate ? glm::mix(stepStartPositions[i], end, alpha) : end;
+    vertices[i].position = toLocalPosition(currentTransform, position);
   }
 
   runtimeMesh->generateNormals();
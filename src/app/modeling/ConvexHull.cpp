@@ -0,0 +1,240 @@
+#include "app/modeling/ConvexHull.hpp"
+#include "app/modeling/Mesh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace sauce::modeling {
+
+namespace {
+
+struct Face {
+    std::array<uint32_t, 3> v;
+    glm::vec3 normal;
+    float offset;
+    // Points above this face that no hull vertex has absorbed yet
+    std::vector<uint32_t> outside;
+    bool alive = true;
+
+    float distance(const glm::vec3& p) const { return glm::dot(normal, p) - offset; }
+};
+
+Face makeFace(std::span<const glm::vec3> points, uint32_t a, uint32_t b, uint32_t c) {
+    Face face;
+    face.v = { a, b, c };
+    face.normal = glm::normalize(glm::cross(points[b] - points[a], points[c] - points[a]));
+    face.offset = glm::dot(face.normal, points[a]);
+    return face;
+}
+
+// Gives each candidate to the first face it lies above
+void assignOutside(std::span<const glm::vec3> points, std::span<const uint32_t> candidates,
+                   std::vector<Face>& faces, size_t firstFace, float epsilon) {
+    for (uint32_t p : candidates) {
+        for (size_t f = firstFace; f < faces.size(); ++f) {
+            if (faces[f].alive && faces[f].distance(points[p]) > epsilon) {
+                faces[f].outside.push_back(p);
+                break;
+            }
+        }
+    }
+}
+
+} // namespace
+
+glm::vec3 ConvexHull::support(const glm::vec3& direction) const {
+    glm::vec3 best(0.0f);
+    float bestDot = -std::numeric_limits<float>::max();
+    for (const auto& v : vertices) {
+        const float d = glm::dot(v, direction);
+        if (d > bestDot) {
+            bestDot = d;
+            best = v;
+        }
+    }
+    return best;
+}
+
+float ConvexHull::boundingRadius() const {
+    float radiusSq = 0.0f;
+    for (const auto& v : vertices) {
+        radiusSq = std::max(radiusSq, glm::dot(v, v));
+    }
+    return std::sqrt(radiusSq);
+}
+
+ConvexHull ConvexHull::fromPoints(std::span<const glm::vec3> points, size_t maxVertices) {
+    /*
+     * Quickhull (Barber, Dobkin, Huhdanpaa 1996): start from a tetrahedron of
+     * extreme points, then repeatedly take the point farthest above some face,
+     * remove every face it sees and close the hole with a fan of faces from the
+     * horizon to the new point.
+     */
+    ConvexHull hull;
+    if (points.size() < 2 || maxVertices < 2) {
+        return hull;
+    }
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    std::array<uint32_t, 6> extremes {};
+    for (uint32_t i = 0; i < points.size(); ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            if (points[i][axis] < points[extremes[2 * axis]][axis]) extremes[2 * axis] = i;
+            if (points[i][axis] > points[extremes[2 * axis + 1]][axis]) extremes[2 * axis + 1] = i;
+        }
+        boundsMin = glm::min(boundsMin, points[i]);
+        boundsMax = glm::max(boundsMax, points[i]);
+    }
+    const float epsilon = 1e-5f * std::max(glm::length(boundsMax - boundsMin), 1e-6f);
+
+    // Initial tetrahedron: the widest axis pair, the point farthest from their
+    // line, then the point farthest from their plane
+    uint32_t a = extremes[0];
+    uint32_t b = extremes[1];
+    for (int axis = 1; axis < 3; ++axis) {
+        const uint32_t lo = extremes[2 * axis];
+        const uint32_t hi = extremes[2 * axis + 1];
+        if (glm::length(points[hi] - points[lo]) > glm::length(points[b] - points[a])) {
+            a = lo;
+            b = hi;
+        }
+    }
+    if (glm::length(points[b] - points[a]) <= epsilon) {
+        hull.vertices = { points[a] };
+        return hull;
+    }
+
+    const glm::vec3 axisAB = glm::normalize(points[b] - points[a]);
+    uint32_t c = a;
+    float bestLine = epsilon;
+    for (uint32_t i = 0; i < points.size(); ++i) {
+        const glm::vec3 offset = points[i] - points[a];
+        const float d = glm::length(offset - glm::dot(offset, axisAB) * axisAB);
+        if (d > bestLine) {
+            bestLine = d;
+            c = i;
+        }
+    }
+    if (c == a || maxVertices < 3) {
+        hull.vertices = { points[a], points[b] };
+        return hull;
+    }
+
+    const glm::vec3 planeNormal = glm::normalize(glm::cross(points[b] - points[a], points[c] - points[a]));
+    uint32_t d = a;
+    float bestPlane = epsilon;
+    for (uint32_t i = 0; i < points.size(); ++i) {
+        const float distance = std::abs(glm::dot(points[i] - points[a], planeNormal));
+        if (distance > bestPlane) {
+            bestPlane = distance;
+            d = i;
+        }
+    }
+    if (d == a || maxVertices < 4) {
+        hull.vertices = { points[a], points[b], points[c] };
+        return hull;
+    }
+
+    // Orient the tetrahedron so its faces point away from the fourth vertex
+    if (glm::dot(points[d] - points[a], planeNormal) > 0.0f) {
+        std::swap(b, c);
+    }
+    std::vector<Face> faces;
+    faces.push_back(makeFace(points, a, b, c));
+    faces.push_back(makeFace(points, a, d, b));
+    faces.push_back(makeFace(points, b, d, c));
+    faces.push_back(makeFace(points, c, d, a));
+
+    std::vector<uint32_t> candidates;
+    candidates.reserve(points.size());
+    for (uint32_t i = 0; i < points.size(); ++i) {
+        if (i != a && i != b && i != c && i != d) {
+            candidates.push_back(i);
+        }
+    }
+    assignOutside(points, candidates, faces, 0, epsilon);
+
+    size_t vertexCount = 4;
+    std::vector<std::array<uint32_t, 2>> edges;
+    std::vector<size_t> visible;
+    while (vertexCount < maxVertices) {
+        // Farthest outside point over all faces
+        size_t eyeFace = faces.size();
+        uint32_t eye = 0;
+        float farthest = epsilon;
+        for (size_t f = 0; f < faces.size(); ++f) {
+            if (!faces[f].alive) continue;
+            for (uint32_t p : faces[f].outside) {
+                const float distance = faces[f].distance(points[p]);
+                if (distance > farthest) {
+                    farthest = distance;
+                    eyeFace = f;
+                    eye = p;
+                }
+            }
+        }
+        if (eyeFace == faces.size()) {
+            break;
+        }
+
+        visible.clear();
+        edges.clear();
+        for (size_t f = 0; f < faces.size(); ++f) {
+            if (faces[f].alive && faces[f].distance(points[eye]) > epsilon) {
+                visible.push_back(f);
+                for (int e = 0; e < 3; ++e) {
+                    edges.push_back({ faces[f].v[e], faces[f].v[(e + 1) % 3] });
+                }
+            }
+        }
+
+        // Horizon edges belong to exactly one visible face
+        candidates.clear();
+        for (size_t f : visible) {
+            faces[f].alive = false;
+            for (uint32_t p : faces[f].outside) {
+                if (p != eye) candidates.push_back(p);
+            }
+            faces[f].outside.clear();
+        }
+        const size_t firstNew = faces.size();
+        for (const auto& edge : edges) {
+            const bool shared = std::any_of(edges.begin(), edges.end(), [&](const auto& other) {
+                return other[0] == edge[1] && other[1] == edge[0];
+            });
+            if (!shared) {
+                faces.push_back(makeFace(points, edge[0], edge[1], eye));
+            }
+        }
+        assignOutside(points, candidates, faces, firstNew, epsilon);
+        ++vertexCount;
+    }
+
+    // Compact to the vertices the surviving faces use
+    std::vector<uint32_t> remap(points.size(), std::numeric_limits<uint32_t>::max());
+    for (const auto& face : faces) {
+        if (!face.alive) continue;
+        for (uint32_t v : face.v) {
+            if (remap[v] == std::numeric_limits<uint32_t>::max()) {
+                remap[v] = static_cast<uint32_t>(hull.vertices.size());
+                hull.vertices.push_back(points[v]);
+            }
+            hull.indices.push_back(remap[v]);
+        }
+    }
+    return hull;
+}
+
+ConvexHull ConvexHull::fromMesh(const Mesh& mesh, size_t maxVertices) {
+    std::vector<glm::vec3> points;
+    points.reserve(mesh.getVertexCount());
+    for (const auto& v : mesh.getVertices()) {
+        points.push_back(v.position);
+    }
+    return fromPoints(points, maxVertices);
+}
+
+} // namespace sauce::modeling
@@ -136,6 +136,7 @@ std::shared_ptr<ModelNode> GLTFLoader::processNode(const tinygltf::Model& gltfMo
 
     applyNodeLight(gltfNode, node);
     applyNodeCloth(gltfNode, node);
+    applyNodeCollider(gltfNode, node);
 
     // Process children
     processNodeChildren(gltfModel, gltfNode, node);
@@ -593,6 +594,11 @@ void GLTFLoader::applyNodeCloth(const tinygltf::Node& gltfNode, std::shared_ptr<
             static_cast<float>(extValue.Get("gravityScale").GetNumberAsDouble());
     }
 
+    if (extValue.Has("collisionThickness") && extValue.Get("collisionThickness").IsNumber()) {
+        clothInfo.settings.collisionThickness =
+            static_cast<float>(extValue.Get("collisionThickness").GetNumberAsDouble());
+    }
+
     if (extValue.Has("solverSubsteps") && extValue.Get("solverSubsteps").IsInt()) {
         clothInfo.settings.solverSubsteps = extValue.Get("solverSubsteps").GetNumberAsInt();
     } else if (extValue.Has("solverSubsteps") && extValue.Get("solverSubsteps").IsNumber()) {
@@ -620,5 +626,62 @@ void GLTFLoader::applyNodeCloth(const tinygltf::Node& gltfNode, std::shared_ptr<
     node->setClothInfo(clothInfo);
 }
 
+void GLTFLoader::applyNodeCollider(const tinygltf::Node& gltfNode, std::shared_ptr<ModelNode> node) {
+    if (!gltfNode.extras.IsObject() || !gltfNode.extras.Has("collider")) {
+        return;
+    }
+
+    const auto& value = gltfNode.extras.Get("collider");
+    if (!value.IsObject() || !value.Has("type") || !value.Get("type").IsString()) {
+        return;
+    }
+
+    ColliderInfo colliderInfo;
+    const std::string& type = value.Get("type").Get<std::string>();
+    if (type == "sphere") {
+        colliderInfo.shape = ColliderInfo::Shape::Sphere;
+    } else if (type == "box") {
+        colliderInfo.shape = ColliderInfo::Shape::Box;
+    } else if (type == "capsule") {
+        colliderInfo.shape = ColliderInfo::Shape::Capsule;
+    } else if (type == "plane") {
+        colliderInfo.shape = ColliderInfo::Shape::Plane;
+    } else if (type == "convex") {
+        colliderInfo.shape = ColliderInfo::Shape::ConvexHull;
+    } else {
+        return;
+    }
+
+    auto readFloat = [&value](const char* key, float& out) {
+        if (value.Has(key) && value.Get(key).IsNumber()) {
+            out = static_cast<float>(value.Get(key).GetNumberAsDouble());
+        }
+    };
+    auto readVec3 = [&value](const char* key, glm::vec3& out) {
+        if (!value.Has(key) || !value.Get(key).IsArray() || value.Get(key).ArrayLen() != 3) {
+            return;
+        }
+        const auto& array = value.Get(key);
+        for (int i = 0; i < 3; ++i) {
+            if (array.Get(i).IsNumber()) {
+                out[i] = static_cast<float>(array.Get(i).GetNumberAsDouble());
+            }
+        }
+    };
+
+    readVec3("offset", colliderInfo.offset);
+    readFloat("radius", colliderInfo.radius);
+    readVec3("halfExtents", colliderInfo.halfExtents);
+    readFloat("halfHeight", colliderInfo.halfHeight);
+    readVec3("normal", colliderInfo.normal);
+    if (glm::dot(colliderInfo.normal, colliderInfo.normal) > 0.0f) {
+        colliderInfo.normal = glm::normalize(colliderInfo.normal);
+    } else {
+        colliderInfo.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+
+    node->setColliderInfo(colliderInfo);
+}
+
 } // namespace modeling
 } // namespace sauce
@@ -0,0 +1,89 @@
+#include "app/modeling/MassProperties.hpp"
+#include "app/modeling/Mesh.hpp"
+
+namespace sauce::modeling {
+
+glm::mat3 MassProperties::inverseInertia(float invMass) const {
+    if (invMass <= 0.0f) {
+        return glm::mat3(0.0f);
+    }
+    if (!hasVolume()) {
+        return glm::mat3(1.0f);
+    }
+    // inertia is for unit density, i.e. a mass equal to the volume
+    const float density = 1.0f / (invMass * volume);
+    const glm::mat3 scaled = inertia * density;
+    if (glm::determinant(scaled) <= 0.0f) {
+        return glm::mat3(1.0f);
+    }
+    return glm::inverse(scaled);
+}
+
+MassProperties MassProperties::fromMesh(const Mesh& mesh) {
+    /*
+     * Each triangle (a, b, c) and the origin span a tetrahedron with signed
+     * volume det[a b c] / 6. Summing those signed terms over a closed surface
+     * cancels everything outside it, for the volume as well as for the first
+     * and second moments:
+     *   integral of x dV       = det / 24 * (a + b + c)
+     *   integral of x x^T dV   = det / 120 * (aa^T + bb^T + cc^T + ss^T), s = a + b + c
+     * https://www.geometrictools.com/Documentation/PolyhedralMassProperties.pdf
+     */
+    const auto& vertices = mesh.getVertices();
+    const auto& indices = mesh.getIndices();
+
+    double sixVolume = 0.0;
+    glm::dvec3 firstMoment(0.0);
+    glm::dmat3 secondMoment(0.0);
+
+    const size_t triangleCount = indices.size() / 3;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[3 * t + 0];
+        const uint32_t i1 = indices[3 * t + 1];
+        const uint32_t i2 = indices[3 * t + 2];
+        if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size()) {
+            continue;
+        }
+
+        const glm::dvec3 a(vertices[i0].position);
+        const glm::dvec3 b(vertices[i1].position);
+        const glm::dvec3 c(vertices[i2].position);
+        const glm::dvec3 s = a + b + c;
+        const double det = glm::dot(a, glm::cross(b, c));
+
+        sixVolume += det;
+        firstMoment += det * s;
+        secondMoment += det * (glm::outerProduct(a, a) + glm::outerProduct(b, b) +
+                               glm::outerProduct(c, c) + glm::outerProduct(s, s));
+    }
+
+    MassProperties properties;
+    double volume = sixVolume / 6.0;
+    if (volume < 0.0) {
+        // Inward-facing winding flips every signed term
+        volume = -volume;
+        firstMoment = -firstMoment;
+        secondMoment = -secondMoment;
+    }
+
+    if (volume <= 1e-12) {
+        glm::vec3 sum(0.0f);
+        for (const auto& v : vertices) {
+            sum += v.position;
+        }
+        properties.centerOfMass = vertices.empty() ? sum : sum / static_cast<float>(vertices.size());
+        return properties;
+    }
+
+    const glm::dvec3 center = firstMoment / (24.0 * volume);
+    // Covariance about the center of mass (parallel axis theorem)
+    const glm::dmat3 covariance = secondMoment / 120.0 - volume * glm::outerProduct(center, center);
+    const double trace = covariance[0][0] + covariance[1][1] + covariance[2][2];
+
+    properties.volume = static_cast<float>(volume);
+    properties.centerOfMass = glm::vec3(center);
+    properties.inertia = glm::mat3(glm::dmat3(trace) - covariance);
+    return properties;
+}
+
+} // namespace sauce::modeling
@@ -14,7 +14,18 @@ namespace sauce::ui
 	{
 		if (enabled)
 		{
-			ImGui::PlotLines(this->name.c_str(), this->values.data(), this->values.size());
+			const char* overlayText = this->overlay.empty() ? nullptr : this->overlay.c_str();
+			ImGui::PlotLines(this->name.c_str(), this->values.data(), static_cast<int>(this->values.size()), 0, overlayText);
 		}
 	}
+
+	void PlotLines::setValues(std::vector<float> newValues)
+	{
+		values = std::move(newValues);
+	}
+
+	void PlotLines::setOverlay(std::string text)
+	{
+		overlay = std::move(text);
+	}
 }
@@ -1,12 +1,17 @@
 #include <app/Scene.hpp>
 #include <app/components/ClothComponent.hpp>
 #include <app/components/MeshRendererComponent.hpp>
+#include <app/components/RigidBodyComponent.hpp>
+#include <app/components/TransformComponent.hpp>
+#include <physics/SceneQuery.hpp>
 
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -113,6 +118,29 @@ std::filesystem::path writeClothFixture(
   return gltfPath;
 }
 
+// Two mesh-less nodes carrying only a collider in their extras
+std::filesystem::path writeColliderFixture(const std::filesystem::path& gltfPath) {
+  std::ofstream gltfOut(gltfPath, std::ios::trunc);
+  gltfOut
+      << "{\n"
+      << "  \"asset\": { \"version\": \"2.0\" },\n"
+      << "  \"scene\": 0,\n"
+      << "  \"scenes\": [ { \"nodes\": [0, 1] } ],\n"
+      << "  \"nodes\": [\n"
+      << "    {\n"
+      << "      \"name\": \"ColliderBall\",\n"
+      << "      \"translation\": [0.0, 2.0, 0.0],\n"
+      << "      \"extras\": { \"collider\": { \"type\": \"sphere\", \"radius\": 0.25 } }\n"
+      << "    },\n"
+      << "    {\n"
+      << "      \"name\": \"ColliderGround\",\n"
+      << "      \"extras\": { \"collider\": { \"type\": \"plane\", \"normal\": [0.0, 1.0, 0.0] } }\n"
+      << "    }\n"
+      << "  ]\n"
+      << "}\n";
+  return gltfPath;
+}
+
 bool testSinglePrimitiveClothImport(std::vector<std::string>& errors) {
   const auto fixtureStem =
       std::filesystem::temp_directory_path() /
@@ -188,6 +216,278 @@ bool testMultiPrimitiveClothSkipped(std::vector<std::string>& errors) {
   return true;
 }
 
+bool testColliderOnlyNodeImport(std::vector<std::string>& errors) {
+  const std::filesystem::path gltfPath =
+      writeColliderFixture(std::filesystem::temp_directory_path() / "sauce_collider_fixture.gltf");
+
+  sauce::Scene scene({ .scrWidth = 640, .scrHeight = 480 });
+  if (!scene.loadFromFile(gltfPath.string())) {
+    errors.push_back("collider-only scene failed to load");
+    return false;
+  }
+
+  // Without a mesh the node still gets one body carrying its collider
+  auto* ball = scene.getEntity("ColliderBall");
+  const auto* ballBody = ball ? ball->getComponent<sauce::RigidBodyComponent>() : nullptr;
+  if (!ballBody || ball->getComponents<sauce::RigidBodyComponent>().size() != 1 || !ballBody->getCollider() ||
+      ballBody->getCollider()->shape != sauce::modeling::ColliderInfo::Shape::Sphere ||
+      ballBody->getCollider()->radius != 0.25f || ballBody->getPosition() != glm::vec3(0.0f, 2.0f, 0.0f) ||
+      ballBody->getInvMass() <= 0.0f) {
+    errors.push_back("collider-only node did not get a dynamic body with its collider");
+    return false;
+  }
+
+  auto* ground = scene.getEntity("ColliderGround");
+  const auto* groundBody = ground ? ground->getComponent<sauce::RigidBodyComponent>() : nullptr;
+  if (!groundBody || !groundBody->getCollider() ||
+      groundBody->getCollider()->shape != sauce::modeling::ColliderInfo::Shape::Plane ||
+      groundBody->getInvMass() != 0.0f) {
+    errors.push_back("collider-only plane node did not get a static body");
+    return false;
+  }
+
+  return true;
+}
+
+class TestShapeComponent : public sauce::Component {
+public:
+  explicit TestShapeComponent(std::string name = "TestShape") : sauce::Component(std::move(name)) {}
+};
+
+class TestCircleComponent : public TestShapeComponent {
+public:
+  using ComponentBase = TestShapeComponent;
+  explicit TestCircleComponent(std::string name = "TestCircle") : TestShapeComponent(std::move(name)) {}
+};
+
+bool testEntityComponentIndex(std::vector<std::string>& errors) {
+  sauce::Entity entity("indexed");
+  entity.addComponent<TestShapeComponent>("first");
+  entity.addComponent<sauce::TransformComponent>();
+  entity.addComponent<TestCircleComponent>("second");
+  entity.addComponent<TestShapeComponent>("third");
+
+  // A derived component is found under its own type and under its base, and
+  // every lookup returns the most recently added match
+  auto shapes = entity.getComponents<TestShapeComponent>();
+  if (shapes.size() != 3 || shapes[0]->name != "first" || shapes[1]->name != "second" ||
+      shapes.back()->name != "third" || entity.getComponent<TestShapeComponent>() != shapes[2] ||
+      entity.getComponent<TestCircleComponent>() != shapes[1] ||
+      entity.getComponent<TestShapeComponent>("second") != shapes[1]) {
+    errors.push_back("component lookup did not follow type and insertion order");
+    return false;
+  }
+  if (!entity.hasComponent<TestCircleComponent>() || !entity.hasComponent<sauce::TransformComponent>() ||
+      entity.hasComponent<sauce::ClothComponent>() || entity.getComponent<sauce::ClothComponent>() != nullptr ||
+      !entity.getComponents<sauce::ClothComponent>().empty()) {
+    errors.push_back("component presence bits were wrong");
+    return false;
+  }
+
+  // Views read through the entity, so removals show up in a view taken before
+  size_t seen = 0;
+  for (auto* shape : shapes) {
+    seen += shape != nullptr;
+  }
+  entity.removeComponent<TestCircleComponent>();
+  if (seen != 3 || shapes.size() != 2 || shapes[1]->name != "third" ||
+      entity.hasComponent<TestCircleComponent>()) {
+    errors.push_back("removing a component left it indexed");
+    return false;
+  }
+
+  // Moving the entity keeps the index and rebinds owners
+  sauce::Entity moved(std::move(entity));
+  auto* transform = moved.getComponent<sauce::TransformComponent>();
+  if (!transform || transform->getOwner() != &moved || moved.getComponents<TestShapeComponent>().size() != 2 ||
+      entity.hasComponent<sauce::TransformComponent>()) {
+    errors.push_back("moved entity lost its component index");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSceneViewFollowsComponents(std::vector<std::string>& errors) {
+  sauce::Scene scene({ .scrWidth = 640, .scrHeight = 480 });
+  for (int i = 0; i < 6; ++i) {
+    sauce::Entity entity("ViewEntity" + std::to_string(i));
+    entity.addComponent<sauce::TransformComponent>();
+    if (i % 2 == 0) {
+      entity.addComponent<sauce::ClothComponent>();
+    }
+    scene.addEntity(std::move(entity));
+  }
+
+  auto countMatches = [&]() {
+    size_t matches = 0;
+    for (auto [entity, transform, cloth] : scene.view<sauce::TransformComponent, sauce::ClothComponent>()) {
+      if (cloth.getOwner() != &entity || entity.getComponent<sauce::TransformComponent>() != &transform) {
+        return size_t(0);
+      }
+      ++matches;
+    }
+    return matches;
+  };
+  if (countMatches() != 3 || !scene.view<sauce::MeshRendererComponent>().empty()) {
+    errors.push_back("scene view did not match the entities with both components");
+    return false;
+  }
+
+  // Components added or removed after the entity joined the scene, and
+  // removed entities, show up in the next view
+  scene.getEntitiesMut()[1].addComponent<sauce::ClothComponent>();
+  scene.getEntitiesMut()[0].removeComponent<sauce::ClothComponent>();
+  scene.removeEntity(2);
+  size_t visited = 0;
+  scene.view<sauce::ClothComponent>().each([&](sauce::Entity& entity, sauce::ClothComponent&) {
+    visited += entity.get_name() == "ViewEntity1" || entity.get_name() == "ViewEntity4";
+  });
+  if (countMatches() != 2 || visited != 2) {
+    errors.push_back("scene view missed component or entity changes");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSceneEntityNameLookup(std::vector<std::string>& errors) {
+  sauce::Scene scene({ .scrWidth = 640, .scrHeight = 480 });
+  for (const char* name : { "Crate", "Lamp", "Crate", "Floor" }) {
+    scene.addEntity(sauce::Entity(name));
+  }
+  auto& entities = scene.getEntitiesMut();
+
+  // Duplicates resolve to the first entity in scene order
+  const std::string_view crate = "Crate";
+  if (scene.getEntity(crate) != &entities[0] || scene.countEntities(crate) != 2 ||
+      scene.getEntity("Missing") != nullptr) {
+    errors.push_back("name lookup did not return the first entity of that name");
+    return false;
+  }
+
+  // Renames and removals keep the index in step
+  entities[0].set_name("Barrel");
+  if (scene.getEntity("Crate") != &entities[2] || scene.getEntity("Barrel") != &entities[0]) {
+    errors.push_back("name lookup missed a rename");
+    return false;
+  }
+  scene.removeEntity(1);
+  const auto* crateEntity = scene.getEntity("Crate");
+  const auto* floorEntity = scene.getEntity("Floor");
+  if (!crateEntity || crateEntity->get_name() != "Crate" || !floorEntity || floorEntity->get_name() != "Floor" ||
+      scene.getEntity("Lamp") != nullptr) {
+    errors.push_back("name lookup missed a removal");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSceneEntityHandles(std::vector<std::string>& errors) {
+  sauce::Scene scene({ .scrWidth = 640, .scrHeight = 480 });
+  const sauce::EntityHandle a = scene.addEntity(sauce::Entity("A"));
+  const sauce::EntityHandle b = scene.addEntity(sauce::Entity("B"));
+  const sauce::EntityHandle c = scene.addEntity(sauce::Entity("C"));
+
+  // Destroying moves the last entity into the hole; handles follow it
+  if (!scene.destroyEntity(b) || scene.isValid(b) || scene.getEntity(b) != nullptr || scene.destroyEntity(b) ||
+      scene.getEntities().size() != 2 || !scene.getEntity(a) || scene.getEntity(a)->get_name() != "A" ||
+      scene.getEntity(c) != scene.getEntity("C") || scene.getHandle(1) != c) {
+    errors.push_back("destroying an entity broke the other handles");
+    return false;
+  }
+
+  // The freed slot is reused under a new generation
+  const sauce::EntityHandle d = scene.addEntity(sauce::Entity("D"));
+  if (d.index != b.index || d.generation == b.generation || scene.isValid(b) || !scene.getEntity(d) ||
+      scene.getEntity(d)->get_name() != "D") {
+    errors.push_back("a reused entity slot resolved a stale handle");
+    return false;
+  }
+
+  scene.clearEntities();
+  if (scene.isValid(a) || scene.isValid(c) || scene.isValid(d) || scene.isValid(sauce::EntityHandle{})) {
+    errors.push_back("clearing the scene left handles valid");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSceneComponentPools(std::vector<std::string>& errors) {
+  sauce::Scene scene({ .scrWidth = 640, .scrHeight = 480 });
+  std::vector<sauce::EntityHandle> handles;
+  for (int i = 0; i < 8; ++i) {
+    sauce::Entity entity("Pooled" + std::to_string(i));
+    entity.addComponent<sauce::TransformComponent>();
+    entity.getComponent<sauce::TransformComponent>()->setTranslation(glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+    handles.push_back(scene.addEntity(std::move(entity)));
+  }
+
+  // Components move into the scene's pools when their entity joins, and
+  // destroying entities or components packs the pools; the survivors keep
+  // their values and owners
+  scene.destroyEntity(handles[2]);
+  sauce::Entity* fifth = scene.getEntity(handles[5]);
+  fifth->addComponent<sauce::TransformComponent>();
+  fifth->removeComponentByPointer(fifth->getComponents<sauce::TransformComponent>().front());
+  scene.getEntity(handles[0])->removeComponent<sauce::TransformComponent>();
+  for (int i = 1; i < 8; ++i) {
+    if (i == 2) {
+      continue;
+    }
+    sauce::Entity* entity = scene.getEntity(handles[i]);
+    const auto transforms = entity->getComponents<sauce::TransformComponent>();
+    const float expected = i == 5 ? 0.0f : static_cast<float>(i);
+    if (transforms.size() != 1 || transforms[0]->getTranslation().x != expected ||
+        transforms[0]->getOwner() != entity) {
+      errors.push_back("pooled components lost their values or owners");
+      return false;
+    }
+  }
+  if (scene.getEntity(handles[0])->hasComponent<sauce::TransformComponent>() ||
+      !scene.getEntity(handles[0])->getComponents<sauce::TransformComponent>().empty()) {
+    errors.push_back("a removed pooled component was still found");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSceneQueryProxyPerMesh(std::vector<std::string>& errors) {
+  // A triangle in the z = 0 plane, one unit across, starting at x
+  auto makeTriangle = [](float x) {
+    std::vector<sauce::Vertex> vertices(3);
+    vertices[0].position = glm::vec3(x, 0.0f, 0.0f);
+    vertices[1].position = glm::vec3(x + 1.0f, 0.0f, 0.0f);
+    vertices[2].position = glm::vec3(x, 1.0f, 0.0f);
+    return std::make_shared<sauce::modeling::Mesh>(vertices, std::vector<uint32_t> { 0, 1, 2 });
+  };
+
+  sauce::Scene scene({ .scrWidth = 640, .scrHeight = 480 });
+  sauce::Entity entity("TwoMeshes");
+  entity.addComponent<sauce::MeshRendererComponent>(makeTriangle(-3.0f), nullptr);
+  entity.addComponent<sauce::MeshRendererComponent>(makeTriangle(2.0f), nullptr);
+  scene.addEntity(std::move(entity));
+
+  // Rays through either mesh pick the entity; one through the gap between
+  // them picks nothing
+  const auto query = physics::SceneQuery::fromScene(scene);
+  physics::RaycastHit hit;
+  if (!query.raycast({ glm::vec3(2.25f, 0.25f, 5.0f) }, hit) || hit.id != 0 ||
+      !query.raycast({ glm::vec3(-2.75f, 0.25f, 5.0f) }, hit) || hit.id != 0) {
+    errors.push_back("scene query missed a mesh of a multi-mesh entity");
+    return false;
+  }
+  if (query.raycast({ glm::vec3(0.0f, 0.25f, 5.0f) }, hit)) {
+    errors.push_back("scene query hit the gap between an entity's meshes");
+    return false;
+  }
+
+  return true;
+}
+
 } // namespace
 
 int main() {
@@ -195,6 +495,13 @@ int main() {
 
   const bool singlePrimitiveOk = testSinglePrimitiveClothImport(errors);
   const bool multiPrimitiveOk = testMultiPrimitiveClothSkipped(errors);
+  const bool colliderOnlyOk = testColliderOnlyNodeImport(errors);
+  const bool componentIndexOk = testEntityComponentIndex(errors);
+  const bool sceneViewOk = testSceneViewFollowsComponents(errors);
+  const bool nameLookupOk = testSceneEntityNameLookup(errors);
+  const bool handlesOk = testSceneEntityHandles(errors);
+  const bool poolsOk = testSceneComponentPools(errors);
+  const bool sceneQueryOk = testSceneQueryProxyPerMesh(errors);
 
   if (!errors.empty()) {
     std::cerr << "Cloth scene smoke failed:\n";
@@ -209,5 +516,19 @@ int main() {
             << (singlePrimitiveOk ? "ok" : "failed") << "\n";
   std::cout << "  multi primitive skip: "
             << (multiPrimitiveOk ? "ok" : "failed") << "\n";
+  std::cout << "  collider-only node: "
+            << (colliderOnlyOk ? "ok" : "failed") << "\n";
+  std::cout << "  entity component index: "
+            << (componentIndexOk ? "ok" : "failed") << "\n";
+  std::cout << "  scene view: "
+            << (sceneViewOk ? "ok" : "failed") << "\n";
+  std::cout << "  entity name lookup: "
+            << (nameLookupOk ? "ok" : "failed") << "\n";
+  std::cout << "  entity handles: "
+            << (handlesOk ? "ok" : "failed") << "\n";
+  std::cout << "  component pools: "
+            << (poolsOk ? "ok" : "failed") << "\n";
+  std::cout << "  scene query per mesh: "
+            << (sceneQueryOk ? "ok" : "failed") << "\n";
   return 0;
 }
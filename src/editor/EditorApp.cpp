@@ -3,7 +3,6 @@
 #include <editor/panels/InspectorPanel.hpp>
 #include <editor/panels/ViewportPanel.hpp>
 #include <editor/panels/AssetBrowserPanel.hpp>
-#include <editor/AABB.hpp>
 #include <editor/gizmos/GizmoRenderer.hpp>
 #include <app/GraphicsPipeline.hpp>
 #include <app/ui/components/SettingsWindow.hpp>
@@ -12,6 +11,7 @@
 #include <app/modeling/Material.hpp>
 #include <app/modeling/GLTFLoader.hpp>
 #include <app/modeling/Model.hpp>
+#include <physics/SceneQuery.hpp>
 
 #include <glm/gtc/quaternion.hpp>
 #include <imgui.h>
@@ -539,42 +539,13 @@ void EditorApp::pickEntityAtScreen(float windowX, float windowY) {
 
   Ray ray = editorCamera.screenToWorldRay(localX, localY, vpSize.x, vpSize.y);
 
-  int bestIdx = -1;
-  float bestDist = std::numeric_limits<float>::max();
+  const auto query = physics::SceneQuery::fromScene(*pScene);
+  physics::RaycastHit hit;
+  const int bestIdx = query.raycast({ ray.origin, ray.direction }, hit) ? static_cast<int>(hit.id) : -1;
 
   auto& entities = pScene->getEntitiesMut();
-  for (int i = 0; i < static_cast<int>(entities.size()); ++i) {
-    auto& entity = entities[i];
-    if (!entity.getActive()) continue;
-
-    auto mrcs = entity.getComponents<MeshRendererComponent>();
-    if (mrcs.empty()) continue;
-
-    glm::mat4 modelMatrix = glm::mat4(1.0f);
-    auto* tc = entity.getComponent<TransformComponent>();
-    if (tc) {
-      modelMatrix = tc->getLocalMatrix();
-    }
-
-    for (auto* mrc : mrcs) {
-      auto mesh = mrc->getMesh();
-      if (!mesh || !mesh->isValid()) continue;
-
-      AABB localAABB = AABB::fromVertices(mesh->getVertices());
-      AABB worldAABB = localAABB.transformed(modelMatrix);
-
-      float t = 0.0f;
-      if (rayIntersectsAABB(ray.origin, ray.direction, worldAABB, t)) {
-        if (t < bestDist) {
-          bestDist = t;
-          bestIdx = i;
-        }
-      }
-    }
-  }
-
   if (bestIdx >= 0) {
-    selectionManager.select(bestIdx);
+    selectionManager.select(pScene->getHandle(bestIdx));
     setStatusMessage("Selected: " + entities[bestIdx].get_name());
   } else {
     selectionManager.deselect();
@@ -941,7 +912,7 @@ void EditorApp::buildEditorUI() {
     if (ImGui::BeginMenu("File")) {
       if (ImGui::MenuItem("New Scene", "Ctrl+N")) {
         logicalDevice->waitIdle();
-        pScene->getEntitiesMut().clear();
+        pScene->clearEntities();
         pScene->setCurrentFilePath("");
         selectionManager.deselect();
         setStatusMessage("New scene created");
@@ -1455,7 +1426,7 @@ void EditorApp::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int a
     }
     if (key == GLFW_KEY_N) {
       app->logicalDevice->waitIdle();
-      app->pScene->getEntitiesMut().clear();
+      app->pScene->clearEntities();
       app->pScene->setCurrentFilePath("");
       app->selectionManager.deselect();
       app->setStatusMessage("New scene created");
@@ -1499,13 +1470,11 @@ void EditorApp::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int a
   }
 
   if (key == GLFW_KEY_DELETE && action == GLFW_PRESS) {
-    int idx = app->selectionManager.getSelectedIndex();
-    auto& entities = app->pScene->getEntitiesMut();
-    if (idx >= 0 && idx < static_cast<int>(entities.size())) {
-      std::string name = entities[idx].get_name();
+    if (auto* entity = app->selectionManager.getSelectedEntity(*app->pScene)) {
+      std::string name = entity->get_name();
       // Wait for GPU to finish using entity's mesh buffers before destroying
       app->logicalDevice->waitIdle();
-      entities.erase(entities.begin() + idx);
+      app->pScene->destroyEntity(app->selectionManager.getSelected());
       app->selectionManager.deselect();
       app->setStatusMessage("Deleted: " + name);
     }
@@ -1543,9 +1512,7 @@ void EditorApp::dropCallback(GLFWwindow* window, int count, const char** paths)
 void EditorApp::createEmptyEntity() {
     sauce::Entity e("Empty Entity");
     e.addComponent<TransformComponent>();
-    pScene->addEntity(std::move(e));
-
-    selectionManager.select(int(pScene->getEntities().size()) - 1);
+    selectionManager.select(pScene->addEntity(std::move(e)));
     setStatusMessage("Created Empty Entity");
 }
 
@@ -1555,7 +1522,7 @@ void EditorApp::createBoxEntity() {
     size_t after = pScene->getEntities().size();
 
     if (after > before) {
-        selectionManager.select(int(after - 1));
+        selectionManager.select(pScene->getHandle(after - 1));
         setStatusMessage("Created Box");
     }
 }
@@ -1567,7 +1534,7 @@ void EditorApp::createBallEntity() {
     size_t after = pScene->getEntities().size();
 
     if (after > before) {
-        selectionManager.select(int(after - 1));
+        selectionManager.select(pScene->getHandle(after - 1));
         setStatusMessage("Created Ball");
     }
 }
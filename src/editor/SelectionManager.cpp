@@ -4,11 +4,7 @@
 namespace sauce::editor {
 
 sauce::Entity* SelectionManager::getSelectedEntity(sauce::Scene& scene) {
-  auto& entities = scene.getEntitiesMut();
-  if (selectedIndex < 0 || selectedIndex >= static_cast<int>(entities.size())) {
-    return nullptr;
-  }
-  return &entities[selectedIndex];
+  return scene.getEntity(selected);
 }
 
 } // namespace sauce::editor
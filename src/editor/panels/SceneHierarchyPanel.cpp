@@ -63,7 +63,8 @@ void SceneHierarchyPanel::render() {
                                ImGuiTreeNodeFlags_NoTreePushOnOpen |
                                ImGuiTreeNodeFlags_SpanAvailWidth;
 
-    if (selection.getSelectedIndex() == i) {
+    const sauce::EntityHandle handle = scene.getHandle(i);
+    if (selection.isSelected(handle)) {
       flags |= ImGuiTreeNodeFlags_Selected;
     }
 
@@ -73,7 +74,7 @@ void SceneHierarchyPanel::render() {
     }
 
     // Show component indicators
-    bool hasMesh = entity.getComponent<MeshRendererComponent>() != nullptr;
+    bool hasMesh = entity.hasComponent<MeshRendererComponent>();
     const char* icon = hasMesh ? "[M] " : "    ";
     char label[256];
     snprintf(label, sizeof(label), "%s%s", icon, name.c_str());
@@ -85,7 +86,7 @@ void SceneHierarchyPanel::render() {
     }
 
     if (ImGui::IsItemClicked()) {
-      selection.select(i);
+      selection.select(handle);
     }
 
     // Double-click to focus
@@ -110,14 +111,12 @@ void SceneHierarchyPanel::render() {
       }
       if (ImGui::MenuItem("Delete")) {
         std::string deletedName = name;
-        if (selection.getSelectedIndex() == i) {
+        if (selection.isSelected(handle)) {
           selection.deselect();
-        } else if (selection.getSelectedIndex() > i) {
-          selection.select(selection.getSelectedIndex() - 1);
         }
         // Wait for GPU to finish using entity's mesh buffers before destroying
         app.getLogicalDevice()->waitIdle();
-        entities.erase(entities.begin() + i);
+        scene.destroyEntity(handle);
         app.setStatusMessage("Deleted: " + deletedName);
         ImGui::EndPopup();
         break;
@@ -147,8 +146,7 @@ void SceneHierarchyPanel::render() {
     if (ImGui::MenuItem("Add Empty Entity")) {
       sauce::Entity newEntity("New Entity");
       newEntity.addComponent<TransformComponent>();
-      scene.addEntity(std::move(newEntity));
-      selection.select(static_cast<int>(entities.size()) - 1);
+      selection.select(scene.addEntity(std::move(newEntity)));
       app.setStatusMessage("Created new entity");
     }
     ImGui::EndPopup();
@@ -1,11 +1,25 @@
 #include "launcher/optionParser.hpp"
 
+namespace {
+
+void validatePhysicsCatchUp(const std::string& policy) {
+    if (policy != "drop" && policy != "carry") {
+        boost::program_options::invalid_option_value error(policy);
+        error.set_option_name("--physics-catchup");
+        throw error;
+    }
+}
+
+}
+
 /**
  * Options:
  * --help               Help
  * -w --width           Screen width
  * -h --height          Screen height
- * -t --tickrate        Tickrate
+ * -t --tickrate        Physics tickrate
+ * --max-physics-steps  Physics steps allowed per rendered frame
+ * --physics-catchup    Catch-up policy when steps are dropped (drop|carry)
  * -f --input-file      Scene file
  */
 AppOptions::AppOptions(int argc, char const **argv): desc("Allowed options") {
@@ -16,7 +30,9 @@ AppOptions::AppOptions(int argc, char const **argv): desc("Allowed options") {
     ("skip-launcher", "start the engine immediately")
     ("width,w", po::value<unsigned int>(&(this->scr_width))->default_value(DEFAULT_SCR_WIDTH), "screen width")
     ("height,h", po::value<unsigned int>(&(this->scr_height))->default_value(DEFAULT_SCR_HEIGHT), "screen height")
-    ("tickrate,t", po::value<double>(&(this->tickrate))->default_value(DEFAULT_TICKRATE), "animation tickrate")
+    ("tickrate,t", po::value<double>(&(this->tickrate))->default_value(DEFAULT_TICKRATE), "physics tickrate in Hz")
+    ("max-physics-steps", po::value<unsigned int>(&(this->max_physics_steps))->default_value(DEFAULT_MAX_PHYSICS_STEPS), "physics steps allowed per rendered frame")
+    ("physics-catchup", po::value<std::string>(&(this->physics_catchup))->default_value("drop")->notifier(validatePhysicsCatchUp), "physics time left over after max-physics-steps: drop or carry")
     ("input-file,f", po::value<std::string>(&(this->scene_file))->default_value(""), "scene file to load")
     ("ibl,i", po::value<std::string>(&(this->ibl_file))->default_value(""), "HDR IBL map to load");
 
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <functional>
+#include <optional>
 #include <vector>
 
 #include <launcher/optionParser.hpp>
@@ -13,7 +14,14 @@
 #include <app/ui/components/Tooltip.hpp>
 
 int main(int argc, const char *argv[]) {
-  const AppOptions ops(argc, argv);
+  std::optional<AppOptions> parsedOptions;
+  try {
+    parsedOptions.emplace(argc, argv);
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const AppOptions& ops = *parsedOptions;
 
   if (ops.help) {
     std::cout << "Usage: " << argv[0] << " <options> [scene_file]" << std::endl;
@@ -29,6 +37,10 @@ int main(int argc, const char *argv[]) {
     if (!ops.ibl_file.empty()) {
       mainApp.setIBLFile(ops.ibl_file);
     }
+    mainApp.setPhysicsTickrate(ops.tickrate);
+    mainApp.setPhysicsCatchUp(
+        ops.physics_catchup == "carry" ? sauce::PhysicsCatchUp::Carry : sauce::PhysicsCatchUp::Drop,
+        static_cast<int>(ops.max_physics_steps));
     mainApp.run(ops.scr_width, ops.scr_height);
   } catch (std::exception& e) {
     std::cerr << e.what() << std::endl;
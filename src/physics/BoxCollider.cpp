@@ -0,0 +1,25 @@
+#include <physics/BoxCollider.hpp>
+#include <physics/Narrowphase.hpp>
+
+namespace physics {
+
+bool BoxCollider::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
+  return collide(*this, collider, info);
+}
+
+glm::vec3 BoxCollider::axis(int i) const {
+  glm::vec3 local(0.0f);
+  local[i] = 1.0f;
+  return orientation * local;
+}
+
+std::array<glm::vec3, 8> BoxCollider::corners() const {
+  std::array<glm::vec3, 8> result;
+  for (int i = 0; i < 8; ++i) {
+    const glm::vec3 sign((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+    result[i] = center + orientation * (sign * halfExtents);
+  }
+  return result;
+}
+
+} // namespace physics
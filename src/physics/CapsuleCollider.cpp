@@ -0,0 +1,18 @@
+#include <physics/CapsuleCollider.hpp>
+#include <physics/Narrowphase.hpp>
+
+namespace physics {
+
+bool CapsuleCollider::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
+  return collide(*this, collider, info);
+}
+
+glm::vec3 CapsuleCollider::pointA() const {
+  return center - orientation * glm::vec3(0.0f, halfHeight, 0.0f);
+}
+
+glm::vec3 CapsuleCollider::pointB() const {
+  return center + orientation * glm::vec3(0.0f, halfHeight, 0.0f);
+}
+
+} // namespace physics
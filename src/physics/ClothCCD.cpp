@@ -0,0 +1,429 @@
+#include <physics/ClothCCD.hpp>
+#include <physics/Cloth.hpp>
+
+#include <app/modeling/Mesh.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace physics {
+
+namespace {
+
+enum BoxKind : uint8_t { kParticleBox, kEdgeBox, kTriangleBox };
+
+// Barycentric slack for points on a triangle's edges and segment-parameter
+// slack for edges meeting at their ends
+constexpr float kInsideTolerance = 1e-4f;
+
+// Real roots of c[0] + c[1] t + c[2] t^2 + c[3] t^3 in [0, 1], ascending. The
+// interval is split at the cubic's turning points so each piece is monotone,
+// and every piece whose ends differ in sign is bisected down to its root.
+int cubicRootsInUnitInterval(const std::array<double, 4>& c, std::array<float, 3>& roots) {
+  const double scale = std::max({ std::abs(c[0]), std::abs(c[1]), std::abs(c[2]), std::abs(c[3]) });
+  if (scale < 1e-30) {
+    return 0;
+  }
+  const std::array<double, 4> n { c[0] / scale, c[1] / scale, c[2] / scale, c[3] / scale };
+  auto f = [&](double t) { return ((n[3] * t + n[2]) * t + n[1]) * t + n[0]; };
+
+  // Turning points: roots of n[1] + 2 n[2] t + 3 n[3] t^2
+  std::array<double, 4> bounds { 0.0, 1.0, 1.0, 1.0 };
+  int boundCount = 1;
+  const double qa = 3.0 * n[3];
+  const double qb = 2.0 * n[2];
+  const double qc = n[1];
+  if (std::abs(qa) > 1e-12) {
+    const double discriminant = qb * qb - 4.0 * qa * qc;
+    if (discriminant >= 0.0) {
+      const double root = std::sqrt(discriminant);
+      double t0 = (-qb - root) / (2.0 * qa);
+      double t1 = (-qb + root) / (2.0 * qa);
+      if (t0 > t1) std::swap(t0, t1);
+      if (t0 > 0.0 && t0 < 1.0) bounds[boundCount++] = t0;
+      if (t1 > 0.0 && t1 < 1.0 && t1 != t0) bounds[boundCount++] = t1;
+    }
+  } else if (std::abs(qb) > 1e-12) {
+    const double t = -qc / qb;
+    if (t > 0.0 && t < 1.0) bounds[boundCount++] = t;
+  }
+  bounds[boundCount++] = 1.0;
+
+  constexpr double kZero = 1e-12;
+  int count = 0;
+  auto push = [&](double t) {
+    if (count == 0 || static_cast<float>(t) > roots[count - 1]) {
+      roots[count++] = static_cast<float>(t);
+    }
+  };
+  for (int i = 0; i + 1 < boundCount && count < 3; ++i) {
+    double lo = bounds[i];
+    double hi = bounds[i + 1];
+    double fLo = f(lo);
+    const double fHi = f(hi);
+    if (std::abs(fLo) <= kZero) {
+      push(lo);
+      continue;
+    }
+    if (std::abs(fHi) <= kZero) {
+      // Pushed as the next piece's start, or here for the last piece
+      if (i + 2 == boundCount) push(hi);
+      continue;
+    }
+    if ((fLo < 0.0) == (fHi < 0.0)) {
+      continue;
+    }
+    for (int iter = 0; iter < 48; ++iter) {
+      const double mid = 0.5 * (lo + hi);
+      const double fMid = f(mid);
+      if ((fMid < 0.0) == (fLo < 0.0)) {
+        lo = mid;
+        fLo = fMid;
+      } else {
+        hi = mid;
+      }
+    }
+    push(0.5 * (lo + hi));
+  }
+  return count;
+}
+
+// Coefficients of dot(cross(e1(t), e2(t)), w(t)) for vectors moving linearly
+// from their *0 to their *1 values
+std::array<double, 4> coplanarityCubic(const glm::vec3& e1, const glm::vec3& de1,
+                                       const glm::vec3& e2, const glm::vec3& de2,
+                                       const glm::vec3& w, const glm::vec3& dw) {
+  const glm::dvec3 c0 = glm::cross(glm::dvec3(e1), glm::dvec3(e2));
+  const glm::dvec3 c1 = glm::cross(glm::dvec3(e1), glm::dvec3(de2)) + glm::cross(glm::dvec3(de1), glm::dvec3(e2));
+  const glm::dvec3 c2 = glm::cross(glm::dvec3(de1), glm::dvec3(de2));
+  const glm::dvec3 w0(w);
+  const glm::dvec3 w1(dw);
+  return {
+      glm::dot(c0, w0),
+      glm::dot(c1, w0) + glm::dot(c0, w1),
+      glm::dot(c2, w0) + glm::dot(c1, w1),
+      glm::dot(c2, w1),
+  };
+}
+
+// Barycentric coordinates of p's projection onto triangle (a, b, c); false
+// for degenerate triangles
+bool barycentric(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                 glm::vec3& coordinates) {
+  const glm::vec3 v0 = b - a;
+  const glm::vec3 v1 = c - a;
+  const glm::vec3 v2 = p - a;
+  const float d00 = glm::dot(v0, v0);
+  const float d01 = glm::dot(v0, v1);
+  const float d11 = glm::dot(v1, v1);
+  const float d20 = glm::dot(v2, v0);
+  const float d21 = glm::dot(v2, v1);
+  const float denominator = d00 * d11 - d01 * d01;
+  if (denominator <= 1e-12f * d00 * d11) {
+    return false;
+  }
+  const float v = (d11 * d20 - d01 * d21) / denominator;
+  const float w = (d00 * d21 - d01 * d20) / denominator;
+  coordinates = glm::vec3(1.0f - v - w, v, w);
+  return true;
+}
+
+// Parameters of the closest points of segments (p, q) and (r, s)
+glm::vec2 closestSegmentParameters(const glm::vec3& p, const glm::vec3& q, const glm::vec3& r, const glm::vec3& s) {
+  const glm::vec3 d1 = q - p;
+  const glm::vec3 d2 = s - r;
+  const glm::vec3 offset = p - r;
+  const float a = glm::dot(d1, d1);
+  const float e = glm::dot(d2, d2);
+  const float f = glm::dot(d2, offset);
+  if (a <= 1e-12f || e <= 1e-12f) {
+    return glm::vec2(0.0f);
+  }
+  const float c = glm::dot(d1, offset);
+  const float b = glm::dot(d1, d2);
+  const float denominator = a * e - b * b;
+  float u = denominator > 1e-12f * a * e ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+  float v = (b * u + f) / e;
+  if (v < 0.0f) {
+    v = 0.0f;
+    u = std::clamp(-c / a, 0.0f, 1.0f);
+  } else if (v > 1.0f) {
+    v = 1.0f;
+    u = std::clamp((b - c) / a, 0.0f, 1.0f);
+  }
+  return glm::vec2(u, v);
+}
+
+RigidPose interpolatePose(const RigidPose& start, const RigidPose& end, float t) {
+  return { glm::mix(start.position, end.position, t), glm::slerp(start.orientation, end.orientation, t) };
+}
+
+bool boxesOverlapYZ(const ClothCCDScratch::SweptBox& a, const ClothCCDScratch::SweptBox& b) {
+  return a.min.y <= b.max.y && b.min.y <= a.max.y && a.min.z <= b.max.z && b.min.z <= a.max.z;
+}
+
+ClothCCDScratch::SweptBox sweptBox(std::initializer_list<glm::vec3> points, float margin, uint32_t index,
+                                   uint8_t kind) {
+  glm::vec3 lo(std::numeric_limits<float>::max());
+  glm::vec3 hi(std::numeric_limits<float>::lowest());
+  for (const auto& p : points) {
+    lo = glm::min(lo, p);
+    hi = glm::max(hi, p);
+  }
+  return { lo - glm::vec3(margin), hi + glm::vec3(margin), index, kind };
+}
+
+} // namespace
+
+bool pointTriangleImpact(const glm::vec3& p0, const glm::vec3& p1,
+                         const std::array<glm::vec3, 3>& triangle0, const std::array<glm::vec3, 3>& triangle1,
+                         TimeOfImpact& impact) {
+  const glm::vec3& a0 = triangle0[0];
+  const glm::vec3& a1 = triangle1[0];
+  const glm::vec3 e1 = triangle0[1] - a0;
+  const glm::vec3 e2 = triangle0[2] - a0;
+  const glm::vec3 w = p0 - a0;
+  const auto cubic = coplanarityCubic(e1, (triangle1[1] - a1) - e1, e2, (triangle1[2] - a1) - e2, w, (p1 - a1) - w);
+
+  std::array<float, 3> roots {};
+  const int rootCount = cubicRootsInUnitInterval(cubic, roots);
+  for (int i = 0; i < rootCount; ++i) {
+    const float t = roots[i];
+    const glm::vec3 p = glm::mix(p0, p1, t);
+    glm::vec3 coordinates;
+    if (!barycentric(p, glm::mix(triangle0[0], triangle1[0], t), glm::mix(triangle0[1], triangle1[1], t),
+                     glm::mix(triangle0[2], triangle1[2], t), coordinates)) {
+      continue;
+    }
+    if (coordinates.x >= -kInsideTolerance && coordinates.y >= -kInsideTolerance &&
+        coordinates.z >= -kInsideTolerance) {
+      impact = { t, coordinates };
+      return true;
+    }
+  }
+  return false;
+}
+
+bool edgeEdgeImpact(const glm::vec3& p0, const glm::vec3& q0, const glm::vec3& p1, const glm::vec3& q1,
+                    const glm::vec3& r0, const glm::vec3& s0, const glm::vec3& r1, const glm::vec3& s1,
+                    TimeOfImpact& impact) {
+  const glm::vec3 e1 = q0 - p0;
+  const glm::vec3 e2 = s0 - r0;
+  const glm::vec3 w = r0 - p0;
+  const auto cubic = coplanarityCubic(e1, (q1 - p1) - e1, e2, (s1 - r1) - e2, w, (r1 - p1) - w);
+
+  std::array<float, 3> roots {};
+  const int rootCount = cubicRootsInUnitInterval(cubic, roots);
+  for (int i = 0; i < rootCount; ++i) {
+    const float t = roots[i];
+    const glm::vec3 p = glm::mix(p0, p1, t);
+    const glm::vec3 q = glm::mix(q0, q1, t);
+    const glm::vec3 r = glm::mix(r0, r1, t);
+    const glm::vec3 s = glm::mix(s0, s1, t);
+    const glm::vec2 params = closestSegmentParameters(p, q, r, s);
+    // Coplanar at t; the edges cross when their closest points meet
+    const float gap = glm::length(glm::mix(p, q, params.x) - glm::mix(r, s, params.y));
+    const float tolerance = kInsideTolerance * (glm::length(q - p) + glm::length(s - r));
+    if (gap <= tolerance) {
+      impact = { t, glm::vec3(params.x, params.y, 0.0f) };
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t solveClothCCD(std::span<ClothParticle> particles,
+                     const ClothTopology& topology,
+                     std::span<const ClothObstacle> obstacles,
+                     float stepBegin,
+                     float stepEnd,
+                     float thickness,
+                     ClothCCDScratch& scratch) {
+  if (particles.empty() || obstacles.empty()) {
+    return 0;
+  }
+
+  scratch.vertexStart.clear();
+  scratch.vertexEnd.clear();
+  scratch.triangles.clear();
+  scratch.boxes.clear();
+  scratch.activeCloth.clear();
+  scratch.activeTriangles.clear();
+  scratch.edgeTriangles.clear();
+  scratch.particleImpacts.assign(particles.size(), TimeOfImpact {});
+  scratch.particleTriangles.assign(particles.size(), std::numeric_limits<uint32_t>::max());
+
+  // Swept boxes of every free particle and every edge with a free end
+  glm::vec3 clothMin(std::numeric_limits<float>::max());
+  glm::vec3 clothMax(std::numeric_limits<float>::lowest());
+  for (uint32_t i = 0; i < particles.size(); ++i) {
+    const auto& p = particles[i];
+    if (p.isStatic()) continue;
+    scratch.boxes.push_back(sweptBox({ p.previousPosition, p.predictedPosition }, thickness, i, kParticleBox));
+    clothMin = glm::min(clothMin, scratch.boxes.back().min);
+    clothMax = glm::max(clothMax, scratch.boxes.back().max);
+  }
+  if (scratch.boxes.empty()) {
+    return 0;
+  }
+  for (uint32_t e = 0; e < topology.edges.size(); ++e) {
+    const auto& edge = topology.edges[e];
+    const auto& p = particles[edge.particleIndices[0]];
+    const auto& q = particles[edge.particleIndices[1]];
+    if (p.isStatic() && q.isStatic()) continue;
+    scratch.boxes.push_back(sweptBox({ p.previousPosition, p.predictedPosition, q.previousPosition,
+                                       q.predictedPosition }, thickness, e, kEdgeBox));
+  }
+
+  // Obstacle triangles swept over this part of the step, kept when they can
+  // reach the cloth at all
+  for (const auto& obstacle : obstacles) {
+    if (!obstacle.mesh) continue;
+    const auto& vertices = obstacle.mesh->getVertices();
+    const auto& indices = obstacle.mesh->getIndices();
+    const RigidPose begin = interpolatePose(obstacle.startPose, obstacle.endPose, stepBegin);
+    const RigidPose end = interpolatePose(obstacle.startPose, obstacle.endPose, stepEnd);
+    const uint32_t base = static_cast<uint32_t>(scratch.vertexStart.size());
+    for (const auto& v : vertices) {
+      scratch.vertexStart.push_back(begin.transformPoint(v.position));
+      scratch.vertexEnd.push_back(end.transformPoint(v.position));
+    }
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+      const uint32_t i0 = base + indices[t];
+      const uint32_t i1 = base + indices[t + 1];
+      const uint32_t i2 = base + indices[t + 2];
+      const auto box = sweptBox({ scratch.vertexStart[i0], scratch.vertexStart[i1], scratch.vertexStart[i2],
+                                  scratch.vertexEnd[i0], scratch.vertexEnd[i1], scratch.vertexEnd[i2] },
+                                thickness, static_cast<uint32_t>(scratch.triangles.size() / 3), kTriangleBox);
+      if (box.max.x < clothMin.x || box.max.y < clothMin.y || box.max.z < clothMin.z ||
+          box.min.x > clothMax.x || box.min.y > clothMax.y || box.min.z > clothMax.z) {
+        continue;
+      }
+      scratch.triangles.insert(scratch.triangles.end(), { i0, i1, i2 });
+      scratch.boxes.push_back(box);
+    }
+  }
+  if (scratch.triangles.empty()) {
+    return 0;
+  }
+
+  auto triangleAt = [&](uint32_t triangle, const std::vector<glm::vec3>& positions) {
+    return std::array<glm::vec3, 3> { positions[scratch.triangles[3 * triangle]],
+                                      positions[scratch.triangles[3 * triangle + 1]],
+                                      positions[scratch.triangles[3 * triangle + 2]] };
+  };
+  auto testPair = [&](const ClothCCDScratch::SweptBox& cloth, uint32_t triangle) {
+    if (cloth.kind == kEdgeBox) {
+      scratch.edgeTriangles.push_back({ cloth.index, triangle });
+      return;
+    }
+    const auto& p = particles[cloth.index];
+    TimeOfImpact impact;
+    if (pointTriangleImpact(p.previousPosition, p.predictedPosition, triangleAt(triangle, scratch.vertexStart),
+                            triangleAt(triangle, scratch.vertexEnd), impact) &&
+        impact.time < scratch.particleImpacts[cloth.index].time) {
+      scratch.particleImpacts[cloth.index] = impact;
+      scratch.particleTriangles[cloth.index] = triangle;
+    }
+  };
+
+  // Sweep and prune along x; boxes leave the active lists once the sweep
+  // passes their far end
+  std::sort(scratch.boxes.begin(), scratch.boxes.end(),
+            [](const auto& a, const auto& b) { return a.min.x < b.min.x; });
+  auto prune = [&](std::vector<uint32_t>& active, float x) {
+    std::erase_if(active, [&](uint32_t b) { return scratch.boxes[b].max.x < x; });
+  };
+  for (uint32_t b = 0; b < scratch.boxes.size(); ++b) {
+    const auto& box = scratch.boxes[b];
+    prune(scratch.activeCloth, box.min.x);
+    prune(scratch.activeTriangles, box.min.x);
+    if (box.kind == kTriangleBox) {
+      for (uint32_t other : scratch.activeCloth) {
+        if (boxesOverlapYZ(box, scratch.boxes[other])) testPair(scratch.boxes[other], box.index);
+      }
+      scratch.activeTriangles.push_back(b);
+    } else {
+      for (uint32_t other : scratch.activeTriangles) {
+        if (boxesOverlapYZ(box, scratch.boxes[other])) testPair(box, scratch.boxes[other].index);
+      }
+      scratch.activeCloth.push_back(b);
+    }
+  }
+
+  size_t resolved = 0;
+
+  // Each particle's first crossing puts it thickness off the triangle's end
+  // position, on the side it started from
+  for (uint32_t i = 0; i < particles.size(); ++i) {
+    const uint32_t triangle = scratch.particleTriangles[i];
+    if (triangle == std::numeric_limits<uint32_t>::max()) continue;
+    auto& p = particles[i];
+    const auto start = triangleAt(triangle, scratch.vertexStart);
+    const auto end = triangleAt(triangle, scratch.vertexEnd);
+    const glm::vec3 startNormal = glm::cross(start[1] - start[0], start[2] - start[0]);
+    const glm::vec3 endNormal = glm::cross(end[1] - end[0], end[2] - end[0]);
+    if (glm::dot(endNormal, endNormal) <= 1e-20f) continue;
+
+    const glm::vec3& c = scratch.particleImpacts[i].coordinates;
+    const glm::vec3 startPoint = c.x * start[0] + c.y * start[1] + c.z * start[2];
+    const glm::vec3 endPoint = c.x * end[0] + c.y * end[1] + c.z * end[2];
+    float side = glm::dot(startNormal, p.previousPosition - startPoint);
+    if (std::abs(side) <= 1e-12f) {
+      // Started on the plane: back out against the relative motion
+      side = -glm::dot(startNormal, (p.predictedPosition - p.previousPosition) - (endPoint - startPoint));
+    }
+    const float sign = side >= 0.0f ? 1.0f : -1.0f;
+    p.predictedPosition = endPoint + glm::normalize(endNormal) * (sign * thickness);
+    ++resolved;
+  }
+
+  // Cloth edges against the triangles' edges, with the particles' corrected ends
+  for (const auto& [edgeIndex, triangle] : scratch.edgeTriangles) {
+    const auto& edge = topology.edges[edgeIndex];
+    auto& p = particles[edge.particleIndices[0]];
+    auto& q = particles[edge.particleIndices[1]];
+    const auto start = triangleAt(triangle, scratch.vertexStart);
+    const auto end = triangleAt(triangle, scratch.vertexEnd);
+    for (int k = 0; k < 3; ++k) {
+      const int l = (k + 1) % 3;
+      TimeOfImpact impact;
+      if (!edgeEdgeImpact(p.previousPosition, q.previousPosition, p.predictedPosition, q.predictedPosition,
+                          start[k], start[l], end[k], end[l], impact)) {
+        continue;
+      }
+      const float u = impact.coordinates.x;
+      const float v = impact.coordinates.y;
+      const glm::vec3 clothStart = glm::mix(p.previousPosition, q.previousPosition, u);
+      const glm::vec3 obstacleStart = glm::mix(start[k], start[l], v);
+      glm::vec3 normal = glm::cross(q.previousPosition - p.previousPosition, start[l] - start[k]);
+      if (glm::dot(normal, normal) <= 1e-20f) {
+        normal = clothStart - obstacleStart;
+        if (glm::dot(normal, normal) <= 1e-20f) continue;
+      }
+      normal = glm::normalize(normal);
+      if (glm::dot(normal, clothStart - obstacleStart) < 0.0f) {
+        normal = -normal;
+      }
+
+      const glm::vec3 clothEnd = glm::mix(p.predictedPosition, q.predictedPosition, u);
+      const glm::vec3 obstacleEnd = glm::mix(end[k], end[l], v);
+      const float separation = glm::dot(clothEnd - obstacleEnd, normal);
+      if (separation >= thickness) continue;
+
+      const float wp = p.isStatic() ? 0.0f : p.invMass;
+      const float wq = q.isStatic() ? 0.0f : q.invMass;
+      const float denominator = (1.0f - u) * (1.0f - u) * wp + u * u * wq;
+      if (denominator <= 0.0f) continue;
+      const glm::vec3 correction = normal * ((thickness - separation) / denominator);
+      p.predictedPosition += (1.0f - u) * wp * correction;
+      q.predictedPosition += u * wq * correction;
+      ++resolved;
+    }
+  }
+
+  return resolved;
+}
+
+} // namespace physics
@@ -0,0 +1,86 @@
+#include <physics/ContactManifold.hpp>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+
+namespace physics {
+
+namespace {
+
+// Normals closer than this (cosine) count as the same contact plane
+constexpr float kNormalCosine = 0.95f;
+
+} // namespace
+
+void ContactManifold::refresh(const RigidPose& poseA, const RigidPose& poseB, float maxSeparation) {
+  size_t kept = 0;
+  for (size_t i = 0; i < count; ++i) {
+    Point p = points[i];
+    p.worldA = poseA.transformPoint(p.localA);
+    p.worldB = poseB.transformPoint(p.localB);
+    const glm::vec3 offset = p.worldA - p.worldB;
+    p.depth = glm::dot(offset, normal);
+    const glm::vec3 tangential = offset - p.depth * normal;
+    if (p.depth < -maxSeparation ||
+        glm::length2(tangential) > kPersistenceDistance * kPersistenceDistance) {
+      continue;
+    }
+    points[kept++] = p;
+  }
+  count = kept;
+}
+
+void ContactManifold::add(const RigidPose& poseA, const RigidPose& poseB,
+                          const glm::vec3& pointA, const glm::vec3& pointB, const glm::vec3& contactNormal) {
+  if (count > 0 && glm::dot(normal, contactNormal) < kNormalCosine) {
+    count = 0;
+  }
+  normal = contactNormal;
+
+  const Point fresh {
+      poseA.inverseTransformPoint(pointA), poseB.inverseTransformPoint(pointB),
+      pointA, pointB, glm::dot(pointA - pointB, contactNormal) };
+
+  // A new contact replaces the cached point it lands on
+  for (size_t i = 0; i < count; ++i) {
+    if (glm::length2(points[i].worldA - pointA) < kPersistenceDistance * kPersistenceDistance) {
+      points[i] = fresh;
+      return;
+    }
+  }
+  points[count++] = fresh;
+  if (count <= kMaxPoints) {
+    return;
+  }
+
+  // Five points: keep the new one and drop the old point whose removal leaves
+  // the widest quadrilateral, measured by its larger diagonal cross product
+  size_t dropped = 0;
+  float bestArea = -1.0f;
+  for (size_t drop = 0; drop < kMaxPoints; ++drop) {
+    std::array<glm::vec3, kMaxPoints> q;
+    size_t n = 0;
+    for (size_t i = 0; i <= kMaxPoints; ++i) {
+      if (i != drop) q[n++] = points[i].worldA;
+    }
+    const float area = std::max({ glm::length2(glm::cross(q[0] - q[1], q[2] - q[3])),
+                                  glm::length2(glm::cross(q[0] - q[2], q[1] - q[3])),
+                                  glm::length2(glm::cross(q[0] - q[3], q[1] - q[2])) });
+    if (area > bestArea) {
+      bestArea = area;
+      dropped = drop;
+    }
+  }
+  points[dropped] = points[kMaxPoints];
+  count = kMaxPoints;
+}
+
+void ContactManifold::appendContacts(const Collider* a, const Collider* b, std::vector<ContactInfo>& info) const {
+  for (size_t i = 0; i < count; ++i) {
+    info.emplace_back(0.5f * (points[i].worldA + points[i].worldB), normal, a, b, points[i].depth);
+  }
+}
+
+} // namespace physics
@@ -0,0 +1,16 @@
+#include <physics/ConvexCollider.hpp>
+#include <physics/Narrowphase.hpp>
+
+namespace physics {
+
+bool ConvexCollider::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
+  return collide(*this, collider, info);
+}
+
+glm::vec3 ConvexCollider::support(const glm::vec3& direction) const {
+  const glm::vec3 vertex = pose.transformPoint(hull->support(pose.inverseTransformVector(direction)));
+  const float length = glm::length(direction);
+  return length > 0.0f && margin > 0.0f ? vertex + direction * (margin / length) : vertex;
+}
+
+} // namespace physics
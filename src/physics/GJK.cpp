@@ -0,0 +1,327 @@
+#include <physics/GJK.hpp>
+#include <physics/BoxCollider.hpp>
+#include <physics/CapsuleCollider.hpp>
+#include <physics/ConvexCollider.hpp>
+#include <physics/SphereCollider.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace physics {
+
+namespace {
+
+constexpr float kEpsilon = 1e-10f;
+constexpr int kMaxGJKIterations = 64;
+// EPA stops once the support along the nearest face's normal gains less than
+// this, or the polytope is full
+constexpr float kEPATolerance = 1e-4f;
+constexpr size_t kMaxEPAVertices = 64;
+constexpr size_t kMaxEPAFaces = 2 * kMaxEPAVertices;
+
+// Point of the Minkowski difference a - b, with the shape points it came from
+struct SupportVertex {
+  glm::vec3 w;
+  glm::vec3 a;
+  glm::vec3 b;
+};
+
+SupportVertex minkowskiSupport(const Collider& a, const Collider& b, const glm::vec3& direction) {
+  const glm::vec3 pa = supportPoint(a, direction);
+  const glm::vec3 pb = supportPoint(b, -direction);
+  return { pa - pb, pa, pb };
+}
+
+bool sameDirection(const glm::vec3& v, const glm::vec3& direction) {
+  return glm::dot(v, direction) > 0.0f;
+}
+
+glm::vec3 perpendicular(const glm::vec3& v) {
+  return glm::cross(v, std::abs(v.x) < 0.57f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+// Simplex with its newest vertex first
+struct Simplex {
+  std::array<SupportVertex, 4> v;
+  int size = 0;
+
+  void set(std::initializer_list<SupportVertex> vertices) {
+    size = 0;
+    for (const auto& vertex : vertices) {
+      v[size++] = vertex;
+    }
+  }
+};
+
+// Each case reduces the simplex to the feature nearest the origin and points
+// direction from that feature toward it (Muratori's GJK case analysis)
+bool lineCase(Simplex& s, glm::vec3& direction) {
+  const SupportVertex a = s.v[0];
+  const SupportVertex b = s.v[1];
+  const glm::vec3 ab = b.w - a.w;
+  const glm::vec3 ao = -a.w;
+  if (sameDirection(ab, ao)) {
+    direction = glm::cross(glm::cross(ab, ao), ab);
+    if (glm::dot(direction, direction) < kEpsilon) {
+      // The origin lies on the segment: search off to any side
+      direction = perpendicular(ab);
+    }
+  } else {
+    s.set({ a });
+    direction = ao;
+  }
+  return false;
+}
+
+bool triangleCase(Simplex& s, glm::vec3& direction) {
+  const SupportVertex a = s.v[0];
+  const SupportVertex b = s.v[1];
+  const SupportVertex c = s.v[2];
+  const glm::vec3 ab = b.w - a.w;
+  const glm::vec3 ac = c.w - a.w;
+  const glm::vec3 ao = -a.w;
+  const glm::vec3 abc = glm::cross(ab, ac);
+  if (glm::dot(abc, abc) < kEpsilon) {
+    s.set({ a, b });
+    return lineCase(s, direction);
+  }
+
+  if (sameDirection(glm::cross(abc, ac), ao)) {
+    if (sameDirection(ac, ao)) {
+      s.set({ a, c });
+      direction = glm::cross(glm::cross(ac, ao), ac);
+    } else {
+      s.set({ a, b });
+      return lineCase(s, direction);
+    }
+  } else if (sameDirection(glm::cross(ab, abc), ao)) {
+    s.set({ a, b });
+    return lineCase(s, direction);
+  } else if (sameDirection(abc, ao)) {
+    direction = abc;
+  } else {
+    s.set({ a, c, b });
+    direction = -abc;
+  }
+  return false;
+}
+
+bool tetrahedronCase(Simplex& s, glm::vec3& direction) {
+  const SupportVertex a = s.v[0];
+  const SupportVertex b = s.v[1];
+  const SupportVertex c = s.v[2];
+  const SupportVertex d = s.v[3];
+  const glm::vec3 ab = b.w - a.w;
+  const glm::vec3 ac = c.w - a.w;
+  const glm::vec3 ad = d.w - a.w;
+  const glm::vec3 ao = -a.w;
+
+  if (sameDirection(glm::cross(ab, ac), ao)) {
+    s.set({ a, b, c });
+    return triangleCase(s, direction);
+  }
+  if (sameDirection(glm::cross(ac, ad), ao)) {
+    s.set({ a, c, d });
+    return triangleCase(s, direction);
+  }
+  if (sameDirection(glm::cross(ad, ab), ao)) {
+    s.set({ a, d, b });
+    return triangleCase(s, direction);
+  }
+  return true;
+}
+
+bool nextSimplex(Simplex& s, glm::vec3& direction) {
+  switch (s.size) {
+    case 2: return lineCase(s, direction);
+    case 3: return triangleCase(s, direction);
+    case 4: return tetrahedronCase(s, direction);
+    default: return false;
+  }
+}
+
+struct EPAFace {
+  std::array<uint32_t, 3> v;
+  glm::vec3 normal;
+  float distance;
+};
+
+// Face with an outward unit normal; the origin is inside the polytope, so a
+// face whose plane lies behind it is wound the wrong way
+EPAFace makeFace(std::span<const SupportVertex> vertices, uint32_t i, uint32_t j, uint32_t k) {
+  glm::vec3 normal = glm::cross(vertices[j].w - vertices[i].w, vertices[k].w - vertices[i].w);
+  const float length = glm::length(normal);
+  if (length < kEpsilon) {
+    return { { i, j, k }, glm::vec3(0.0f), std::numeric_limits<float>::max() };
+  }
+  normal /= length;
+  float distance = glm::dot(normal, vertices[i].w);
+  if (distance < 0.0f) {
+    return { { i, k, j }, -normal, -distance };
+  }
+  return { { i, j, k }, normal, distance };
+}
+
+std::optional<Penetration> expandPolytope(const Simplex& simplex, const Collider& a, const Collider& b) {
+  std::array<SupportVertex, kMaxEPAVertices> vertices;
+  for (int i = 0; i < 4; ++i) {
+    vertices[i] = simplex.v[i];
+  }
+  size_t vertexCount = 4;
+
+  const glm::vec3 ab = vertices[1].w - vertices[0].w;
+  const glm::vec3 ac = vertices[2].w - vertices[0].w;
+  const glm::vec3 ad = vertices[3].w - vertices[0].w;
+  if (std::abs(glm::dot(ab, glm::cross(ac, ad))) < kEpsilon) {
+    return std::nullopt;
+  }
+
+  std::array<EPAFace, kMaxEPAFaces> faces;
+  size_t faceCount = 0;
+  faces[faceCount++] = makeFace(vertices, 0, 1, 2);
+  faces[faceCount++] = makeFace(vertices, 0, 3, 1);
+  faces[faceCount++] = makeFace(vertices, 0, 2, 3);
+  faces[faceCount++] = makeFace(vertices, 1, 3, 2);
+
+  std::array<std::array<uint32_t, 2>, kMaxEPAFaces> horizon;
+  size_t nearest = 0;
+  while (true) {
+    nearest = 0;
+    for (size_t f = 1; f < faceCount; ++f) {
+      if (faces[f].distance < faces[nearest].distance) {
+        nearest = f;
+      }
+    }
+    const EPAFace face = faces[nearest];
+    const SupportVertex p = minkowskiSupport(a, b, face.normal);
+    if (glm::dot(p.w, face.normal) - face.distance < kEPATolerance || vertexCount == kMaxEPAVertices) {
+      break;
+    }
+
+    // Remove every face the new vertex sees; the edges they do not share form
+    // the horizon the new faces fan out from
+    const auto newVertex = static_cast<uint32_t>(vertexCount);
+    vertices[vertexCount++] = p;
+    size_t horizonCount = 0;
+    for (size_t f = 0; f < faceCount;) {
+      if (glm::dot(faces[f].normal, p.w - vertices[faces[f].v[0]].w) <= 0.0f) {
+        ++f;
+        continue;
+      }
+      for (int e = 0; e < 3; ++e) {
+        const std::array<uint32_t, 2> edge = { faces[f].v[e], faces[f].v[(e + 1) % 3] };
+        const auto twin = std::find_if(horizon.begin(), horizon.begin() + horizonCount, [&](const auto& other) {
+          return other[0] == edge[1] && other[1] == edge[0];
+        });
+        if (twin != horizon.begin() + horizonCount) {
+          *twin = horizon[--horizonCount];
+        } else {
+          horizon[horizonCount++] = edge;
+        }
+      }
+      faces[f] = faces[--faceCount];
+    }
+    if (faceCount + horizonCount > kMaxEPAFaces) {
+      return std::nullopt;
+    }
+    for (size_t e = 0; e < horizonCount; ++e) {
+      faces[faceCount++] = makeFace(vertices, horizon[e][0], horizon[e][1], newVertex);
+    }
+    if (faceCount == 0) {
+      return std::nullopt;
+    }
+  }
+
+  // Barycentric coordinates of the origin's projection onto the nearest face
+  // carry over to the shape points behind its vertices
+  const EPAFace& face = faces[nearest];
+  if (face.distance == std::numeric_limits<float>::max()) {
+    return std::nullopt;
+  }
+  const SupportVertex& v0 = vertices[face.v[0]];
+  const SupportVertex& v1 = vertices[face.v[1]];
+  const SupportVertex& v2 = vertices[face.v[2]];
+  const glm::vec3 projected = face.normal * face.distance;
+  const glm::vec3 e0 = v1.w - v0.w;
+  const glm::vec3 e1 = v2.w - v0.w;
+  const glm::vec3 e2 = projected - v0.w;
+  const float d00 = glm::dot(e0, e0);
+  const float d01 = glm::dot(e0, e1);
+  const float d11 = glm::dot(e1, e1);
+  const float d20 = glm::dot(e2, e0);
+  const float d21 = glm::dot(e2, e1);
+  const float denominator = d00 * d11 - d01 * d01;
+  float u = 1.0f / 3.0f;
+  float v = 1.0f / 3.0f;
+  if (std::abs(denominator) > kEpsilon) {
+    u = (d11 * d20 - d01 * d21) / denominator;
+    v = (d00 * d21 - d01 * d20) / denominator;
+  }
+  const float w0 = 1.0f - u - v;
+
+  Penetration result;
+  result.normal = face.normal;
+  result.depth = face.distance;
+  result.pointA = w0 * v0.a + u * v1.a + v * v2.a;
+  result.pointB = w0 * v0.b + u * v1.b + v * v2.b;
+  return result;
+}
+
+} // namespace
+
+glm::vec3 supportPoint(const Collider& collider, const glm::vec3& direction) {
+  const float length = glm::length(direction);
+  const glm::vec3 unit = length > 0.0f ? direction / length : glm::vec3(0.0f);
+  switch (collider.getType()) {
+    case ColliderType::Sphere: {
+      const auto& sphere = static_cast<const SphereCollider&>(collider);
+      return sphere.center + sphere.radius * unit;
+    }
+    case ColliderType::Box: {
+      const auto& box = static_cast<const BoxCollider&>(collider);
+      const glm::vec3 local = glm::conjugate(box.orientation) * direction;
+      const glm::vec3 corner(local.x < 0.0f ? -box.halfExtents.x : box.halfExtents.x,
+                             local.y < 0.0f ? -box.halfExtents.y : box.halfExtents.y,
+                             local.z < 0.0f ? -box.halfExtents.z : box.halfExtents.z);
+      return box.center + box.orientation * corner;
+    }
+    case ColliderType::Capsule: {
+      const auto& capsule = static_cast<const CapsuleCollider&>(collider);
+      const glm::vec3 a = capsule.pointA();
+      const glm::vec3 b = capsule.pointB();
+      return (glm::dot(b - a, direction) >= 0.0f ? b : a) + capsule.radius * unit;
+    }
+    case ColliderType::Convex:
+      return static_cast<const ConvexCollider&>(collider).support(direction);
+    default:
+      return glm::vec3(0.0f);
+  }
+}
+
+std::optional<Penetration> penetration(const Collider& a, const Collider& b) {
+  Simplex simplex;
+  simplex.set({ minkowskiSupport(a, b, glm::vec3(1.0f, 0.0f, 0.0f)) });
+  glm::vec3 direction = -simplex.v[0].w;
+  for (int iteration = 0; iteration < kMaxGJKIterations; ++iteration) {
+    if (glm::dot(direction, direction) < kEpsilon) {
+      // The origin sits on the simplex: the shapes only touch
+      return std::nullopt;
+    }
+    const SupportVertex p = minkowskiSupport(a, b, direction);
+    if (glm::dot(p.w, direction) <= 0.0f) {
+      return std::nullopt;
+    }
+    std::copy_backward(simplex.v.begin(), simplex.v.begin() + simplex.size, simplex.v.begin() + simplex.size + 1);
+    simplex.v[0] = p;
+    ++simplex.size;
+    if (nextSimplex(simplex, direction)) {
+      return expandPolytope(simplex, a, b);
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace physics
@@ -0,0 +1,491 @@
+#include <physics/HeightfieldCollider.hpp>
+
+#include <app/modeling/Mesh.hpp>
+#include <physics/BoxCollider.hpp>
+#include <physics/CapsuleCollider.hpp>
+#include <physics/ConvexCollider.hpp>
+#include <physics/Narrowphase.hpp>
+#include <physics/SphereCollider.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace physics {
+
+namespace {
+
+constexpr float kEpsilon = 1e-8f;
+
+// Sorted distinct values, merging any that lie within tolerance of the first
+// value of their group
+std::vector<float> distinctValues(std::vector<float> values, float tolerance) {
+  std::sort(values.begin(), values.end());
+  std::vector<float> distinct;
+  for (float v : values) {
+    if (distinct.empty() || v - distinct.back() > tolerance) {
+      distinct.push_back(v);
+    }
+  }
+  return distinct;
+}
+
+// Index of value on the uniform axis first + k * step, or -1 when it is not
+// within tolerance of a grid line
+int64_t gridIndex(float value, float first, float step, size_t count, float tolerance) {
+  const float k = std::round((value - first) / step);
+  if (k < 0.0f || k >= static_cast<float>(count) || std::abs(first + k * step - value) > tolerance) {
+    return -1;
+  }
+  return static_cast<int64_t>(k);
+}
+
+// Ray parameter range inside [boundsMin, boundsMax], clipped to [tMin, tMax]
+bool clipToBox(const glm::vec3& origin, const glm::vec3& direction,
+               const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+               float& tMin, float& tMax) {
+  for (int axis = 0; axis < 3; ++axis) {
+    if (std::abs(direction[axis]) < kEpsilon) {
+      if (origin[axis] < boundsMin[axis] || origin[axis] > boundsMax[axis]) {
+        return false;
+      }
+      continue;
+    }
+    const float inv = 1.0f / direction[axis];
+    float t0 = (boundsMin[axis] - origin[axis]) * inv;
+    float t1 = (boundsMax[axis] - origin[axis]) * inv;
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+    if (tMin > tMax) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Two-sided ray-triangle test (Moller-Trumbore)
+bool intersectTriangle(const glm::vec3& origin, const glm::vec3& direction,
+                       const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float& t) {
+  const glm::vec3 ab = b - a;
+  const glm::vec3 ac = c - a;
+  const glm::vec3 p = glm::cross(direction, ac);
+  const float det = glm::dot(ab, p);
+  if (std::abs(det) < kEpsilon) {
+    return false;
+  }
+  const float invDet = 1.0f / det;
+  const glm::vec3 s = origin - a;
+  const float u = glm::dot(s, p) * invDet;
+  if (u < 0.0f || u > 1.0f) {
+    return false;
+  }
+  const glm::vec3 q = glm::cross(s, ab);
+  const float v = glm::dot(direction, q) * invDet;
+  if (v < 0.0f || u + v > 1.0f) {
+    return false;
+  }
+  t = glm::dot(ac, q) * invDet;
+  return t >= 0.0f;
+}
+
+} // namespace
+
+std::optional<HeightfieldCollider> HeightfieldCollider::fromHeights(std::span<const uint16_t> heights,
+                                                                    uint32_t columns, uint32_t rows,
+                                                                    glm::vec2 spacing, float heightScale,
+                                                                    float heightOffset) {
+  if (columns < 2 || rows < 2 || heights.size() != static_cast<size_t>(columns) * rows ||
+      spacing.x <= 0.0f || spacing.y <= 0.0f) {
+    return std::nullopt;
+  }
+
+  HeightfieldCollider field;
+  field.columns = columns;
+  field.rows = rows;
+  field.spacing = spacing;
+  field.heightScale = heightScale;
+  field.heightOffset = heightOffset;
+  field.heights.assign(heights.begin(), heights.end());
+  return field;
+}
+
+std::optional<HeightfieldCollider> HeightfieldCollider::fromMesh(const sauce::modeling::Mesh& mesh) {
+  const auto& vertices = mesh.getVertices();
+  if (vertices.size() < 4) {
+    return std::nullopt;
+  }
+
+  glm::vec3 boundsMin(std::numeric_limits<float>::max());
+  glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+  std::vector<float> xs;
+  std::vector<float> zs;
+  xs.reserve(vertices.size());
+  zs.reserve(vertices.size());
+  for (const auto& v : vertices) {
+    boundsMin = glm::min(boundsMin, v.position);
+    boundsMax = glm::max(boundsMax, v.position);
+    xs.push_back(v.position.x);
+    zs.push_back(v.position.z);
+  }
+
+  const float tolerance = 1e-4f * std::max(boundsMax.x - boundsMin.x, boundsMax.z - boundsMin.z);
+  const std::vector<float> gridX = distinctValues(std::move(xs), tolerance);
+  const std::vector<float> gridZ = distinctValues(std::move(zs), tolerance);
+  if (gridX.size() < 2 || gridZ.size() < 2 || gridX.size() * gridZ.size() > vertices.size()) {
+    return std::nullopt;
+  }
+  const float stepX = (gridX.back() - gridX.front()) / static_cast<float>(gridX.size() - 1);
+  const float stepZ = (gridZ.back() - gridZ.front()) / static_cast<float>(gridZ.size() - 1);
+
+  // Every grid position needs exactly one height; duplicated vertices (seams)
+  // must agree on it
+  const float heightRange = boundsMax.y - boundsMin.y;
+  const float heightScale = heightRange > kEpsilon ? heightRange / 65535.0f : 1.0f;
+  std::vector<uint16_t> heights(gridX.size() * gridZ.size());
+  std::vector<uint8_t> filled(heights.size(), 0);
+  for (const auto& v : vertices) {
+    const int64_t i = gridIndex(v.position.x, gridX.front(), stepX, gridX.size(), tolerance);
+    const int64_t j = gridIndex(v.position.z, gridZ.front(), stepZ, gridZ.size(), tolerance);
+    if (i < 0 || j < 0) {
+      return std::nullopt;
+    }
+    const size_t slot = static_cast<size_t>(j) * gridX.size() + static_cast<size_t>(i);
+    const auto quantized = static_cast<uint16_t>(std::lround((v.position.y - boundsMin.y) / heightScale));
+    if (filled[slot] && heights[slot] != quantized) {
+      return std::nullopt;
+    }
+    heights[slot] = quantized;
+    filled[slot] = 1;
+  }
+  if (std::find(filled.begin(), filled.end(), 0) != filled.end()) {
+    return std::nullopt;
+  }
+
+  auto field = fromHeights(heights, static_cast<uint32_t>(gridX.size()), static_cast<uint32_t>(gridZ.size()),
+                           glm::vec2(stepX, stepZ), heightScale, boundsMin.y);
+  if (field) {
+    field->origin = glm::vec2(gridX.front(), gridZ.front());
+  }
+  return field;
+}
+
+HeightfieldCollider::Surface HeightfieldCollider::cellSurface(uint32_t i, uint32_t j, float fx, float fz) const {
+  const float h00 = sampleHeight(i, j);
+  const float h10 = sampleHeight(i + 1, j);
+  const float h01 = sampleHeight(i, j + 1);
+  const float h11 = sampleHeight(i + 1, j + 1);
+
+  // Slopes of the triangle's plane y = h00 + a * fx + b * fz
+  float a;
+  float b;
+  if (fx * spacing.y >= fz * spacing.x) {
+    a = (h10 - h00) / spacing.x;
+    b = (h11 - h10) / spacing.y;
+  } else {
+    a = (h11 - h01) / spacing.x;
+    b = (h01 - h00) / spacing.y;
+  }
+  return { h00 + a * fx + b * fz, glm::normalize(glm::vec3(-a, 1.0f, -b)) };
+}
+
+std::optional<HeightfieldCollider::Surface> HeightfieldCollider::surface(float x, float z) const {
+  if (heights.empty()) {
+    return std::nullopt;
+  }
+  const float u = (x - origin.x) / spacing.x;
+  const float v = (z - origin.y) / spacing.y;
+  if (!(u >= 0.0f && v >= 0.0f && u <= static_cast<float>(columns - 1) && v <= static_cast<float>(rows - 1))) {
+    return std::nullopt;
+  }
+  const uint32_t i = std::min(static_cast<uint32_t>(u), columns - 2);
+  const uint32_t j = std::min(static_cast<uint32_t>(v), rows - 2);
+  return cellSurface(i, j, (u - static_cast<float>(i)) * spacing.x, (v - static_cast<float>(j)) * spacing.y);
+}
+
+bool HeightfieldCollider::pointDistance(const glm::vec3& p, float& distance, glm::vec3& normal) const {
+  const glm::vec3 local = pose.inverseTransformPoint(p);
+  const auto under = surface(local.x, local.z);
+  if (!under) {
+    return false;
+  }
+  distance = (local.y - under->height) * under->normal.y;
+  normal = pose.transformVector(under->normal);
+  return true;
+}
+
+bool HeightfieldCollider::pointContact(const glm::vec3& p, float radius, const Collider* other,
+                                       std::vector<ContactInfo>& info) const {
+  float distance;
+  glm::vec3 normal;
+  if (!pointDistance(p, distance, normal) || distance > radius) {
+    return false;
+  }
+  info.emplace_back(p - normal * ((radius + distance) * 0.5f), normal, this, other, radius - distance);
+  return true;
+}
+
+bool HeightfieldCollider::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
+  switch (collider.getType()) {
+    case ColliderType::Sphere: {
+      const auto& sphere = static_cast<const SphereCollider&>(collider);
+      return pointContact(sphere.center, sphere.radius, &collider, info);
+    }
+    case ColliderType::Capsule: {
+      // End caps, as against a plane
+      const auto& capsule = static_cast<const CapsuleCollider&>(collider);
+      bool hit = pointContact(capsule.pointA(), capsule.radius, &collider, info);
+      hit = pointContact(capsule.pointB(), capsule.radius, &collider, info) || hit;
+      return hit;
+    }
+    case ColliderType::Box: {
+      const auto& box = static_cast<const BoxCollider&>(collider);
+      const size_t first = info.size();
+      bool hit = false;
+      for (int corner = 0; corner < 8; ++corner) {
+        const glm::vec3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+        hit = pointContact(box.center + box.orientation * (sign * box.halfExtents), 0.0f, &collider, info) || hit;
+      }
+      reduceManifold(info, first);
+      return hit;
+    }
+    case ColliderType::Convex: {
+      const auto& convex = static_cast<const ConvexCollider&>(collider);
+      const size_t first = info.size();
+      bool hit = false;
+      for (const auto& vertex : convex.hull->vertices) {
+        hit = pointContact(convex.pose.transformPoint(vertex), convex.margin, &collider, info) || hit;
+      }
+      reduceManifold(info, first);
+      return hit;
+    }
+    default:
+      // Planes are static scenery, and terrain against hierarchies is not supported
+      return false;
+  }
+}
+
+void HeightfieldCollider::buildMipPyramid() {
+  mipLevels.clear();
+  if (heights.empty()) {
+    return;
+  }
+
+  MipLevel cells;
+  cells.columns = columns - 1;
+  cells.rows = rows - 1;
+  cells.bounds.resize(static_cast<size_t>(cells.columns) * cells.rows);
+  for (uint32_t j = 0; j < cells.rows; ++j) {
+    for (uint32_t i = 0; i < cells.columns; ++i) {
+      const std::array<uint16_t, 4> corners = {
+          heights[j * columns + i], heights[j * columns + i + 1],
+          heights[(j + 1) * columns + i], heights[(j + 1) * columns + i + 1] };
+      const auto [lo, hi] = std::minmax_element(corners.begin(), corners.end());
+      cells.bounds[j * cells.columns + i] = { *lo, *hi };
+    }
+  }
+  mipLevels.push_back(std::move(cells));
+
+  while (mipLevels.back().columns > 1 || mipLevels.back().rows > 1) {
+    const MipLevel& below = mipLevels.back();
+    MipLevel level;
+    level.columns = (below.columns + 1) / 2;
+    level.rows = (below.rows + 1) / 2;
+    level.bounds.resize(static_cast<size_t>(level.columns) * level.rows);
+    for (uint32_t j = 0; j < level.rows; ++j) {
+      for (uint32_t i = 0; i < level.columns; ++i) {
+        MinMax merged { std::numeric_limits<uint16_t>::max(), 0 };
+        for (uint32_t cj = 2 * j; cj < std::min(2 * j + 2, below.rows); ++cj) {
+          for (uint32_t ci = 2 * i; ci < std::min(2 * i + 2, below.columns); ++ci) {
+            const MinMax& child = below.bounds[cj * below.columns + ci];
+            merged.min = std::min(merged.min, child.min);
+            merged.max = std::max(merged.max, child.max);
+          }
+        }
+        level.bounds[j * level.columns + i] = merged;
+      }
+    }
+    mipLevels.push_back(std::move(level));
+  }
+}
+
+bool HeightfieldCollider::intersectCell(uint32_t i, uint32_t j, const glm::vec3& rayOrigin,
+                                        const glm::vec3& direction, float& t, glm::vec3& normal) const {
+  const auto corner = [&](uint32_t ci, uint32_t cj) {
+    return glm::vec3(origin.x + static_cast<float>(ci) * spacing.x, sampleHeight(ci, cj),
+                     origin.y + static_cast<float>(cj) * spacing.y);
+  };
+  const glm::vec3 p00 = corner(i, j);
+  const glm::vec3 p10 = corner(i + 1, j);
+  const glm::vec3 p01 = corner(i, j + 1);
+  const glm::vec3 p11 = corner(i + 1, j + 1);
+
+  bool hit = false;
+  float tTriangle;
+  if (intersectTriangle(rayOrigin, direction, p00, p10, p11, tTriangle) && tTriangle < t) {
+    t = tTriangle;
+    normal = glm::normalize(glm::cross(p11 - p00, p10 - p00));
+    hit = true;
+  }
+  if (intersectTriangle(rayOrigin, direction, p00, p11, p01, tTriangle) && tTriangle < t) {
+    t = tTriangle;
+    normal = glm::normalize(glm::cross(p01 - p00, p11 - p00));
+    hit = true;
+  }
+  return hit;
+}
+
+bool HeightfieldCollider::raycastCells(const glm::vec3& rayOrigin, const glm::vec3& direction, float maxT,
+                                       float& t, glm::vec3& normal) const {
+  // Clip to the grid's footprint, then step cell by cell (Amanatides-Woo)
+  const glm::vec3 boundsMin(origin.x, std::numeric_limits<float>::lowest(), origin.y);
+  const glm::vec3 boundsMax(origin.x + static_cast<float>(columns - 1) * spacing.x,
+                            std::numeric_limits<float>::max(),
+                            origin.y + static_cast<float>(rows - 1) * spacing.y);
+  float tEnter = 0.0f;
+  float tExit = maxT;
+  if (!clipToBox(rayOrigin, direction, boundsMin, boundsMax, tEnter, tExit)) {
+    return false;
+  }
+
+  const glm::vec3 entry = rayOrigin + tEnter * direction;
+  int64_t i = std::clamp<int64_t>(static_cast<int64_t>(std::floor((entry.x - origin.x) / spacing.x)), 0, columns - 2);
+  int64_t j = std::clamp<int64_t>(static_cast<int64_t>(std::floor((entry.z - origin.y) / spacing.y)), 0, rows - 2);
+
+  const int stepI = direction.x > 0.0f ? 1 : -1;
+  const int stepJ = direction.z > 0.0f ? 1 : -1;
+  const auto nextBoundary = [](float start, float cellStart, float size, float d, int step) {
+    if (std::abs(d) < kEpsilon) {
+      return std::numeric_limits<float>::infinity();
+    }
+    const float boundary = cellStart + (step > 0 ? size : 0.0f);
+    return (boundary - start) / d;
+  };
+  float tNextI = nextBoundary(rayOrigin.x, origin.x + static_cast<float>(i) * spacing.x, spacing.x, direction.x, stepI);
+  float tNextJ = nextBoundary(rayOrigin.z, origin.y + static_cast<float>(j) * spacing.y, spacing.y, direction.z, stepJ);
+  const float tDeltaI = std::abs(direction.x) < kEpsilon ? std::numeric_limits<float>::infinity() : spacing.x / std::abs(direction.x);
+  const float tDeltaJ = std::abs(direction.z) < kEpsilon ? std::numeric_limits<float>::infinity() : spacing.y / std::abs(direction.z);
+
+  t = maxT;
+  while (true) {
+    // Triangles lie inside their cell's footprint, so the first cell with a
+    // hit holds the closest one
+    if (intersectCell(static_cast<uint32_t>(i), static_cast<uint32_t>(j), rayOrigin, direction, t, normal)) {
+      return true;
+    }
+    if (tNextI < tNextJ) {
+      if (tNextI > tExit) break;
+      i += stepI;
+      tNextI += tDeltaI;
+    } else {
+      if (tNextJ > tExit) break;
+      j += stepJ;
+      tNextJ += tDeltaJ;
+    }
+    if (i < 0 || j < 0 || i > static_cast<int64_t>(columns) - 2 || j > static_cast<int64_t>(rows) - 2) {
+      break;
+    }
+  }
+  return false;
+}
+
+bool HeightfieldCollider::raycastPyramid(const glm::vec3& rayOrigin, const glm::vec3& direction, float maxT,
+                                         float& t, glm::vec3& normal) const {
+  struct Node {
+    uint32_t level;
+    uint32_t i;
+    uint32_t j;
+  };
+  // Each level pushes at most four children, three of which wait below the
+  // one popped next
+  std::array<Node, 4 * 32> stack;
+  size_t stackSize = 0;
+
+  const MipLevel& top = mipLevels.back();
+  for (uint32_t j = 0; j < top.rows; ++j) {
+    for (uint32_t i = 0; i < top.columns; ++i) {
+      stack[stackSize++] = { static_cast<uint32_t>(mipLevels.size() - 1), i, j };
+    }
+  }
+
+  const uint32_t cellColumns = columns - 1;
+  const uint32_t cellRows = rows - 1;
+  bool hit = false;
+  t = maxT;
+  while (stackSize > 0) {
+    const Node node = stack[--stackSize];
+    const MipLevel& level = mipLevels[node.level];
+    const MinMax bounds = level.bounds[node.j * level.columns + node.i];
+
+    // Cells covered by the node
+    const uint32_t size = 1u << node.level;
+    const uint32_t i0 = node.i * size;
+    const uint32_t j0 = node.j * size;
+    const uint32_t i1 = std::min(i0 + size, cellColumns);
+    const uint32_t j1 = std::min(j0 + size, cellRows);
+    const glm::vec3 boxMin(origin.x + static_cast<float>(i0) * spacing.x,
+                           heightOffset + heightScale * static_cast<float>(bounds.min),
+                           origin.y + static_cast<float>(j0) * spacing.y);
+    const glm::vec3 boxMax(origin.x + static_cast<float>(i1) * spacing.x,
+                           heightOffset + heightScale * static_cast<float>(bounds.max),
+                           origin.y + static_cast<float>(j1) * spacing.y);
+    float tMin = 0.0f;
+    float tMax = t;
+    if (!clipToBox(rayOrigin, direction, glm::min(boxMin, boxMax), glm::max(boxMin, boxMax), tMin, tMax)) {
+      continue;
+    }
+
+    if (node.level == 0) {
+      hit = intersectCell(node.i, node.j, rayOrigin, direction, t, normal) || hit;
+      continue;
+    }
+
+    // Children nearest the ray origin are pushed last so they are popped first
+    const uint32_t nearI = direction.x >= 0.0f ? 0 : 1;
+    const uint32_t nearJ = direction.z >= 0.0f ? 0 : 1;
+    const MipLevel& below = mipLevels[node.level - 1];
+    for (uint32_t k = 0; k < 4; ++k) {
+      const uint32_t ci = 2 * node.i + (nearI ^ ((k & 1) ? 0u : 1u));
+      const uint32_t cj = 2 * node.j + (nearJ ^ ((k & 2) ? 0u : 1u));
+      if (ci < below.columns && cj < below.rows) {
+        stack[stackSize++] = { node.level - 1, ci, cj };
+      }
+    }
+  }
+  return hit;
+}
+
+bool HeightfieldCollider::raycast(const glm::vec3& rayOrigin, const glm::vec3& direction, float maxDistance,
+                                  float& distance, glm::vec3& normal) const {
+  if (heights.empty()) {
+    return false;
+  }
+
+  // The pose is rigid, so distances along the ray carry over unchanged
+  const glm::vec3 localOrigin = pose.inverseTransformPoint(rayOrigin);
+  const glm::vec3 localDirection = pose.inverseTransformVector(direction);
+  glm::vec3 localNormal;
+  float t;
+  const bool hit = mipLevels.empty()
+      ? raycastCells(localOrigin, localDirection, maxDistance, t, localNormal)
+      : raycastPyramid(localOrigin, localDirection, maxDistance, t, localNormal);
+  if (!hit) {
+    return false;
+  }
+  distance = t;
+  normal = pose.transformVector(localNormal);
+  return true;
+}
+
+size_t HeightfieldCollider::getMemoryBytes() const {
+  size_t bytes = heights.size() * sizeof(uint16_t);
+  for (const auto& level : mipLevels) {
+    bytes += level.bounds.size() * sizeof(MinMax);
+  }
+  return bytes;
+}
+
+} // namespace physics
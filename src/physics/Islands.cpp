@@ -0,0 +1,76 @@
+#include <physics/Islands.hpp>
+
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace physics {
+
+void UnionFind::reset(size_t count) {
+  parent.resize(count);
+  std::iota(parent.begin(), parent.end(), 0u);
+  size.assign(count, 1u);
+}
+
+uint32_t UnionFind::find(uint32_t i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+void UnionFind::unite(uint32_t a, uint32_t b) {
+  a = find(a);
+  b = find(b);
+  if (a == b) {
+    return;
+  }
+  if (size[a] < size[b]) {
+    std::swap(a, b);
+  }
+  parent[b] = a;
+  size[a] += size[b];
+}
+
+std::pmr::vector<Island> buildIslands(size_t bodyCount,
+                                      std::span<const BodyPair> pairs,
+                                      std::span<const uint8_t> isStatic,
+                                      std::pmr::memory_resource* resource) {
+  UnionFind sets(bodyCount, resource);
+
+  for (const auto& pair : pairs) {
+    if (!isStatic[pair.a] && !isStatic[pair.b]) {
+      sets.unite(pair.a, pair.b);
+    }
+  }
+
+  constexpr uint32_t kNoIsland = std::numeric_limits<uint32_t>::max();
+  std::pmr::vector<uint32_t> islandOfRoot(bodyCount, kNoIsland, resource);
+  std::pmr::vector<Island> islands(resource);
+
+  for (uint32_t i = 0; i < static_cast<uint32_t>(bodyCount); ++i) {
+    if (isStatic[i]) {
+      continue;
+    }
+    const uint32_t root = sets.find(i);
+    if (islandOfRoot[root] == kNoIsland) {
+      islandOfRoot[root] = static_cast<uint32_t>(islands.size());
+      islands.emplace_back(resource);
+    }
+    islands[islandOfRoot[root]].bodyIndices.push_back(i);
+  }
+
+  for (uint32_t p = 0; p < static_cast<uint32_t>(pairs.size()); ++p) {
+    const auto& pair = pairs[p];
+    if (isStatic[pair.a] && isStatic[pair.b]) {
+      continue;
+    }
+    const uint32_t dynamicBody = isStatic[pair.a] ? pair.b : pair.a;
+    islands[islandOfRoot[sets.find(dynamicBody)]].pairIndices.push_back(p);
+  }
+
+  return islands;
+}
+
+} // namespace physics
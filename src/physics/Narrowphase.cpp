@@ -0,0 +1,585 @@
+#include <physics/Narrowphase.hpp>
+#include <physics/BoxCollider.hpp>
+#include <physics/CapsuleCollider.hpp>
+#include <physics/ConvexCollider.hpp>
+#include <physics/GJK.hpp>
+#include <physics/PlaneCollider.hpp>
+#include <physics/SphereCollider.hpp>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace physics {
+
+namespace {
+
+constexpr size_t MAX_MANIFOLD_CONTACTS = 4;
+// Contacts whose normals agree this closely belong to one patch
+constexpr float SAME_PATCH_COS = 0.95f;
+constexpr float kEpsilon = 1e-8f;
+
+using ContactFn = bool (*)(const Collider&, const Collider&, std::vector<ContactInfo>&);
+
+// ── shared closed forms ─────────────────────────────────────────────
+
+// Every pair that reduces to two spheres (sphere, capsule cores) ends here
+bool sphereSphereContact(const glm::vec3& centerA, float radiusA,
+                         const glm::vec3& centerB, float radiusB,
+                         const Collider* a, const Collider* b,
+                         std::vector<ContactInfo>& info) {
+  const glm::vec3 delta = centerB - centerA;
+  const float distSq = glm::dot(delta, delta);
+  const float radiusSum = radiusA + radiusB;
+
+  if (distSq > (radiusSum * radiusSum) + kEpsilon) {
+    return false;
+  }
+
+  const float dist = glm::sqrt(distSq);
+  const float penetrationDepth = radiusSum - dist;
+
+  glm::vec3 normal;
+  glm::vec3 contactPoint;
+  if (dist < kEpsilon) {
+    // Spheres are nearly coincident — pick an arbitrary normal
+    normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    contactPoint = centerA;
+  } else {
+    normal = delta / dist; // Points from a toward b
+    contactPoint = centerA + normal * (radiusA - penetrationDepth * 0.5f);
+  }
+
+  info.emplace_back(contactPoint, normal, a, b, penetrationDepth);
+  return true;
+}
+
+glm::vec3 closestPointOnSegment(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b) {
+  const glm::vec3 ab = b - a;
+  const float lengthSq = glm::dot(ab, ab);
+  if (lengthSq < kEpsilon) {
+    return a;
+  }
+  const float t = std::clamp(glm::dot(p - a, ab) / lengthSq, 0.0f, 1.0f);
+  return a + t * ab;
+}
+
+// Closest points between segments p1q1 and p2q2 (Ericson, Real-Time Collision Detection 5.1.9)
+void closestPointsOnSegments(const glm::vec3& p1, const glm::vec3& q1,
+                             const glm::vec3& p2, const glm::vec3& q2,
+                             glm::vec3& c1, glm::vec3& c2) {
+  const glm::vec3 d1 = q1 - p1;
+  const glm::vec3 d2 = q2 - p2;
+  const glm::vec3 r = p1 - p2;
+  const float a = glm::dot(d1, d1);
+  const float e = glm::dot(d2, d2);
+  const float f = glm::dot(d2, r);
+
+  float s = 0.0f;
+  float t = 0.0f;
+  if (a <= kEpsilon && e <= kEpsilon) {
+    // Both segments degenerate into points
+  } else if (a <= kEpsilon) {
+    t = std::clamp(f / e, 0.0f, 1.0f);
+  } else {
+    const float c = glm::dot(d1, r);
+    if (e <= kEpsilon) {
+      s = std::clamp(-c / a, 0.0f, 1.0f);
+    } else {
+      const float b = glm::dot(d1, d2);
+      const float denom = a * e - b * b;
+      s = denom > kEpsilon ? std::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+      t = (b * s + f) / e;
+      if (t < 0.0f) {
+        t = 0.0f;
+        s = std::clamp(-c / a, 0.0f, 1.0f);
+      } else if (t > 1.0f) {
+        t = 1.0f;
+        s = std::clamp((b - c) / a, 0.0f, 1.0f);
+      }
+    }
+  }
+
+  c1 = p1 + d1 * s;
+  c2 = p2 + d2 * t;
+}
+
+glm::vec3 closestPointOnBox(const BoxCollider& box, const glm::vec3& p) {
+  const glm::vec3 local = glm::conjugate(box.orientation) * (p - box.center);
+  return box.center + box.orientation * glm::clamp(local, -box.halfExtents, box.halfExtents);
+}
+
+// Sphere against an oriented box, normal from the sphere toward the box
+bool sphereBoxContact(const glm::vec3& center, float radius, const BoxCollider& box,
+                      const Collider* a, const Collider* b,
+                      std::vector<ContactInfo>& info) {
+  const glm::vec3 local = glm::conjugate(box.orientation) * (center - box.center);
+  const glm::vec3 clamped = glm::clamp(local, -box.halfExtents, box.halfExtents);
+  const glm::vec3 offset = local - clamped;
+  const float distSq = glm::dot(offset, offset);
+
+  if (distSq > kEpsilon) {
+    if (distSq > radius * radius) {
+      return false;
+    }
+    const float dist = glm::sqrt(distSq);
+    const glm::vec3 normal = box.orientation * (-offset / dist);
+    const float depth = radius - dist;
+    const glm::vec3 surface = box.center + box.orientation * clamped;
+    info.emplace_back(surface + normal * (depth * 0.5f), normal, a, b, depth);
+    return true;
+  }
+
+  // Center inside the box: leave through the nearest face
+  int axis = 0;
+  float gap = std::numeric_limits<float>::max();
+  for (int i = 0; i < 3; ++i) {
+    const float g = box.halfExtents[i] - std::fabs(local[i]);
+    if (g < gap) {
+      gap = g;
+      axis = i;
+    }
+  }
+  glm::vec3 faceNormal(0.0f);
+  faceNormal[axis] = local[axis] >= 0.0f ? 1.0f : -1.0f;
+  glm::vec3 surfaceLocal = local;
+  surfaceLocal[axis] = faceNormal[axis] * box.halfExtents[axis];
+
+  const glm::vec3 normal = box.orientation * -faceNormal;
+  const float depth = radius + gap;
+  const glm::vec3 surface = box.center + box.orientation * surfaceLocal;
+  info.emplace_back(surface + normal * (depth * 0.5f), normal, a, b, depth);
+  return true;
+}
+
+// Sphere against a plane's solid half-space, normal from the sphere toward the plane
+bool spherePlaneContact(const glm::vec3& center, float radius, const PlaneCollider& plane,
+                        const Collider* a, const Collider* b,
+                        std::vector<ContactInfo>& info) {
+  const float dist = plane.signedDistance(center);
+  if (dist > radius) {
+    return false;
+  }
+  const float depth = radius - dist;
+  info.emplace_back(center - plane.normal * ((radius + dist) * 0.5f), -plane.normal, a, b, depth);
+  return true;
+}
+
+// ── pair table entries ──────────────────────────────────────────────
+
+bool sphereSphere(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& sa = static_cast<const SphereCollider&>(a);
+  const auto& sb = static_cast<const SphereCollider&>(b);
+  return sphereSphereContact(sa.center, sa.radius, sb.center, sb.radius, &a, &b, info);
+}
+
+bool sphereBox(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& sphere = static_cast<const SphereCollider&>(a);
+  return sphereBoxContact(sphere.center, sphere.radius, static_cast<const BoxCollider&>(b), &a, &b, info);
+}
+
+bool sphereCapsule(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& sphere = static_cast<const SphereCollider&>(a);
+  const auto& capsule = static_cast<const CapsuleCollider&>(b);
+  const glm::vec3 core = closestPointOnSegment(sphere.center, capsule.pointA(), capsule.pointB());
+  return sphereSphereContact(sphere.center, sphere.radius, core, capsule.radius, &a, &b, info);
+}
+
+bool spherePlane(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& sphere = static_cast<const SphereCollider&>(a);
+  return spherePlaneContact(sphere.center, sphere.radius, static_cast<const PlaneCollider&>(b), &a, &b, info);
+}
+
+bool boxBox(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& boxA = static_cast<const BoxCollider&>(a);
+  const auto& boxB = static_cast<const BoxCollider&>(b);
+  const std::array<glm::vec3, 3> axesA { boxA.axis(0), boxA.axis(1), boxA.axis(2) };
+  const std::array<glm::vec3, 3> axesB { boxB.axis(0), boxB.axis(1), boxB.axis(2) };
+  const glm::vec3 d = boxB.center - boxA.center;
+
+  auto supportRadius = [](const std::array<glm::vec3, 3>& axes, const glm::vec3& h, const glm::vec3& n) {
+    return h.x * std::fabs(glm::dot(axes[0], n)) + h.y * std::fabs(glm::dot(axes[1], n)) +
+           h.z * std::fabs(glm::dot(axes[2], n));
+  };
+
+  // Separating axis test over 3 + 3 face normals and 9 edge-edge crosses. Edge
+  // axes must beat face axes by a margin so resting boxes keep a face normal.
+  enum class AxisKind { FaceA, FaceB, Edge };
+  float bestScore = std::numeric_limits<float>::max();
+  float bestDepth = 0.0f;
+  glm::vec3 bestAxis(0.0f);
+  AxisKind bestKind = AxisKind::FaceA;
+  int bestEdgeA = 0;
+  int bestEdgeB = 0;
+
+  auto testAxis = [&](glm::vec3 axis, AxisKind kind, int i, int j) {
+    const float length = glm::length(axis);
+    if (length < 1e-6f) {
+      return true; // parallel edges: covered by the face axes
+    }
+    axis /= length;
+    const float dist = glm::dot(d, axis);
+    const float overlap = supportRadius(axesA, boxA.halfExtents, axis) +
+                          supportRadius(axesB, boxB.halfExtents, axis) - std::fabs(dist);
+    if (overlap < 0.0f) {
+      return false;
+    }
+    const float score = kind == AxisKind::Edge ? overlap * 1.05f + 1e-4f : overlap;
+    if (score < bestScore) {
+      bestScore = score;
+      bestDepth = overlap;
+      bestAxis = dist < 0.0f ? -axis : axis;
+      bestKind = kind;
+      bestEdgeA = i;
+      bestEdgeB = j;
+    }
+    return true;
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    if (!testAxis(axesA[i], AxisKind::FaceA, i, 0)) return false;
+  }
+  for (int i = 0; i < 3; ++i) {
+    if (!testAxis(axesB[i], AxisKind::FaceB, 0, i)) return false;
+  }
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (!testAxis(glm::cross(axesA[i], axesB[j]), AxisKind::Edge, i, j)) return false;
+    }
+  }
+
+  const glm::vec3 n = bestAxis;
+  const float faceA = glm::dot(boxA.center, n) + supportRadius(axesA, boxA.halfExtents, n);
+  const float faceB = glm::dot(boxB.center, n) - supportRadius(axesB, boxB.halfExtents, n);
+
+  auto contains = [](const BoxCollider& box, const glm::vec3& p) {
+    const glm::vec3 local = glm::conjugate(box.orientation) * (p - box.center);
+    const glm::vec3 slack = box.halfExtents + glm::vec3(1e-4f) - glm::abs(local);
+    return slack.x >= 0.0f && slack.y >= 0.0f && slack.z >= 0.0f;
+  };
+
+  // Corners of either box inside the other make up the manifold, gathered
+  // straight into info and reduced there
+  const size_t first = info.size();
+  for (const auto& v : boxB.corners()) {
+    if (contains(boxA, v)) {
+      const float depth = std::clamp(faceA - glm::dot(v, n), 0.0f, bestDepth);
+      info.emplace_back(v + n * (depth * 0.5f), n, &a, &b, depth);
+    }
+  }
+  for (const auto& v : boxA.corners()) {
+    if (contains(boxB, v)) {
+      const float depth = std::clamp(glm::dot(v, n) - faceB, 0.0f, bestDepth);
+      info.emplace_back(v - n * (depth * 0.5f), n, &a, &b, depth);
+    }
+  }
+
+  if (info.size() == first) {
+    glm::vec3 point = boxA.center + 0.5f * d;
+    if (bestKind == AxisKind::Edge) {
+      // Closest points between the two crossing edges
+      glm::vec3 edgeA = boxA.center;
+      glm::vec3 edgeB = boxB.center;
+      for (int k = 0; k < 3; ++k) {
+        if (k != bestEdgeA) {
+          edgeA += (glm::dot(axesA[k], n) > 0.0f ? 1.0f : -1.0f) * boxA.halfExtents[k] * axesA[k];
+        }
+        if (k != bestEdgeB) {
+          edgeB -= (glm::dot(axesB[k], n) > 0.0f ? 1.0f : -1.0f) * boxB.halfExtents[k] * axesB[k];
+        }
+      }
+      const glm::vec3 extentA = boxA.halfExtents[bestEdgeA] * axesA[bestEdgeA];
+      const glm::vec3 extentB = boxB.halfExtents[bestEdgeB] * axesB[bestEdgeB];
+      glm::vec3 onA, onB;
+      closestPointsOnSegments(edgeA - extentA, edgeA + extentA, edgeB - extentB, edgeB + extentB, onA, onB);
+      point = 0.5f * (onA + onB);
+    }
+    info.emplace_back(point, n, &a, &b, bestDepth);
+  }
+
+  reduceManifold(info, first);
+  return true;
+}
+
+bool boxPlane(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& box = static_cast<const BoxCollider&>(a);
+  const auto& plane = static_cast<const PlaneCollider&>(b);
+
+  const size_t first = info.size();
+  for (const auto& v : box.corners()) {
+    const float dist = plane.signedDistance(v);
+    if (dist <= 0.0f) {
+      info.emplace_back(v - plane.normal * (dist * 0.5f), -plane.normal, &a, &b, -dist);
+    }
+  }
+  if (info.size() == first) {
+    return false;
+  }
+
+  reduceManifold(info, first);
+  return true;
+}
+
+bool capsuleBox(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& capsule = static_cast<const CapsuleCollider&>(a);
+  const auto& box = static_cast<const BoxCollider&>(b);
+  const glm::vec3 p = capsule.pointA();
+  const glm::vec3 q = capsule.pointB();
+
+  // Alternating projection converges to the closest segment point for convex boxes
+  glm::vec3 core = 0.5f * (p + q);
+  for (int i = 0; i < 4; ++i) {
+    core = closestPointOnSegment(closestPointOnBox(box, core), p, q);
+  }
+
+  // End caps keep a lying capsule supported at both ends
+  bool hit = sphereBoxContact(p, capsule.radius, box, &a, &b, info);
+  hit = sphereBoxContact(q, capsule.radius, box, &a, &b, info) || hit;
+  const float capSeparation = 0.1f * capsule.radius;
+  if (glm::distance(core, p) > capSeparation && glm::distance(core, q) > capSeparation) {
+    hit = sphereBoxContact(core, capsule.radius, box, &a, &b, info) || hit;
+  }
+  return hit;
+}
+
+bool capsuleCapsule(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& capsuleA = static_cast<const CapsuleCollider&>(a);
+  const auto& capsuleB = static_cast<const CapsuleCollider&>(b);
+  const glm::vec3 pA = capsuleA.pointA();
+  const glm::vec3 qA = capsuleA.pointB();
+  const glm::vec3 pB = capsuleB.pointA();
+  const glm::vec3 qB = capsuleB.pointB();
+
+  const glm::vec3 dirA = qA - pA;
+  const glm::vec3 dirB = qB - pB;
+  const bool parallel = glm::length2(dirA) > kEpsilon && glm::length2(dirB) > kEpsilon &&
+                        std::fabs(glm::dot(glm::normalize(dirA), glm::normalize(dirB))) > 0.99f;
+
+  if (parallel) {
+    // Side by side: one contact per end point over the overlapping span
+    const size_t first = info.size();
+    bool hit = false;
+    for (const auto& end : { pA, qA }) {
+      hit = sphereSphereContact(end, capsuleA.radius, closestPointOnSegment(end, pB, qB), capsuleB.radius,
+                                &a, &b, info) || hit;
+    }
+    for (const auto& end : { pB, qB }) {
+      const size_t before = info.size();
+      if (sphereSphereContact(closestPointOnSegment(end, pA, qA), capsuleA.radius, end, capsuleB.radius,
+                              &a, &b, info)) {
+        // Skip B's end points that coincide with a contact from A's ends
+        const bool duplicate = std::any_of(info.begin() + first, info.begin() + before, [&](const ContactInfo& c) {
+          return glm::length2(c.contactPoint - info.back().contactPoint) < 1e-6f;
+        });
+        if (duplicate) {
+          info.pop_back();
+        } else {
+          hit = true;
+        }
+      }
+    }
+    if (hit) {
+      return true;
+    }
+  }
+
+  glm::vec3 coreA, coreB;
+  closestPointsOnSegments(pA, qA, pB, qB, coreA, coreB);
+  return sphereSphereContact(coreA, capsuleA.radius, coreB, capsuleB.radius, &a, &b, info);
+}
+
+bool capsulePlane(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& capsule = static_cast<const CapsuleCollider&>(a);
+  const auto& plane = static_cast<const PlaneCollider&>(b);
+  bool hit = spherePlaneContact(capsule.pointA(), capsule.radius, plane, &a, &b, info);
+  hit = spherePlaneContact(capsule.pointB(), capsule.radius, plane, &a, &b, info) || hit;
+  return hit;
+}
+
+bool planePlane(const Collider&, const Collider&, std::vector<ContactInfo>&) {
+  // Two infinite half-spaces are static scenery; there is nothing to resolve
+  return false;
+}
+
+// Any pair with a hull: one contact at the deepest overlap, midway between the
+// two witness points
+bool convexPair(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto overlap = penetration(a, b);
+  if (!overlap) {
+    return false;
+  }
+  info.emplace_back(0.5f * (overlap->pointA + overlap->pointB), overlap->normal, &a, &b, overlap->depth);
+  return true;
+}
+
+// Every hull vertex below the plane, rounded by the margin, reduced to a manifold
+bool convexPlane(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const auto& convex = static_cast<const ConvexCollider&>(a);
+  const auto& plane = static_cast<const PlaneCollider&>(b);
+  const size_t first = info.size();
+  bool hit = false;
+  for (const auto& vertex : convex.hull->vertices) {
+    hit = spherePlaneContact(convex.pose.transformPoint(vertex), convex.margin, plane, &a, &b, info) || hit;
+  }
+  reduceManifold(info, first);
+  return hit;
+}
+
+void flipContacts(std::vector<ContactInfo>& info, size_t first) {
+  for (size_t i = first; i < info.size(); ++i) {
+    info[i].contactNormal = -info[i].contactNormal;
+    std::swap(info[i].pCollider1, info[i].pCollider2);
+  }
+}
+
+// Reuses the (b, a) entry for the mirrored pair
+template <ContactFn Fn>
+bool flipped(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const size_t first = info.size();
+  const bool hit = Fn(b, a, info);
+  flipContacts(info, first);
+  return hit;
+}
+
+constexpr ContactFn kPairTable[kPrimitiveColliderTypes][kPrimitiveColliderTypes] = {
+  //              Sphere                    Box                   Capsule                  Plane                    Convex
+  /* Sphere  */ { sphereSphere,             sphereBox,            sphereCapsule,           spherePlane,             convexPair },
+  /* Box     */ { flipped<sphereBox>,       boxBox,               flipped<capsuleBox>,     boxPlane,                convexPair },
+  /* Capsule */ { flipped<sphereCapsule>,   capsuleBox,           capsuleCapsule,          capsulePlane,            convexPair },
+  /* Plane   */ { flipped<spherePlane>,     flipped<boxPlane>,    flipped<capsulePlane>,   planePlane,              flipped<convexPlane> },
+  /* Convex  */ { convexPair,               convexPair,           convexPair,              convexPlane,             convexPair },
+};
+
+} // namespace
+
+bool collide(const Collider& a, const Collider& b, std::vector<ContactInfo>& info) {
+  const ColliderType typeA = a.getType();
+  const ColliderType typeB = b.getType();
+
+  if (typeA == ColliderType::Custom) {
+    return a.checkCollision(b, info);
+  }
+  if (typeB == ColliderType::Custom) {
+    const size_t first = info.size();
+    const bool hit = b.checkCollision(a, info);
+    flipContacts(info, first);
+    return hit;
+  }
+
+  return kPairTable[static_cast<size_t>(typeA)][static_cast<size_t>(typeB)](a, b, info);
+}
+
+// Reduces candidates[0, count) down to at most MAX_MANIFOLD_CONTACTS that
+// best represent one contact patch, moved to the front; returns how many
+// are kept. Strategy:
+//   1. Keep the deepest penetration (most important for stability)
+//   2. Keep the point farthest from #1 (maximise spread)
+//   3. Keep the point that maximises triangle area with #1 and #2
+//   4. Keep the point that maximises quadrilateral area with #1, #2, #3
+static size_t reducePatch(ContactInfo* candidates, size_t count) {
+  if (count <= MAX_MANIFOLD_CONTACTS) return count;
+
+  std::array<size_t, MAX_MANIFOLD_CONTACTS> kept {};
+
+  // 1. Deepest penetration
+  for (size_t i = 1; i < count; ++i) {
+    if (candidates[i].depth > candidates[kept[0]].depth) {
+      kept[0] = i;
+    }
+  }
+  const glm::vec3 p0 = candidates[kept[0]].contactPoint;
+
+  // 2. Farthest from the deepest
+  float maxDistSq = -1.0f;
+  for (size_t i = 0; i < count; ++i) {
+    float dSq = glm::length2(candidates[i].contactPoint - p0);
+    if (dSq > maxDistSq) {
+      maxDistSq = dSq;
+      kept[1] = i;
+    }
+  }
+  const glm::vec3 p1 = candidates[kept[1]].contactPoint;
+
+  // 3. Maximise triangle area with the first two
+  float maxArea = -1.0f;
+  glm::vec3 edge = p1 - p0;
+  for (size_t i = 0; i < count; ++i) {
+    glm::vec3 cross = glm::cross(edge, candidates[i].contactPoint - p0);
+    float area = glm::length2(cross);
+    if (area > maxArea) {
+      maxArea = area;
+      kept[2] = i;
+    }
+  }
+  const glm::vec3 p2 = candidates[kept[2]].contactPoint;
+
+  // 4. Maximise quadrilateral area — pick the point farthest from the
+  //    plane formed by the first three
+  if (MAX_MANIFOLD_CONTACTS >= 4) {
+    glm::vec3 triNormal = glm::cross(p1 - p0, p2 - p0);
+    float triNormalLen = glm::length(triNormal);
+    if (triNormalLen > 1e-8f) {
+      triNormal /= triNormalLen;
+    }
+
+    float maxDist = -1.0f;
+    for (size_t i = 0; i < count; ++i) {
+      float d = std::abs(glm::dot(candidates[i].contactPoint - p0, triNormal));
+      if (d > maxDist) {
+        maxDist = d;
+        kept[3] = i;
+      }
+    }
+
+    // Only add if it's meaningfully off-plane; otherwise pick farthest
+    // from centroid of the existing three
+    if (maxDist < 1e-6f) {
+      glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+      float maxCentroidDistSq = -1.0f;
+      for (size_t i = 0; i < count; ++i) {
+        float dSq = glm::length2(candidates[i].contactPoint - centroid);
+        if (dSq > maxCentroidDistSq) {
+          maxCentroidDistSq = dSq;
+          kept[3] = i;
+        }
+      }
+    }
+  }
+
+  // Copy out before writing back: a point may have been picked more than once
+  const std::array<ContactInfo, MAX_MANIFOLD_CONTACTS> reduced {
+    candidates[kept[0]], candidates[kept[1]], candidates[kept[2]], candidates[kept[3]],
+  };
+  std::copy(reduced.begin(), reduced.end(), candidates);
+  return MAX_MANIFOLD_CONTACTS;
+}
+
+// Groups contacts[first, end) by normal, so a body touching several faces of
+// a concave surface keeps a patch against each, and reduces every group with
+// reducePatch. Partitions in place, so it never allocates.
+void reduceManifold(std::vector<ContactInfo>& contacts, size_t first) {
+  if (contacts.size() - first <= MAX_MANIFOLD_CONTACTS) return;
+
+  size_t out = first;
+  size_t patchStart = first;
+  while (patchStart < contacts.size()) {
+    const auto begin = contacts.begin() + static_cast<std::ptrdiff_t>(patchStart);
+    const glm::vec3 normal = begin->contactNormal;
+    const auto end = std::partition(begin, contacts.end(), [&](const ContactInfo& contact) {
+      return glm::dot(contact.contactNormal, normal) > SAME_PATCH_COS;
+    });
+    const size_t count = static_cast<size_t>(end - begin);
+    const size_t kept = reducePatch(contacts.data() + patchStart, count);
+    std::move(begin, begin + static_cast<std::ptrdiff_t>(kept), contacts.begin() + static_cast<std::ptrdiff_t>(out));
+    out += kept;
+    patchStart += count;
+  }
+  contacts.erase(contacts.begin() + static_cast<std::ptrdiff_t>(out), contacts.end());
+}
+
+} // namespace physics
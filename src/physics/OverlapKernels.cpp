@@ -0,0 +1,314 @@
+#include <physics/OverlapKernels.hpp>
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SAUCE_OVERLAP_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SAUCE_OVERLAP_LANES 4
+#else
+#define SAUCE_OVERLAP_LANES 1
+#endif
+
+namespace physics {
+
+namespace scalar {
+
+size_t overlapSphereSpheres(const glm::vec3& center, float radius, const SphereSoA& spheres,
+                            size_t begin, size_t end, uint32_t* out) {
+  size_t count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    const float dx = spheres.x[i] - center.x;
+    const float dy = spheres.y[i] - center.y;
+    const float dz = spheres.z[i] - center.z;
+    const float radiusSum = spheres.radius[i] + radius;
+    if (dx * dx + dy * dy + dz * dz <= radiusSum * radiusSum) {
+      out[count++] = static_cast<uint32_t>(i);
+    }
+  }
+  return count;
+}
+
+size_t overlapSphereAABBs(const glm::vec3& center, float radius, const AABBSoA& boxes,
+                          size_t begin, size_t end, uint32_t* out) {
+  size_t count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    const float dx = center.x - std::clamp(center.x, boxes.minX[i], boxes.maxX[i]);
+    const float dy = center.y - std::clamp(center.y, boxes.minY[i], boxes.maxY[i]);
+    const float dz = center.z - std::clamp(center.z, boxes.minZ[i], boxes.maxZ[i]);
+    if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+      out[count++] = static_cast<uint32_t>(i);
+    }
+  }
+  return count;
+}
+
+size_t overlapAABBAABBs(const AABB& box, const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out) {
+  size_t count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    if (box.min.x <= boxes.maxX[i] && boxes.minX[i] <= box.max.x &&
+        box.min.y <= boxes.maxY[i] && boxes.minY[i] <= box.max.y &&
+        box.min.z <= boxes.maxZ[i] && boxes.minZ[i] <= box.max.z) {
+      out[count++] = static_cast<uint32_t>(i);
+    }
+  }
+  return count;
+}
+
+size_t intersectRayAABBs(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance,
+                         const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out, float* tEnter) {
+  size_t count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    const float tx1 = (boxes.minX[i] - origin.x) * invDirection.x;
+    const float tx2 = (boxes.maxX[i] - origin.x) * invDirection.x;
+    const float ty1 = (boxes.minY[i] - origin.y) * invDirection.y;
+    const float ty2 = (boxes.maxY[i] - origin.y) * invDirection.y;
+    const float tz1 = (boxes.minZ[i] - origin.z) * invDirection.z;
+    const float tz2 = (boxes.maxZ[i] - origin.z) * invDirection.z;
+    const float tNear = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+    const float tFar = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+    if (tNear <= tFar) {
+      out[count] = static_cast<uint32_t>(i);
+      tEnter[count] = tNear;
+      ++count;
+    }
+  }
+  return count;
+}
+
+uint32_t intersectRayPacketAABB(const RayPacketSoA& packet, const float* maxDistance,
+                                const glm::vec3& min, const glm::vec3& max, float* tEnter) {
+  uint32_t mask = 0;
+  for (size_t lane = 0; lane < kRayPacketWidth; ++lane) {
+    const float tx1 = (min.x - packet.originX[lane]) * packet.invDirectionX[lane];
+    const float tx2 = (max.x - packet.originX[lane]) * packet.invDirectionX[lane];
+    const float ty1 = (min.y - packet.originY[lane]) * packet.invDirectionY[lane];
+    const float ty2 = (max.y - packet.originY[lane]) * packet.invDirectionY[lane];
+    const float tz1 = (min.z - packet.originZ[lane]) * packet.invDirectionZ[lane];
+    const float tz2 = (max.z - packet.originZ[lane]) * packet.invDirectionZ[lane];
+    const float tNear = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+    const float tFar = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance[lane]));
+    tEnter[lane] = tNear;
+    if (tNear <= tFar) {
+      mask |= 1u << lane;
+    }
+  }
+  return mask;
+}
+
+} // namespace scalar
+
+#if SAUCE_OVERLAP_LANES > 1
+
+namespace {
+
+// Thin wrapper over the widest float vector the build targets, so each kernel
+// is written once. Comparisons return a bit per lane.
+struct Lanes {
+#if SAUCE_OVERLAP_LANES == 8
+  using V = __m256;
+  static constexpr size_t width = 8;
+  static V load(const float* p) { return _mm256_loadu_ps(p); }
+  static V set(float v) { return _mm256_set1_ps(v); }
+  static V add(V a, V b) { return _mm256_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+  static V min(V a, V b) { return _mm256_min_ps(a, b); }
+  static V max(V a, V b) { return _mm256_max_ps(a, b); }
+  static V bitAnd(V a, V b) { return _mm256_and_ps(a, b); }
+  static V lessEqual(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  static uint32_t bits(V mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+  static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+#else
+  using V = __m128;
+  static constexpr size_t width = 4;
+  static V load(const float* p) { return _mm_loadu_ps(p); }
+  static V set(float v) { return _mm_set1_ps(v); }
+  static V add(V a, V b) { return _mm_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+  static V min(V a, V b) { return _mm_min_ps(a, b); }
+  static V max(V a, V b) { return _mm_max_ps(a, b); }
+  static V bitAnd(V a, V b) { return _mm_and_ps(a, b); }
+  static V lessEqual(V a, V b) { return _mm_cmple_ps(a, b); }
+  static uint32_t bits(V mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+  static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+#endif
+};
+
+// Appends base + lane for every set bit, lowest lane first
+inline size_t appendLanes(uint32_t bits, size_t base, uint32_t* out) {
+  size_t count = 0;
+  while (bits != 0) {
+    out[count++] = static_cast<uint32_t>(base + static_cast<size_t>(std::countr_zero(bits)));
+    bits &= bits - 1;
+  }
+  return count;
+}
+
+// Slab test of one ray against Lanes::width boxes starting at i
+inline uint32_t rayLanes(Lanes::V ox, Lanes::V oy, Lanes::V oz,
+                         Lanes::V ix, Lanes::V iy, Lanes::V iz, Lanes::V maxDistance,
+                         const AABBSoA& boxes, size_t i, Lanes::V& tNear) {
+  const Lanes::V tx1 = Lanes::mul(Lanes::sub(Lanes::load(boxes.minX + i), ox), ix);
+  const Lanes::V tx2 = Lanes::mul(Lanes::sub(Lanes::load(boxes.maxX + i), ox), ix);
+  const Lanes::V ty1 = Lanes::mul(Lanes::sub(Lanes::load(boxes.minY + i), oy), iy);
+  const Lanes::V ty2 = Lanes::mul(Lanes::sub(Lanes::load(boxes.maxY + i), oy), iy);
+  const Lanes::V tz1 = Lanes::mul(Lanes::sub(Lanes::load(boxes.minZ + i), oz), iz);
+  const Lanes::V tz2 = Lanes::mul(Lanes::sub(Lanes::load(boxes.maxZ + i), oz), iz);
+  tNear = Lanes::max(Lanes::max(Lanes::min(tx1, tx2), Lanes::min(ty1, ty2)),
+                     Lanes::max(Lanes::min(tz1, tz2), Lanes::set(0.0f)));
+  const Lanes::V tFar = Lanes::min(Lanes::min(Lanes::max(tx1, tx2), Lanes::max(ty1, ty2)),
+                                   Lanes::min(Lanes::max(tz1, tz2), maxDistance));
+  return Lanes::bits(Lanes::lessEqual(tNear, tFar));
+}
+
+} // namespace
+
+size_t overlapSphereSpheres(const glm::vec3& center, float radius, const SphereSoA& spheres,
+                            size_t begin, size_t end, uint32_t* out) {
+  const Lanes::V cx = Lanes::set(center.x);
+  const Lanes::V cy = Lanes::set(center.y);
+  const Lanes::V cz = Lanes::set(center.z);
+  const Lanes::V r = Lanes::set(radius);
+  size_t count = 0;
+  size_t i = begin;
+  for (; i + Lanes::width <= end; i += Lanes::width) {
+    const Lanes::V dx = Lanes::sub(Lanes::load(spheres.x + i), cx);
+    const Lanes::V dy = Lanes::sub(Lanes::load(spheres.y + i), cy);
+    const Lanes::V dz = Lanes::sub(Lanes::load(spheres.z + i), cz);
+    const Lanes::V distance2 = Lanes::add(Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy)), Lanes::mul(dz, dz));
+    const Lanes::V radiusSum = Lanes::add(Lanes::load(spheres.radius + i), r);
+    count += appendLanes(Lanes::bits(Lanes::lessEqual(distance2, Lanes::mul(radiusSum, radiusSum))), i, out + count);
+  }
+  return count + scalar::overlapSphereSpheres(center, radius, spheres, i, end, out + count);
+}
+
+size_t overlapSphereAABBs(const glm::vec3& center, float radius, const AABBSoA& boxes,
+                          size_t begin, size_t end, uint32_t* out) {
+  const Lanes::V cx = Lanes::set(center.x);
+  const Lanes::V cy = Lanes::set(center.y);
+  const Lanes::V cz = Lanes::set(center.z);
+  const Lanes::V radius2 = Lanes::set(radius * radius);
+  size_t count = 0;
+  size_t i = begin;
+  for (; i + Lanes::width <= end; i += Lanes::width) {
+    const Lanes::V dx = Lanes::sub(cx, Lanes::min(Lanes::max(cx, Lanes::load(boxes.minX + i)), Lanes::load(boxes.maxX + i)));
+    const Lanes::V dy = Lanes::sub(cy, Lanes::min(Lanes::max(cy, Lanes::load(boxes.minY + i)), Lanes::load(boxes.maxY + i)));
+    const Lanes::V dz = Lanes::sub(cz, Lanes::min(Lanes::max(cz, Lanes::load(boxes.minZ + i)), Lanes::load(boxes.maxZ + i)));
+    const Lanes::V distance2 = Lanes::add(Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy)), Lanes::mul(dz, dz));
+    count += appendLanes(Lanes::bits(Lanes::lessEqual(distance2, radius2)), i, out + count);
+  }
+  return count + scalar::overlapSphereAABBs(center, radius, boxes, i, end, out + count);
+}
+
+size_t overlapAABBAABBs(const AABB& box, const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out) {
+  const Lanes::V minX = Lanes::set(box.min.x);
+  const Lanes::V minY = Lanes::set(box.min.y);
+  const Lanes::V minZ = Lanes::set(box.min.z);
+  const Lanes::V maxX = Lanes::set(box.max.x);
+  const Lanes::V maxY = Lanes::set(box.max.y);
+  const Lanes::V maxZ = Lanes::set(box.max.z);
+  size_t count = 0;
+  size_t i = begin;
+  for (; i + Lanes::width <= end; i += Lanes::width) {
+    Lanes::V mask = Lanes::bitAnd(Lanes::lessEqual(minX, Lanes::load(boxes.maxX + i)),
+                                  Lanes::lessEqual(Lanes::load(boxes.minX + i), maxX));
+    mask = Lanes::bitAnd(mask, Lanes::bitAnd(Lanes::lessEqual(minY, Lanes::load(boxes.maxY + i)),
+                                             Lanes::lessEqual(Lanes::load(boxes.minY + i), maxY)));
+    mask = Lanes::bitAnd(mask, Lanes::bitAnd(Lanes::lessEqual(minZ, Lanes::load(boxes.maxZ + i)),
+                                             Lanes::lessEqual(Lanes::load(boxes.minZ + i), maxZ)));
+    count += appendLanes(Lanes::bits(mask), i, out + count);
+  }
+  return count + scalar::overlapAABBAABBs(box, boxes, i, end, out + count);
+}
+
+size_t intersectRayAABBs(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance,
+                         const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out, float* tEnter) {
+  const Lanes::V ox = Lanes::set(origin.x);
+  const Lanes::V oy = Lanes::set(origin.y);
+  const Lanes::V oz = Lanes::set(origin.z);
+  const Lanes::V ix = Lanes::set(invDirection.x);
+  const Lanes::V iy = Lanes::set(invDirection.y);
+  const Lanes::V iz = Lanes::set(invDirection.z);
+  const Lanes::V tMax = Lanes::set(maxDistance);
+  size_t count = 0;
+  size_t i = begin;
+  for (; i + Lanes::width <= end; i += Lanes::width) {
+    Lanes::V tNear;
+    uint32_t bits = rayLanes(ox, oy, oz, ix, iy, iz, tMax, boxes, i, tNear);
+    if (bits == 0) {
+      continue;
+    }
+    float lanes[Lanes::width];
+    Lanes::store(lanes, tNear);
+    while (bits != 0) {
+      const uint32_t lane = static_cast<uint32_t>(std::countr_zero(bits));
+      out[count] = static_cast<uint32_t>(i + lane);
+      tEnter[count] = lanes[lane];
+      ++count;
+      bits &= bits - 1;
+    }
+  }
+  return count + scalar::intersectRayAABBs(origin, invDirection, maxDistance, boxes, i, end, out + count, tEnter + count);
+}
+
+uint32_t intersectRayPacketAABB(const RayPacketSoA& packet, const float* maxDistance,
+                                const glm::vec3& min, const glm::vec3& max, float* tEnter) {
+  // Packets are 4 rays, which fills an SSE register exactly
+  const __m128 ox = _mm_loadu_ps(packet.originX);
+  const __m128 oy = _mm_loadu_ps(packet.originY);
+  const __m128 oz = _mm_loadu_ps(packet.originZ);
+  const __m128 ix = _mm_loadu_ps(packet.invDirectionX);
+  const __m128 iy = _mm_loadu_ps(packet.invDirectionY);
+  const __m128 iz = _mm_loadu_ps(packet.invDirectionZ);
+  const __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.x), ox), ix);
+  const __m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.x), ox), ix);
+  const __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.y), oy), iy);
+  const __m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.y), oy), iy);
+  const __m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.z), oz), iz);
+  const __m128 tz2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.z), oz), iz);
+  const __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)),
+                                  _mm_max_ps(_mm_min_ps(tz1, tz2), _mm_setzero_ps()));
+  const __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)),
+                                 _mm_min_ps(_mm_max_ps(tz1, tz2), _mm_loadu_ps(maxDistance)));
+  _mm_storeu_ps(tEnter, tNear);
+  return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)));
+}
+
+size_t overlapKernelWidth() { return Lanes::width; }
+
+#else
+
+size_t overlapSphereSpheres(const glm::vec3& center, float radius, const SphereSoA& spheres,
+                            size_t begin, size_t end, uint32_t* out) {
+  return scalar::overlapSphereSpheres(center, radius, spheres, begin, end, out);
+}
+
+size_t overlapSphereAABBs(const glm::vec3& center, float radius, const AABBSoA& boxes,
+                          size_t begin, size_t end, uint32_t* out) {
+  return scalar::overlapSphereAABBs(center, radius, boxes, begin, end, out);
+}
+
+size_t overlapAABBAABBs(const AABB& box, const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out) {
+  return scalar::overlapAABBAABBs(box, boxes, begin, end, out);
+}
+
+size_t intersectRayAABBs(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance,
+                         const AABBSoA& boxes, size_t begin, size_t end, uint32_t* out, float* tEnter) {
+  return scalar::intersectRayAABBs(origin, invDirection, maxDistance, boxes, begin, end, out, tEnter);
+}
+
+uint32_t intersectRayPacketAABB(const RayPacketSoA& packet, const float* maxDistance,
+                                const glm::vec3& min, const glm::vec3& max, float* tEnter) {
+  return scalar::intersectRayPacketAABB(packet, maxDistance, min, max, tEnter);
+}
+
+size_t overlapKernelWidth() { return 1; }
+
+#endif
+
+} // namespace physics
@@ -0,0 +1,106 @@
+#include <physics/PhysicsProfiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace physics {
+
+namespace {
+
+float percentileOf(std::vector<float>& values, float p) {
+  if (values.empty()) {
+    return 0.0f;
+  }
+  // Nearest-rank percentile
+  const float rank = std::ceil(std::clamp(p, 0.0f, 1.0f) * static_cast<float>(values.size()));
+  const size_t index = std::min(values.size() - 1, static_cast<size_t>(std::max(rank, 1.0f)) - 1);
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+  return values[index];
+}
+
+float averageOf(const std::vector<float>& values) {
+  if (values.empty()) {
+    return 0.0f;
+  }
+  return std::accumulate(values.begin(), values.end(), 0.0f) / static_cast<float>(values.size());
+}
+
+} // namespace
+
+const char* profileStageName(ProfileStage stage) {
+  switch (stage) {
+    case ProfileStage::Broadphase: return "Broadphase";
+    case ProfileStage::Narrowphase: return "Narrowphase";
+    case ProfileStage::Solve: return "Solve";
+    case ProfileStage::ClothSubsteps: return "Cloth substeps";
+    case ProfileStage::NormalRegeneration: return "Normal regeneration";
+    case ProfileStage::GpuUpload: return "GPU upload";
+  }
+  return "Unknown";
+}
+
+float PhysicsSample::totalMs() const {
+  return std::accumulate(stageMs.begin(), stageMs.end(), 0.0f);
+}
+
+void PhysicsProfiler::beginSample() {
+  pending = PhysicsSample {};
+}
+
+void PhysicsProfiler::endSample() {
+  history[next] = pending;
+  next = (next + 1) % kHistorySize;
+  count = std::min(count + 1, kHistorySize);
+  pending = PhysicsSample {};
+}
+
+const PhysicsSample& PhysicsProfiler::sample(size_t age) const {
+  return history[(next + kHistorySize - 1 - age) % kHistorySize];
+}
+
+void PhysicsProfiler::stageHistory(ProfileStage stage, std::vector<float>& out) const {
+  out.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = sample(count - 1 - i).stage(stage);
+  }
+}
+
+void PhysicsProfiler::totalHistory(std::vector<float>& out) const {
+  out.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = sample(count - 1 - i).totalMs();
+  }
+}
+
+float PhysicsProfiler::average(ProfileStage stage) const {
+  std::vector<float> values;
+  stageHistory(stage, values);
+  return averageOf(values);
+}
+
+float PhysicsProfiler::percentile(ProfileStage stage, float p) const {
+  std::vector<float> values;
+  stageHistory(stage, values);
+  return percentileOf(values, p);
+}
+
+float PhysicsProfiler::averageTotal() const {
+  std::vector<float> values;
+  totalHistory(values);
+  return averageOf(values);
+}
+
+float PhysicsProfiler::percentileTotal(float p) const {
+  std::vector<float> values;
+  totalHistory(values);
+  return percentileOf(values, p);
+}
+
+void PhysicsProfiler::clear() {
+  next = 0;
+  count = 0;
+  pending = PhysicsSample {};
+}
+
+} // namespace physics
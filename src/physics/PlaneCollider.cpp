@@ -0,0 +1,10 @@
+#include <physics/PlaneCollider.hpp>
+#include <physics/Narrowphase.hpp>
+
+namespace physics {
+
+bool PlaneCollider::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
+  return collide(*this, collider, info);
+}
+
+} // namespace physics
@@ -0,0 +1,345 @@
+#include <physics/SceneQuery.hpp>
+#include <physics/TaskPool.hpp>
+
+#include <app/Entity.hpp>
+#include <app/Scene.hpp>
+#include <app/components/MeshRendererComponent.hpp>
+#include <app/components/TransformComponent.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+namespace physics {
+
+namespace {
+
+// Rays per TaskPool job in raycastBatch; smaller batches stay on the caller
+constexpr size_t kRaysPerJob = 256;
+
+constexpr uint32_t kNoProxy = std::numeric_limits<uint32_t>::max();
+
+struct SlabRay {
+  glm::vec3 origin;
+  glm::vec3 invDirection;
+};
+
+SlabRay makeSlabRay(const QueryRay& ray) {
+  // Zero components become a huge finite reciprocal so the slab test needs no branch
+  auto safeInverse = [](float d) {
+    return 1.0f / (std::fabs(d) < 1e-12f ? std::copysign(1e-12f, d) : d);
+  };
+  return { ray.origin, glm::vec3(safeInverse(ray.direction.x), safeInverse(ray.direction.y),
+                                 safeInverse(ray.direction.z)) };
+}
+
+// Slab test: entry distance clamped to 0, or false if the box is missed within maxDistance
+bool slabTest(const SlabRay& ray, const glm::vec3& min, const glm::vec3& max, float maxDistance, float& tEnter) {
+  const float tx1 = (min.x - ray.origin.x) * ray.invDirection.x;
+  const float tx2 = (max.x - ray.origin.x) * ray.invDirection.x;
+  const float ty1 = (min.y - ray.origin.y) * ray.invDirection.y;
+  const float ty2 = (max.y - ray.origin.y) * ray.invDirection.y;
+  const float tz1 = (min.z - ray.origin.z) * ray.invDirection.z;
+  const float tz2 = (max.z - ray.origin.z) * ray.invDirection.z;
+  tEnter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+  const float tExit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+  return tEnter <= tExit;
+}
+
+bool sphereOverlapsBox(const glm::vec3& center, float radius, const glm::vec3& min, const glm::vec3& max) {
+  const glm::vec3 closest = glm::clamp(center, min, max);
+  const glm::vec3 d = center - closest;
+  return glm::dot(d, d) <= radius * radius;
+}
+
+} // namespace
+
+SceneQuery SceneQuery::fromScene(const sauce::Scene& scene) {
+  std::vector<Proxy> proxies;
+  const auto& entities = scene.getEntities();
+  for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); ++i) {
+    const auto& entity = entities[i];
+    if (!entity.getActive()) continue;
+
+    glm::mat4 modelMatrix = glm::mat4(1.0f);
+    if (const auto* tc = entity.getComponent<sauce::TransformComponent>()) {
+      modelMatrix = tc->getLocalMatrix();
+    }
+
+    // One proxy per mesh, so a ray through the gap between two meshes of an
+    // entity misses it
+    for (const auto* mrc : entity.getComponents<sauce::MeshRendererComponent>()) {
+      const auto mesh = mrc->getMesh();
+      if (!mesh || !mesh->isValid()) continue;
+
+      AABB local;
+      for (const auto& v : mesh->getVertices()) {
+        local.merge(v.position);
+      }
+      // World bounds of the eight transformed corners
+      AABB bounds;
+      for (int c = 0; c < 8; ++c) {
+        const glm::vec3 corner((c & 1) ? local.max.x : local.min.x,
+                               (c & 2) ? local.max.y : local.min.y,
+                               (c & 4) ? local.max.z : local.min.z);
+        bounds.merge(glm::vec3(modelMatrix * glm::vec4(corner, 1.0f)));
+      }
+      if (!bounds.empty()) {
+        proxies.push_back({ bounds, i });
+      }
+    }
+  }
+
+  SceneQuery query;
+  query.build(std::move(proxies));
+  return query;
+}
+
+void SceneQuery::build(std::vector<Proxy> items) {
+  nodes.clear();
+  proxies.clear();
+  for (auto* column : { &proxyMinX, &proxyMinY, &proxyMinZ, &proxyMaxX, &proxyMaxY, &proxyMaxZ }) {
+    column->clear();
+    column->reserve(items.size());
+  }
+  if (items.empty()) {
+    return;
+  }
+
+  nodes.reserve(2 * items.size() - 1);
+  proxies.reserve(items.size());
+  buildNode(items, 0, items.size());
+}
+
+void SceneQuery::buildNode(std::vector<Proxy>& items, size_t start, size_t end) {
+  const uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+  nodes.push_back({});
+
+  AABB bounds;
+  AABB centroids;
+  for (size_t i = start; i < end; ++i) {
+    bounds.merge(items[i].bounds);
+    centroids.merge(items[i].bounds.center());
+  }
+
+  if (end - start <= kMaxLeafProxies) {
+    nodes[nodeIndex] = { bounds.min, nodeIndex + 1, bounds.max,
+                         static_cast<uint32_t>(proxies.size()), static_cast<uint32_t>(end - start) };
+    for (size_t i = start; i < end; ++i) {
+      const AABB& box = items[i].bounds;
+      proxies.push_back(items[i]);
+      proxyMinX.push_back(box.min.x);
+      proxyMinY.push_back(box.min.y);
+      proxyMinZ.push_back(box.min.z);
+      proxyMaxX.push_back(box.max.x);
+      proxyMaxY.push_back(box.max.y);
+      proxyMaxZ.push_back(box.max.z);
+    }
+    return;
+  }
+
+  // Median split on the longest centroid axis
+  const glm::vec3 extent = centroids.max - centroids.min;
+  const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+  const size_t mid = start + (end - start) / 2;
+  std::nth_element(items.begin() + static_cast<std::ptrdiff_t>(start),
+                   items.begin() + static_cast<std::ptrdiff_t>(mid),
+                   items.begin() + static_cast<std::ptrdiff_t>(end),
+                   [axis](const Proxy& a, const Proxy& b) {
+                     return a.bounds.center()[axis] < b.bounds.center()[axis];
+                   });
+
+  buildNode(items, start, mid);
+  buildNode(items, mid, end);
+  nodes[nodeIndex] = { bounds.min, static_cast<uint32_t>(nodes.size()), bounds.max, 0, 0 };
+}
+
+AABBSoA SceneQuery::proxyBounds() const {
+  return { proxyMinX.data(), proxyMinY.data(), proxyMinZ.data(),
+           proxyMaxX.data(), proxyMaxY.data(), proxyMaxZ.data() };
+}
+
+bool SceneQuery::raycast(const QueryRay& ray, RaycastHit& hit) const {
+  const SlabRay slab = makeSlabRay(ray);
+  const AABBSoA leafBounds = proxyBounds();
+  float closest = ray.maxDistance;
+  uint32_t closestProxy = kNoProxy;
+
+  // Stackless walk: descend into boxes the ray enters before the closest hit so far
+  std::array<uint32_t, kMaxLeafProxies> leafHits;
+  std::array<float, kMaxLeafProxies> leafDistances;
+  for (uint32_t i = 0; i < nodes.size();) {
+    const Node& node = nodes[i];
+    float tEnter = 0.0f;
+    if (!slabTest(slab, node.min, node.max, closest, tEnter)) {
+      i = node.skipIndex;
+      continue;
+    }
+    if (node.isLeaf()) {
+      const size_t count = intersectRayAABBs(slab.origin, slab.invDirection, closest, leafBounds,
+                                             node.firstProxy, node.firstProxy + node.proxyCount,
+                                             leafHits.data(), leafDistances.data());
+      for (size_t h = 0; h < count; ++h) {
+        if (leafDistances[h] <= closest) {
+          closest = leafDistances[h];
+          closestProxy = leafHits[h];
+        }
+      }
+    }
+    ++i;
+  }
+
+  if (closestProxy == kNoProxy) {
+    return false;
+  }
+  hit.id = proxies[closestProxy].id;
+  hit.distance = closest;
+  hit.point = ray.origin + ray.direction * closest;
+  return true;
+}
+
+bool SceneQuery::raycastAny(const QueryRay& ray) const {
+  const SlabRay slab = makeSlabRay(ray);
+  const AABBSoA leafBounds = proxyBounds();
+  std::array<uint32_t, kMaxLeafProxies> leafHits;
+  std::array<float, kMaxLeafProxies> leafDistances;
+  for (uint32_t i = 0; i < nodes.size();) {
+    const Node& node = nodes[i];
+    float tEnter = 0.0f;
+    if (!slabTest(slab, node.min, node.max, ray.maxDistance, tEnter)) {
+      i = node.skipIndex;
+      continue;
+    }
+    if (node.isLeaf() &&
+        intersectRayAABBs(slab.origin, slab.invDirection, ray.maxDistance, leafBounds,
+                          node.firstProxy, node.firstProxy + node.proxyCount,
+                          leafHits.data(), leafDistances.data()) > 0) {
+      return true;
+    }
+    ++i;
+  }
+  return false;
+}
+
+void SceneQuery::overlapSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& ids) const {
+  const AABBSoA leafBounds = proxyBounds();
+  std::array<uint32_t, kMaxLeafProxies> leafHits;
+  for (uint32_t i = 0; i < nodes.size();) {
+    const Node& node = nodes[i];
+    if (!sphereOverlapsBox(center, radius, node.min, node.max)) {
+      i = node.skipIndex;
+      continue;
+    }
+    if (node.isLeaf()) {
+      const size_t count = overlapSphereAABBs(center, radius, leafBounds, node.firstProxy,
+                                              node.firstProxy + node.proxyCount, leafHits.data());
+      for (size_t h = 0; h < count; ++h) {
+        ids.push_back(proxies[leafHits[h]].id);
+      }
+    }
+    ++i;
+  }
+}
+
+void SceneQuery::overlapAABB(const AABB& box, std::vector<uint32_t>& ids) const {
+  const AABBSoA leafBounds = proxyBounds();
+  std::array<uint32_t, kMaxLeafProxies> leafHits;
+  for (uint32_t i = 0; i < nodes.size();) {
+    const Node& node = nodes[i];
+    if (!box.overlaps(AABB { node.min, node.max })) {
+      i = node.skipIndex;
+      continue;
+    }
+    if (node.isLeaf()) {
+      const size_t count = overlapAABBAABBs(box, leafBounds, node.firstProxy,
+                                            node.firstProxy + node.proxyCount, leafHits.data());
+      for (size_t h = 0; h < count; ++h) {
+        ids.push_back(proxies[leafHits[h]].id);
+      }
+    }
+    ++i;
+  }
+}
+
+// Packet traversal: the rays are laid out structure-of-arrays so each node and
+// leaf proxy is tested against all lanes with one intersectRayPacketAABB call.
+// A subtree is skipped only when every lane misses it.
+void SceneQuery::tracePacket(const QueryRay* rays, size_t count, RaycastHit* hits) const {
+  constexpr size_t W = kPacketWidth;
+  RayPacketSoA packet {};
+  alignas(16) std::array<float, W> closest {};
+  std::array<uint32_t, W> closestProxy;
+  closestProxy.fill(kNoProxy);
+
+  for (size_t lane = 0; lane < W; ++lane) {
+    if (lane < count) {
+      const SlabRay slab = makeSlabRay(rays[lane]);
+      packet.originX[lane] = slab.origin.x;
+      packet.originY[lane] = slab.origin.y;
+      packet.originZ[lane] = slab.origin.z;
+      packet.invDirectionX[lane] = slab.invDirection.x;
+      packet.invDirectionY[lane] = slab.invDirection.y;
+      packet.invDirectionZ[lane] = slab.invDirection.z;
+      closest[lane] = rays[lane].maxDistance;
+    } else {
+      // Padding lanes never hit: an empty interval
+      closest[lane] = -1.0f;
+    }
+  }
+
+  alignas(16) std::array<float, W> tEnter {};
+  for (uint32_t i = 0; i < nodes.size();) {
+    const Node& node = nodes[i];
+    if (intersectRayPacketAABB(packet, closest.data(), node.min, node.max, tEnter.data()) == 0) {
+      i = node.skipIndex;
+      continue;
+    }
+    for (uint32_t p = node.firstProxy; p < static_cast<uint32_t>(node.firstProxy + node.proxyCount); ++p) {
+      const glm::vec3 min(proxyMinX[p], proxyMinY[p], proxyMinZ[p]);
+      const glm::vec3 max(proxyMaxX[p], proxyMaxY[p], proxyMaxZ[p]);
+      uint32_t laneHits = intersectRayPacketAABB(packet, closest.data(), min, max, tEnter.data());
+      for (; laneHits != 0; laneHits &= laneHits - 1) {
+        const size_t lane = static_cast<size_t>(std::countr_zero(laneHits));
+        closest[lane] = tEnter[lane];
+        closestProxy[lane] = p;
+      }
+    }
+    ++i;
+  }
+
+  for (size_t lane = 0; lane < count; ++lane) {
+    RaycastHit& hit = hits[lane];
+    if (closestProxy[lane] == kNoProxy) {
+      hit = RaycastHit {};
+      continue;
+    }
+    hit.id = proxies[closestProxy[lane]].id;
+    hit.distance = closest[lane];
+    hit.point = rays[lane].origin + rays[lane].direction * closest[lane];
+  }
+}
+
+void SceneQuery::raycastBatch(std::span<const QueryRay> rays, std::vector<RaycastHit>& hits) const {
+  hits.assign(rays.size(), RaycastHit {});
+  if (nodes.empty() || rays.empty()) {
+    return;
+  }
+
+  auto traceRange = [&](size_t begin, size_t end) {
+    for (size_t r = begin; r < end; r += kPacketWidth) {
+      tracePacket(rays.data() + r, std::min(kPacketWidth, end - r), hits.data() + r);
+    }
+  };
+
+  if (rays.size() <= kRaysPerJob) {
+    traceRange(0, rays.size());
+    return;
+  }
+  const size_t jobs = (rays.size() + kRaysPerJob - 1) / kRaysPerJob;
+  TaskPool::shared().parallelFor(jobs, [&](size_t job) {
+    traceRange(job * kRaysPerJob, std::min(rays.size(), (job + 1) * kRaysPerJob));
+  });
+}
+
+} // namespace physics
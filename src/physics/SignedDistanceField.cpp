@@ -0,0 +1,447 @@
+#include <physics/SignedDistanceField.hpp>
+
+#include <app/modeling/Mesh.hpp>
+#include <physics/TaskPool.hpp>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <span>
+#include <system_error>
+
+namespace physics {
+
+namespace {
+
+constexpr size_t kSamplesPerBrick =
+    SignedDistanceField::kBrickSamples * SignedDistanceField::kBrickSamples * SignedDistanceField::kBrickSamples;
+constexpr float kQuantization = 32767.0f;
+
+// Bumped whenever the baked samples or the file layout change
+constexpr uint32_t kFormatVersion = 1;
+constexpr char kMagic[4] = { 'S', 'D', 'F', 'B' };
+
+// Closest point on triangle abc to p (Ericson, Real-Time Collision Detection 5.1.5)
+glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+  const glm::vec3 ab = b - a;
+  const glm::vec3 ac = c - a;
+  const glm::vec3 ap = p - a;
+  const float d1 = glm::dot(ab, ap);
+  const float d2 = glm::dot(ac, ap);
+  if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+  const glm::vec3 bp = p - b;
+  const float d3 = glm::dot(ab, bp);
+  const float d4 = glm::dot(ac, bp);
+  if (d3 >= 0.0f && d4 <= d3) return b;
+
+  const float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+    return a + (d1 / (d1 - d3)) * ab;
+  }
+
+  const glm::vec3 cp = p - c;
+  const float d5 = glm::dot(ab, cp);
+  const float d6 = glm::dot(ac, cp);
+  if (d6 >= 0.0f && d5 <= d6) return c;
+
+  const float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+    return a + (d2 / (d2 - d6)) * ac;
+  }
+
+  const float va = d3 * d6 - d5 * d4;
+  if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+    return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+  }
+
+  const float denom = 1.0f / (va + vb + vc);
+  return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+struct Triangle {
+  glm::vec3 a, b, c;
+  glm::vec3 normal; // unit
+};
+
+// Signed distance to the closest of the given triangles. The sign comes from
+// the closest triangle's face; when several are equally close (the point is
+// nearest an edge or vertex they share) the one facing the point most directly
+// decides, which keeps the sign right around convex and concave features.
+float signedDistance(const glm::vec3& p, std::span<const Triangle> triangles, std::span<const uint32_t> candidates) {
+  float best = std::numeric_limits<float>::max();
+  float bestFacing = 0.0f;
+  float bestSide = 1.0f;
+  for (uint32_t t : candidates) {
+    const Triangle& tri = triangles[t];
+    const glm::vec3 toPoint = p - closestPointOnTriangle(p, tri.a, tri.b, tri.c);
+    const float d2 = glm::length2(toPoint);
+    const float side = glm::dot(toPoint, tri.normal);
+    const float facing = d2 > 0.0f ? std::fabs(side) / std::sqrt(d2) : 1.0f;
+    const float tolerance = 1e-6f * std::max(best, 1e-8f);
+    if (d2 < best - tolerance || (d2 <= best + tolerance && facing > bestFacing)) {
+      best = std::min(best, d2);
+      bestFacing = facing;
+      bestSide = side < 0.0f ? -1.0f : 1.0f;
+    }
+  }
+  return bestSide * std::sqrt(best);
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+} // namespace
+
+SignedDistanceField SignedDistanceField::fromMesh(const sauce::modeling::Mesh& mesh, float cellSize, float bandWidth) {
+  SignedDistanceField field;
+  const auto& vertices = mesh.getVertices();
+  const auto& indices = mesh.getIndices();
+  if (cellSize <= 0.0f || bandWidth <= 0.0f || vertices.empty() || indices.size() < 3) {
+    return field;
+  }
+
+  std::vector<Triangle> triangles;
+  triangles.reserve(indices.size() / 3);
+  glm::vec3 lo(std::numeric_limits<float>::max());
+  glm::vec3 hi(-std::numeric_limits<float>::max());
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const glm::vec3& a = vertices[indices[i]].position;
+    const glm::vec3& b = vertices[indices[i + 1]].position;
+    const glm::vec3& c = vertices[indices[i + 2]].position;
+    const glm::vec3 n = glm::cross(b - a, c - a);
+    if (glm::length2(n) <= 0.0f) {
+      continue;
+    }
+    triangles.push_back({ a, b, c, glm::normalize(n) });
+    lo = glm::min(lo, glm::min(a, glm::min(b, c)));
+    hi = glm::max(hi, glm::max(a, glm::max(b, c)));
+  }
+  if (triangles.empty()) {
+    return field;
+  }
+
+  // Pad by the band so every brick that can see the surface lies inside the
+  // grid, and the grid's border bricks are outside the mesh
+  const float brickSize = cellSize * kBrickCells;
+  const float padding = bandWidth + cellSize;
+  field.origin = lo - glm::vec3(padding);
+  field.cellSize = cellSize;
+  field.bandWidth = bandWidth;
+  const glm::vec3 extent = (hi - lo) + glm::vec3(2.0f * padding);
+  const int dims[3] = {
+      std::max(1, static_cast<int>(std::ceil(extent.x / brickSize))),
+      std::max(1, static_cast<int>(std::ceil(extent.y / brickSize))),
+      std::max(1, static_cast<int>(std::ceil(extent.z / brickSize))),
+  };
+  field.brickDims = glm::ivec3(dims[0], dims[1], dims[2]);
+  const size_t brickCount = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+  auto brickIndex = [&](int x, int y, int z) {
+    return (static_cast<size_t>(z) * dims[1] + static_cast<size_t>(y)) * dims[0] + static_cast<size_t>(x);
+  };
+
+  // Bin each triangle into every brick within bandWidth of its bounds (plus a
+  // cell of slack for the samples shared with the next brick), as CSR lists
+  struct BrickRange {
+    int lo[3];
+    int hi[3];
+  };
+  auto brickRange = [&](const Triangle& tri) {
+    const glm::vec3 slack(bandWidth + cellSize);
+    const glm::vec3 tmin = glm::min(tri.a, glm::min(tri.b, tri.c)) - slack - field.origin;
+    const glm::vec3 tmax = glm::max(tri.a, glm::max(tri.b, tri.c)) + slack - field.origin;
+    BrickRange range;
+    for (int axis = 0; axis < 3; ++axis) {
+      range.lo[axis] = std::clamp(static_cast<int>(std::floor(tmin[axis] / brickSize)), 0, dims[axis] - 1);
+      range.hi[axis] = std::clamp(static_cast<int>(std::floor(tmax[axis] / brickSize)), 0, dims[axis] - 1);
+    }
+    return range;
+  };
+  std::vector<uint32_t> binStart(brickCount + 1, 0);
+  for (const Triangle& tri : triangles) {
+    const BrickRange r = brickRange(tri);
+    for (int z = r.lo[2]; z <= r.hi[2]; ++z)
+      for (int y = r.lo[1]; y <= r.hi[1]; ++y)
+        for (int x = r.lo[0]; x <= r.hi[0]; ++x)
+          ++binStart[brickIndex(x, y, z) + 1];
+  }
+  for (size_t i = 0; i < brickCount; ++i) {
+    binStart[i + 1] += binStart[i];
+  }
+  std::vector<uint32_t> binned(binStart[brickCount]);
+  {
+    std::vector<uint32_t> cursor(binStart.begin(), binStart.end() - 1);
+    for (uint32_t t = 0; t < static_cast<uint32_t>(triangles.size()); ++t) {
+      const BrickRange r = brickRange(triangles[t]);
+      for (int z = r.lo[2]; z <= r.hi[2]; ++z)
+        for (int y = r.lo[1]; y <= r.hi[1]; ++y)
+          for (int x = r.lo[0]; x <= r.hi[0]; ++x)
+            binned[cursor[brickIndex(x, y, z)]++] = t;
+    }
+  }
+
+  // Bricks with triangles nearby get samples; the rest are tagged below
+  constexpr uint32_t kUnknownBrick = 0xfffffffdu;
+  field.brickSlots.assign(brickCount, kUnknownBrick);
+  std::vector<uint32_t> bandBricks;
+  for (size_t i = 0; i < brickCount; ++i) {
+    if (binStart[i + 1] > binStart[i]) {
+      field.brickSlots[i] = static_cast<uint32_t>(bandBricks.size() * kSamplesPerBrick);
+      bandBricks.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  field.samples.resize(bandBricks.size() * kSamplesPerBrick);
+
+  TaskPool::shared().parallelFor(bandBricks.size(), [&](size_t b) {
+    const size_t brick = bandBricks[b];
+    const int bx = static_cast<int>(brick % dims[0]);
+    const int by = static_cast<int>((brick / dims[0]) % dims[1]);
+    const int bz = static_cast<int>(brick / (static_cast<size_t>(dims[0]) * dims[1]));
+    const std::span<const uint32_t> candidates(binned.data() + binStart[brick], binStart[brick + 1] - binStart[brick]);
+    int16_t* out = field.samples.data() + field.brickSlots[brick];
+    for (int z = 0; z < kBrickSamples; ++z) {
+      for (int y = 0; y < kBrickSamples; ++y) {
+        for (int x = 0; x < kBrickSamples; ++x) {
+          const glm::vec3 cell(static_cast<float>(bx * kBrickCells + x), static_cast<float>(by * kBrickCells + y),
+                               static_cast<float>(bz * kBrickCells + z));
+          const float d = signedDistance(field.origin + cell * cellSize, triangles, candidates);
+          *out++ = static_cast<int16_t>(std::lround(std::clamp(d / bandWidth, -1.0f, 1.0f) * kQuantization));
+        }
+      }
+    }
+  });
+
+  // Binning by triangle bounds is conservative: drop bricks whose samples all
+  // came out clamped, keeping only which side of the surface they are on
+  size_t kept = 0;
+  for (uint32_t brick : bandBricks) {
+    const int16_t* block = field.samples.data() + field.brickSlots[brick];
+    const int16_t first = block[0];
+    const bool clamped = (first == 32767 || first == -32767) &&
+                         std::all_of(block, block + kSamplesPerBrick, [&](int16_t v) { return v == first; });
+    if (clamped) {
+      field.brickSlots[brick] = first > 0 ? kOutsideBrick : kInsideBrick;
+      continue;
+    }
+    std::copy(block, block + kSamplesPerBrick, field.samples.data() + kept);
+    field.brickSlots[brick] = static_cast<uint32_t>(kept);
+    kept += kSamplesPerBrick;
+  }
+  field.samples.resize(kept);
+  field.samples.shrink_to_fit();
+
+  // Bricks without triangles nearby that are reachable from the grid border
+  // are outside; the band encloses everything else
+  std::vector<uint8_t> reached(brickCount, 0);
+  std::queue<size_t> open;
+  auto visit = [&](int x, int y, int z) {
+    const size_t i = brickIndex(x, y, z);
+    if (!reached[i] && (field.brickSlots[i] == kUnknownBrick || field.brickSlots[i] == kOutsideBrick)) {
+      reached[i] = 1;
+      open.push(i);
+    }
+  };
+  for (int z = 0; z < dims[2]; ++z)
+    for (int y = 0; y < dims[1]; ++y)
+      for (int x = 0; x < dims[0]; ++x)
+        if (x == 0 || y == 0 || z == 0 || x == dims[0] - 1 || y == dims[1] - 1 || z == dims[2] - 1)
+          visit(x, y, z);
+  while (!open.empty()) {
+    const size_t i = open.front();
+    open.pop();
+    const int x = static_cast<int>(i % dims[0]);
+    const int y = static_cast<int>((i / dims[0]) % dims[1]);
+    const int z = static_cast<int>(i / (static_cast<size_t>(dims[0]) * dims[1]));
+    if (x > 0) visit(x - 1, y, z);
+    if (x + 1 < dims[0]) visit(x + 1, y, z);
+    if (y > 0) visit(x, y - 1, z);
+    if (y + 1 < dims[1]) visit(x, y + 1, z);
+    if (z > 0) visit(x, y, z - 1);
+    if (z + 1 < dims[2]) visit(x, y, z + 1);
+  }
+  for (size_t i = 0; i < brickCount; ++i) {
+    if (field.brickSlots[i] == kUnknownBrick) {
+      field.brickSlots[i] = reached[i] ? kOutsideBrick : kInsideBrick;
+    }
+  }
+  return field;
+}
+
+SignedDistanceField::Sample SignedDistanceField::sample(const glm::vec3& p) const {
+  if (brickSlots.empty()) {
+    return { bandWidth, glm::vec3(0.0f) };
+  }
+
+  const glm::vec3 u = (p - origin) / cellSize;
+  int cell[3];
+  glm::vec3 t;
+  for (int axis = 0; axis < 3; ++axis) {
+    const float f = std::floor(u[axis]);
+    cell[axis] = static_cast<int>(f);
+    if (!(f >= 0.0f) || cell[axis] >= brickDims[axis] * kBrickCells) {
+      return { bandWidth, glm::vec3(0.0f) };
+    }
+    t[axis] = u[axis] - f;
+  }
+
+  const int bx = cell[0] / kBrickCells;
+  const int by = cell[1] / kBrickCells;
+  const int bz = cell[2] / kBrickCells;
+  const uint32_t slot =
+      brickSlots[(static_cast<size_t>(bz) * brickDims.y + static_cast<size_t>(by)) * brickDims.x + static_cast<size_t>(bx)];
+  if (slot == kOutsideBrick) return { bandWidth, glm::vec3(0.0f) };
+  if (slot == kInsideBrick) return { -bandWidth, glm::vec3(0.0f) };
+
+  const int lx = cell[0] - bx * kBrickCells;
+  const int ly = cell[1] - by * kBrickCells;
+  const int lz = cell[2] - bz * kBrickCells;
+  const int16_t* s = samples.data() + slot + (lz * kBrickSamples + ly) * kBrickSamples + lx;
+  constexpr int dy = kBrickSamples;
+  constexpr int dz = kBrickSamples * kBrickSamples;
+  const float scale = bandWidth / kQuantization;
+  const float c000 = s[0] * scale, c100 = s[1] * scale;
+  const float c010 = s[dy] * scale, c110 = s[dy + 1] * scale;
+  const float c001 = s[dz] * scale, c101 = s[dz + 1] * scale;
+  const float c011 = s[dz + dy] * scale, c111 = s[dz + dy + 1] * scale;
+
+  // Trilinear blend and its analytic derivative
+  const float c00 = c000 + t.x * (c100 - c000);
+  const float c10 = c010 + t.x * (c110 - c010);
+  const float c01 = c001 + t.x * (c101 - c001);
+  const float c11 = c011 + t.x * (c111 - c011);
+  const float c0 = c00 + t.y * (c10 - c00);
+  const float c1 = c01 + t.y * (c11 - c01);
+
+  const float dx0 = (c100 - c000) + t.y * ((c110 - c010) - (c100 - c000));
+  const float dx1 = (c101 - c001) + t.y * ((c111 - c011) - (c101 - c001));
+  glm::vec3 gradient(dx0 + t.z * (dx1 - dx0), (c10 - c00) + t.z * ((c11 - c01) - (c10 - c00)), c1 - c0);
+  const float length2 = glm::length2(gradient);
+  gradient = length2 > 1e-12f ? gradient / std::sqrt(length2) : glm::vec3(0.0f);
+
+  return { c0 + t.z * (c1 - c0), gradient };
+}
+
+float SignedDistanceField::distance(const glm::vec3& p) const {
+  return sample(p).distance;
+}
+
+uint64_t SignedDistanceField::cacheKey(const sauce::modeling::Mesh& mesh, float cellSize, float bandWidth) {
+  uint64_t hash = 14695981039346656037ull;
+  hash = fnv1a(hash, &kFormatVersion, sizeof(kFormatVersion));
+  hash = fnv1a(hash, &cellSize, sizeof(cellSize));
+  hash = fnv1a(hash, &bandWidth, sizeof(bandWidth));
+  for (const auto& vertex : mesh.getVertices()) {
+    hash = fnv1a(hash, &vertex.position, sizeof(vertex.position));
+  }
+  const auto& indices = mesh.getIndices();
+  return fnv1a(hash, indices.data(), indices.size() * sizeof(uint32_t));
+}
+
+// Native-endian file: magic, version, key, grid parameters, then both arrays
+bool SignedDistanceField::save(const std::filesystem::path& path, uint64_t key) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out.write(kMagic, sizeof(kMagic));
+  writeValue(out, kFormatVersion);
+  writeValue(out, key);
+  writeValue(out, origin);
+  writeValue(out, cellSize);
+  writeValue(out, bandWidth);
+  writeValue(out, brickDims);
+  writeValue(out, static_cast<uint64_t>(samples.size()));
+  out.write(reinterpret_cast<const char*>(brickSlots.data()),
+            static_cast<std::streamsize>(brickSlots.size() * sizeof(uint32_t)));
+  out.write(reinterpret_cast<const char*>(samples.data()),
+            static_cast<std::streamsize>(samples.size() * sizeof(int16_t)));
+  return static_cast<bool>(out);
+}
+
+std::optional<SignedDistanceField> SignedDistanceField::load(const std::filesystem::path& path, uint64_t key) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+
+  char magic[sizeof(kMagic)] = {};
+  uint32_t version = 0;
+  uint64_t storedKey = 0;
+  uint64_t sampleCount = 0;
+  SignedDistanceField field;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !readValue(in, version) || version != kFormatVersion ||
+      !readValue(in, storedKey) || storedKey != key ||
+      !readValue(in, field.origin) || !readValue(in, field.cellSize) || !readValue(in, field.bandWidth) ||
+      !readValue(in, field.brickDims) || !readValue(in, sampleCount)) {
+    return std::nullopt;
+  }
+  if (field.brickDims.x <= 0 || field.brickDims.y <= 0 || field.brickDims.z <= 0 ||
+      sampleCount % kSamplesPerBrick != 0) {
+    return std::nullopt;
+  }
+
+  field.brickSlots.resize(static_cast<size_t>(field.brickDims.x) * field.brickDims.y * field.brickDims.z);
+  field.samples.resize(sampleCount);
+  if (!in.read(reinterpret_cast<char*>(field.brickSlots.data()),
+               static_cast<std::streamsize>(field.brickSlots.size() * sizeof(uint32_t))) ||
+      !in.read(reinterpret_cast<char*>(field.samples.data()),
+               static_cast<std::streamsize>(field.samples.size() * sizeof(int16_t)))) {
+    return std::nullopt;
+  }
+  for (uint32_t slot : field.brickSlots) {
+    if (slot < kInsideBrick && slot + kSamplesPerBrick > sampleCount) {
+      return std::nullopt;
+    }
+  }
+  return field;
+}
+
+SignedDistanceField SignedDistanceField::loadOrBake(const sauce::modeling::Mesh& mesh, float cellSize, float bandWidth,
+                                                    const std::filesystem::path& cacheDirectory) {
+  if (cacheDirectory.empty()) {
+    return fromMesh(mesh, cellSize, bandWidth);
+  }
+
+  const uint64_t key = cacheKey(mesh, cellSize, bandWidth);
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.sdf", static_cast<unsigned long long>(key));
+  const std::filesystem::path path = cacheDirectory / name;
+  if (auto cached = load(path, key)) {
+    return std::move(*cached);
+  }
+
+  SignedDistanceField field = fromMesh(mesh, cellSize, bandWidth);
+  // A cache that cannot be written only costs a re-bake next time
+  std::error_code error;
+  std::filesystem::create_directories(cacheDirectory, error);
+  if (!error && !field.empty()) {
+    field.save(path, key);
+  }
+  return field;
+}
+
+} // namespace physics
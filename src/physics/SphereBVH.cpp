@@ -1,5 +1,12 @@
 #include <physics/SphereBVH.hpp>
+#include <physics/Narrowphase.hpp>
 #include <physics/SphereCollider.hpp>
+#include <physics/TaskPool.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
 #include <vector>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/norm.hpp>
@@ -12,35 +19,173 @@ namespace {
         uint32_t idx; 
         glm::vec3 v0, v1, v2;
         glm::vec3 centroid;
+        glm::vec3 minExt, maxExt;
     };
-    std::unique_ptr<SphereBVHNode> buildNode(std::vector<TriangleInfo> &triangles, size_t start, size_t end) {
-        auto node = std::make_unique<SphereBVHNode>();
+
+    constexpr size_t MAX_TRIANGLES_PER_LEAF = 4;
+    constexpr size_t SAH_BIN_COUNT = 16;
+    // SAH peels a few triangles per level off skewed meshes; below this depth
+    // nodes split at the median so the tree and the build recursion stay shallow
+    constexpr size_t MAX_SAH_DEPTH = 64;
+    // Subtrees smaller than this are not worth a task of their own
+    constexpr size_t MIN_PARALLEL_SUBTREE = 4096;
+
+    // Subtree the serial top-level pass leaves to a worker task
+    struct DeferredSubtree {
+        size_t placeholder;
+        size_t start, end;
+        size_t depth;
+        std::vector<SphereBVHNode> nodes = {};
+        std::vector<uint32_t> triangleIndices = {};
+    };
+
+    struct BuildContext {
+        std::vector<TriangleInfo> &triangles;
+        SphereBVH::BuildStrategy strategy;
+        // When set, interior subtrees below deferBelow triangles are recorded
+        // here behind a placeholder node instead of being built in place
+        std::vector<DeferredSubtree> *deferred = nullptr;
+        size_t deferBelow = 0;
+    };
+
+    float surfaceArea(const glm::vec3 &minExt, const glm::vec3 &maxExt) {
+        const glm::vec3 d = maxExt - minExt;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    size_t splitMedian(std::vector<TriangleInfo> &triangles, size_t start, size_t end, const glm::vec3 &extent) {
+        int axis = 0; 
+        if (extent.y > extent.x) axis = 1;
+        if (extent.z > extent[axis]) axis = 2;
+
+        size_t mid = start + (end - start) / 2;
+        std::nth_element(triangles.begin() + start,
+                        triangles.begin() + mid,
+                        triangles.begin() + end,
+                        [axis](const TriangleInfo &a, const TriangleInfo &b) {
+                            return a.centroid[axis] < b.centroid[axis];
+                        });
+        return mid;
+    }
+
+    // Binned surface area heuristic: bucket centroids into SAH_BIN_COUNT bins per
+    // axis and split at the bin boundary minimising area(L) * n(L) + area(R) * n(R),
+    // measured on the triangles' AABBs. Falls back to a median split when every
+    // candidate plane leaves one side empty.
+    size_t splitBinnedSAH(std::vector<TriangleInfo> &triangles, size_t start, size_t end,
+                          const glm::vec3 &centroidMin, const glm::vec3 &extent) {
+        struct Bin {
+            glm::vec3 minExt = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 maxExt = glm::vec3(std::numeric_limits<float>::lowest());
+            size_t count = 0;
+        };
+        // Clamped in float before the cast, and written so a NaN lands in bin 0
+        auto binOf = [&](const TriangleInfo &t, int axis) {
+            const float scaled = (t.centroid[axis] - centroidMin[axis]) * (SAH_BIN_COUNT / extent[axis]);
+            constexpr float lastBin = static_cast<float>(SAH_BIN_COUNT - 1);
+            return scaled > 0.0f ? static_cast<size_t>(std::min(scaled, lastBin)) : size_t(0);
+        };
+
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        size_t bestBin = 0;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            // Centroids only a few ulps apart cannot be told apart by bin, and
+            // SAH_BIN_COUNT / extent overflows to infinity on a tiny extent
+            const float minExtent = std::numeric_limits<float>::epsilon() *
+                                    std::max(std::abs(centroidMin[axis]), 1.0f) * SAH_BIN_COUNT;
+            if (!(extent[axis] > minExtent)) continue;
+
+            std::array<Bin, SAH_BIN_COUNT> bins;
+            for (size_t i = start; i < end; ++i) {
+                const auto &t = triangles[i];
+                Bin &bin = bins[binOf(t, axis)];
+                bin.minExt = glm::min(bin.minExt, t.minExt);
+                bin.maxExt = glm::max(bin.maxExt, t.maxExt);
+                ++bin.count;
+            }
+
+            // Right-to-left sweep records the area and count to the right of each plane
+            std::array<float, SAH_BIN_COUNT> rightArea {};
+            std::array<size_t, SAH_BIN_COUNT> rightCount {};
+            Bin right;
+            for (size_t b = SAH_BIN_COUNT - 1; b > 0; --b) {
+                right.minExt = glm::min(right.minExt, bins[b].minExt);
+                right.maxExt = glm::max(right.maxExt, bins[b].maxExt);
+                right.count += bins[b].count;
+                rightArea[b] = right.count ? surfaceArea(right.minExt, right.maxExt) : 0.0f;
+                rightCount[b] = right.count;
+            }
+
+            Bin left;
+            for (size_t b = 0; b + 1 < SAH_BIN_COUNT; ++b) {
+                left.minExt = glm::min(left.minExt, bins[b].minExt);
+                left.maxExt = glm::max(left.maxExt, bins[b].maxExt);
+                left.count += bins[b].count;
+                if (left.count == 0 || rightCount[b + 1] == 0) continue;
+
+                const float cost = surfaceArea(left.minExt, left.maxExt) * static_cast<float>(left.count) +
+                                   rightArea[b + 1] * static_cast<float>(rightCount[b + 1]);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0) {
+            return splitMedian(triangles, start, end, extent);
+        }
+
+        auto split = std::partition(triangles.begin() + start, triangles.begin() + end,
+                                    [&](const TriangleInfo &t) { return binOf(t, bestAxis) <= bestBin; });
+        return static_cast<size_t>(split - triangles.begin());
+    }
+
+    // Appends the subtree over triangles[start, end) to nodes in depth-first
+    // order. Nodes are addressed by index since the array grows while recursing.
+    void buildNode(BuildContext &ctx, size_t start, size_t end, size_t depth,
+                   std::vector<SphereBVHNode> &nodes, std::vector<uint32_t> &triangleIndices) {
+        auto &triangles = ctx.triangles;
+        const size_t nodeIndex = nodes.size();
+        nodes.emplace_back();
         size_t count = end - start;
+
+        if (ctx.deferred && count > MAX_TRIANGLES_PER_LEAF && count < ctx.deferBelow) {
+            ctx.deferred->push_back({ .placeholder = nodeIndex, .start = start, .end = end, .depth = depth });
+            nodes[nodeIndex].skipIndex = static_cast<uint32_t>(nodes.size());
+            return;
+        }
+
         glm::vec3 minExt(std::numeric_limits<float>::max());
         glm::vec3 maxExt(std::numeric_limits<float>::lowest());
 
         for (size_t i = start; i < end; ++i) {
-            const auto &t = triangles[i];
-            minExt = glm::min(minExt, glm::min(t.v0, glm::min(t.v1, t.v2)));
-            maxExt = glm::max(maxExt, glm::max(t.v0, glm::max(t.v1, t.v2)));
+            minExt = glm::min(minExt, triangles[i].minExt);
+            maxExt = glm::max(maxExt, triangles[i].maxExt);
         }
 
-        node->sphere.center = (minExt + maxExt) / 2.0f;
+        // The sphere is fitted around the AABB the split works on
+        const glm::vec3 center = (minExt + maxExt) / 2.0f;
         float maxRadiusSq = 0.0f;
         for (size_t i = start; i < end; ++i) {
-            maxRadiusSq = std::max(maxRadiusSq, glm::length2(node->sphere.center - triangles[i].v0));
-            maxRadiusSq = std::max(maxRadiusSq, glm::length2(node->sphere.center - triangles[i].v1));
-            maxRadiusSq = std::max(maxRadiusSq, glm::length2(node->sphere.center - triangles[i].v2));
+            maxRadiusSq = std::max(maxRadiusSq, glm::length2(center - triangles[i].v0));
+            maxRadiusSq = std::max(maxRadiusSq, glm::length2(center - triangles[i].v1));
+            maxRadiusSq = std::max(maxRadiusSq, glm::length2(center - triangles[i].v2));
         }
-        node->sphere.radius = std::sqrt(maxRadiusSq);
-
+        nodes[nodeIndex].center = center;
+        nodes[nodeIndex].radius = std::sqrt(maxRadiusSq);
 
-        const size_t MAX_TRIANGLES_PER_LEAF = 4;
         if (count <= MAX_TRIANGLES_PER_LEAF) {
+            nodes[nodeIndex].firstTriangle = static_cast<uint32_t>(triangleIndices.size());
+            nodes[nodeIndex].triangleCount = static_cast<uint32_t>(count);
             for (size_t i = start; i < end; ++i) {
-                node->triangleIndices.push_back(triangles[i].idx);
+                triangleIndices.push_back(triangles[i].idx);
             }
-            return node;
+            nodes[nodeIndex].skipIndex = static_cast<uint32_t>(nodes.size());
+            return;
         }
 
 
@@ -51,276 +196,568 @@ namespace {
             centroidMax = glm::max(centroidMax, triangles[i].centroid);
         }
 
-        glm::vec3 extent = centroidMax - centroidMin;
-        int axis = 0; 
-        if (extent.y > extent.x) axis = 1;
-        if (extent.z > extent[axis]) axis = 2;
+        const glm::vec3 extent = centroidMax - centroidMin;
+        const size_t mid = ctx.strategy == SphereBVH::BuildStrategy::BinnedSAH && depth < MAX_SAH_DEPTH
+            ? splitBinnedSAH(triangles, start, end, centroidMin, extent)
+            : splitMedian(triangles, start, end, extent);
 
-        size_t mid = start + count / 2;
-        std::nth_element(triangles.begin() + start,
-                        triangles.begin() + mid,
-                        triangles.begin() + end,
-                        [axis](const TriangleInfo &a, const TriangleInfo &b) {
-                            return a.centroid[axis] < b.centroid[axis];
-                        });
+        buildNode(ctx, start, mid, depth + 1, nodes, triangleIndices);
+        buildNode(ctx, mid, end, depth + 1, nodes, triangleIndices);
+        nodes[nodeIndex].skipIndex = static_cast<uint32_t>(nodes.size());
+    }
 
-        node->left = buildNode(triangles, start, mid);
-        node->right = buildNode(triangles, mid, end);
+    void appendTriangles(const sauce::modeling::Mesh &mesh, std::vector<TriangleInfo> &triangles) {
+        const auto &vertices = mesh.getVertices();
+        const auto &indices = mesh.getIndices();
+        if (vertices.empty()) {
+            return;
+        }
 
-        return node;
+        size_t numTriangles = indices.size() / 3;
+        for (size_t i = 0; i < numTriangles; ++i) {
+            glm::vec3 p0 = vertices[indices[i * 3 + 0]].position;
+            glm::vec3 p1 = vertices[indices[i * 3 + 1]].position;
+            glm::vec3 p2 = vertices[indices[i * 3 + 2]].position;
+
+            triangles.push_back({
+                .idx = static_cast<uint32_t>(triangles.size()),
+                .v0 = p0, 
+                .v1 = p1, 
+                .v2 = p2,
+                .centroid = (p0 + p1 + p2) / 3.0f,
+                .minExt = glm::min(p0, glm::min(p1, p2)),
+                .maxExt = glm::max(p0, glm::max(p1, p2))
+            });
+        }
     }
 
-    SphereCollider mergeSpheres(const SphereCollider& s1, const SphereCollider& s2) {
+    // Smallest sphere enclosing both child spheres
+    void mergeSpheres(SphereBVHNode &node, const SphereBVHNode &s1, const SphereBVHNode &s2) {
         float dist = glm::distance(s1.center, s2.center);
 
         if (dist + s1.radius <= s2.radius) {
-            return s2;
+            node.center = s2.center;
+            node.radius = s2.radius;
+            return;
         }
         if (dist + s2.radius <= s1.radius) {
-            return s1;
+            node.center = s1.center;
+            node.radius = s1.radius;
+            return;
         }
 
-        float newRadius = (dist + s1.radius + s2.radius) / 2.0;
-        
-        SphereCollider res;
-        res.center = glm::mix(s1.center, s2.center, (newRadius - s1.radius) / dist);
-        res.radius = newRadius;
-        return res;
+        float newRadius = (dist + s1.radius + s2.radius) / 2.0f;
+        node.center = glm::mix(s1.center, s2.center, (newRadius - s1.radius) / dist);
+        node.radius = newRadius;
     }
 
-    std::unique_ptr<SphereBVHNode> buildBVH(std::vector<std::unique_ptr<SphereBVHNode>>& spheres, int start, int end) {
-        int count = end - start;
-        if (count <= 0) {
-            return nullptr;
+    // Builds the top of the tree serially until the remaining subtrees are small
+    // enough to spread over the task pool, builds those concurrently, then
+    // splices them back behind their placeholders in depth-first order.
+    void buildFlat(std::vector<TriangleInfo> &triangles, SphereBVH::BuildStrategy strategy,
+                   std::vector<SphereBVHNode> &nodes, std::vector<uint32_t> &triangleIndices) {
+        if (triangles.empty()) {
+            return;
         }
 
-        if (count == 1) {
-            return std::move(spheres[start]);
+        TaskPool &pool = TaskPool::shared();
+        std::vector<DeferredSubtree> deferred;
+        BuildContext ctx { .triangles = triangles, .strategy = strategy };
+        if (pool.getConcurrency() > 1 && triangles.size() >= 2 * MIN_PARALLEL_SUBTREE) {
+            // Several tasks per thread so uneven subtrees still balance out
+            ctx.deferred = &deferred;
+            ctx.deferBelow = std::max(MIN_PARALLEL_SUBTREE, triangles.size() / (4 * pool.getConcurrency()));
         }
-        
-        glm::vec3 minCentroid(std::numeric_limits<float>::max());
-        glm::vec3 maxCentroid(std::numeric_limits<float>::lowest());
 
-        for (int i = start; i < end; ++i) {
-            glm::vec3 c = spheres[i]->sphere.center;
-            minCentroid = glm::min(minCentroid, c);
-            maxCentroid = glm::max(maxCentroid, c);
+        // Every leaf holds at least one triangle, so 2n nodes bound the tree
+        std::vector<SphereBVHNode> top;
+        std::vector<uint32_t> topIndices;
+        if (!ctx.deferred) {
+            top.reserve(2 * triangles.size());
+            topIndices.reserve(triangles.size());
         }
+        buildNode(ctx, 0, triangles.size(), 0, top, topIndices);
 
-        glm::vec3 extent = maxCentroid - minCentroid;
-        int axis = 0;
-        if (extent.y > extent.x) {
-            axis = 1;
-        } else if (extent.z > extent[axis]) {
-            axis = 2;
+        if (deferred.empty()) {
+            nodes = std::move(top);
+            triangleIndices = std::move(topIndices);
+            return;
         }
 
-        int mid = start + count / 2;
-        std::nth_element(
-            spheres.begin() + start,
-            spheres.begin() + mid,
-            spheres.begin() + end,
-            [axis](const std::unique_ptr<SphereBVHNode>& a, const std::unique_ptr<SphereBVHNode>& b) {
-                return a->sphere.center[axis] < b->sphere.center[axis];
-            }
-        );
+        pool.parallelFor(deferred.size(), [&](size_t i) {
+            DeferredSubtree &subtree = deferred[i];
+            BuildContext local { .triangles = triangles, .strategy = strategy };
+            subtree.nodes.reserve(2 * (subtree.end - subtree.start));
+            buildNode(local, subtree.start, subtree.end, subtree.depth, subtree.nodes, subtree.triangleIndices);
+        });
+
+        constexpr size_t NOT_DEFERRED = std::numeric_limits<size_t>::max();
+        std::vector<size_t> deferredAt(top.size(), NOT_DEFERRED);
+        for (size_t d = 0; d < deferred.size(); ++d) {
+            deferredAt[deferred[d].placeholder] = d;
+        }
 
-        auto node = std::make_unique<SphereBVHNode>();
-        node->left = buildBVH(spheres, start, mid);
-        node->right = buildBVH(spheres, mid, end);
-        node->sphere = mergeSpheres(node->left->sphere, node->right->sphere);
+        // Final position of each top-level node once placeholders expand
+        std::vector<uint32_t> finalIndex(top.size() + 1);
+        size_t total = 0;
+        for (size_t i = 0; i < top.size(); ++i) {
+            finalIndex[i] = static_cast<uint32_t>(total);
+            total += deferredAt[i] == NOT_DEFERRED ? 1 : deferred[deferredAt[i]].nodes.size();
+        }
+        finalIndex[top.size()] = static_cast<uint32_t>(total);
+
+        nodes.clear();
+        nodes.reserve(total);
+        triangleIndices.clear();
+        triangleIndices.reserve(triangles.size());
+        for (size_t i = 0; i < top.size(); ++i) {
+            if (deferredAt[i] == NOT_DEFERRED) {
+                SphereBVHNode node = top[i];
+                node.skipIndex = finalIndex[node.skipIndex];
+                if (node.isLeaf()) {
+                    const auto first = topIndices.begin() + node.firstTriangle;
+                    node.firstTriangle = static_cast<uint32_t>(triangleIndices.size());
+                    triangleIndices.insert(triangleIndices.end(), first, first + node.triangleCount);
+                }
+                nodes.push_back(node);
+                continue;
+            }
 
-        return node;
+            const DeferredSubtree &subtree = deferred[deferredAt[i]];
+            const uint32_t nodeOffset = finalIndex[i];
+            const uint32_t triangleOffset = static_cast<uint32_t>(triangleIndices.size());
+            for (SphereBVHNode node : subtree.nodes) {
+                node.skipIndex += nodeOffset;
+                if (node.isLeaf()) {
+                    node.firstTriangle += triangleOffset;
+                }
+                nodes.push_back(node);
+            }
+            triangleIndices.insert(triangleIndices.end(), subtree.triangleIndices.begin(), subtree.triangleIndices.end());
+        }
     }
 }
 
 
-static constexpr size_t MAX_MANIFOLD_CONTACTS = 4;
-
 // ── helpers ──────────────────────────────────────────────────────────
 
-static bool spheresOverlap(const SphereCollider& a, const SphereCollider& b) {
-    float radiusSum = a.radius + b.radius;
-    return glm::length2(b.center - a.center) < radiusSum * radiusSum;
+static bool spheresOverlap(const glm::vec3& centerA, float radiusA, const glm::vec3& centerB, float radiusB) {
+    float radiusSum = radiusA + radiusB;
+    return glm::length2(centerB - centerA) < radiusSum * radiusSum;
 }
 
-// Reduces a set of contacts down to at most MAX_MANIFOLD_CONTACTS that
-// best represent the contact surface. Strategy:
-//   1. Keep the deepest penetration (most important for stability)
-//   2. Keep the point farthest from #1 (maximise spread)
-//   3. Keep the point that maximises triangle area with #1 and #2
-//   4. Keep the point that maximises quadrilateral area with #1, #2, #3
-static void reduceManifold(std::vector<ContactInfo>& contacts) {
-    if (contacts.size() <= MAX_MANIFOLD_CONTACTS) return;
-
-    std::vector<ContactInfo> reduced;
-    reduced.reserve(MAX_MANIFOLD_CONTACTS);
+// Contact between two triangles of closed, outward-wound meshes. A separating
+// axis test decides whether the triangles intersect; the contact normal is then
+// the face normal (of either triangle) that the other triangle penetrates least,
+// oriented from a toward b, with depth measured to that triangle's deepest vertex.
+static bool triangleTriangleContact(const std::array<glm::vec3, 3>& a,
+                                    const std::array<glm::vec3, 3>& b,
+                                    glm::vec3& normal, float& depth, glm::vec3& point) {
+    const std::array<glm::vec3, 3> edgesA { a[1] - a[0], a[2] - a[1], a[0] - a[2] };
+    const std::array<glm::vec3, 3> edgesB { b[1] - b[0], b[2] - b[1], b[0] - b[2] };
+    const glm::vec3 faceA = glm::cross(edgesA[0], edgesA[1]);
+    const glm::vec3 faceB = glm::cross(edgesB[0], edgesB[1]);
+    if (glm::length2(faceA) < 1e-20f || glm::length2(faceB) < 1e-20f) {
+        return false; // degenerate triangle
+    }
 
-    // 1. Deepest penetration
-    size_t deepestIdx = 0;
-    for (size_t i = 1; i < contacts.size(); ++i) {
-        if (contacts[i].depth > contacts[deepestIdx].depth) {
-            deepestIdx = i;
+    // Face normals, edge-edge crosses, and in-plane edge normals for coplanar pairs
+    std::array<glm::vec3, 17> axes;
+    size_t axisCount = 0;
+    axes[axisCount++] = faceA;
+    axes[axisCount++] = faceB;
+    for (const auto& ea : edgesA) {
+        for (const auto& eb : edgesB) {
+            axes[axisCount++] = glm::cross(ea, eb);
         }
     }
-    reduced.push_back(contacts[deepestIdx]);
+    for (size_t i = 0; i < 3; ++i) {
+        axes[axisCount++] = glm::cross(faceA, edgesA[i]);
+        axes[axisCount++] = glm::cross(faceB, edgesB[i]);
+    }
 
-    // 2. Farthest from the deepest
-    size_t farthestIdx = 0;
-    float maxDistSq = -1.0f;
-    for (size_t i = 0; i < contacts.size(); ++i) {
-        float dSq = glm::length2(contacts[i].contactPoint - reduced[0].contactPoint);
-        if (dSq > maxDistSq) {
-            maxDistSq = dSq;
-            farthestIdx = i;
+    auto project = [](const std::array<glm::vec3, 3>& tri, const glm::vec3& axis, float& lo, float& hi) {
+        lo = hi = glm::dot(tri[0], axis);
+        for (size_t i = 1; i < 3; ++i) {
+            const float d = glm::dot(tri[i], axis);
+            lo = std::min(lo, d);
+            hi = std::max(hi, d);
         }
-    }
-    reduced.push_back(contacts[farthestIdx]);
-
-    // 3. Maximise triangle area with the first two
-    size_t thirdIdx = 0;
-    float maxArea = -1.0f;
-    glm::vec3 edge = reduced[1].contactPoint - reduced[0].contactPoint;
-    for (size_t i = 0; i < contacts.size(); ++i) {
-        glm::vec3 cross = glm::cross(edge, contacts[i].contactPoint - reduced[0].contactPoint);
-        float area = glm::length2(cross);
-        if (area > maxArea) {
-            maxArea = area;
-            thirdIdx = i;
+    };
+
+    for (size_t i = 0; i < axisCount; ++i) {
+        if (glm::length2(axes[i]) < 1e-20f) continue;
+        float minA, maxA, minB, maxB;
+        project(a, axes[i], minA, maxA);
+        project(b, axes[i], minB, maxB);
+        if (maxA < minB || maxB < minA) {
+            return false;
         }
     }
-    reduced.push_back(contacts[thirdIdx]);
-
-    // 4. Maximise quadrilateral area — pick the point farthest from the
-    //    plane formed by the first three
-    if (MAX_MANIFOLD_CONTACTS >= 4) {
-        glm::vec3 triNormal = glm::cross(
-            reduced[1].contactPoint - reduced[0].contactPoint,
-            reduced[2].contactPoint - reduced[0].contactPoint
-        );
-        float triNormalLen = glm::length(triNormal);
-        if (triNormalLen > 1e-8f) {
-            triNormal /= triNormalLen;
-        }
-
-        size_t fourthIdx = 0;
-        float maxDist = -1.0f;
-        for (size_t i = 0; i < contacts.size(); ++i) {
-            float d = std::abs(glm::dot(contacts[i].contactPoint - reduced[0].contactPoint, triNormal));
-            if (d > maxDist) {
-                maxDist = d;
-                fourthIdx = i;
-            }
-        }
 
-        // Only add if it's meaningfully off-plane; otherwise pick farthest
-        // from centroid of the existing three
-        if (maxDist < 1e-6f) {
-            glm::vec3 centroid = (reduced[0].contactPoint + reduced[1].contactPoint + reduced[2].contactPoint) / 3.0f;
-            float maxCentroidDistSq = -1.0f;
-            for (size_t i = 0; i < contacts.size(); ++i) {
-                float dSq = glm::length2(contacts[i].contactPoint - centroid);
-                if (dSq > maxCentroidDistSq) {
-                    maxCentroidDistSq = dSq;
-                    fourthIdx = i;
-                }
+    // Deepest vertex of `tri` behind the plane through `origin` with unit normal `n`
+    auto deepestBehind = [](const std::array<glm::vec3, 3>& tri, const glm::vec3& origin,
+                            const glm::vec3& n, glm::vec3& vertex) {
+        float deepest = -std::numeric_limits<float>::max();
+        for (const auto& v : tri) {
+            const float d = glm::dot(origin - v, n);
+            if (d > deepest) {
+                deepest = d;
+                vertex = v;
             }
         }
-        reduced.push_back(contacts[fourthIdx]);
+        return std::max(deepest, 0.0f);
+    };
+
+    const glm::vec3 nA = glm::normalize(faceA);
+    const glm::vec3 nB = glm::normalize(faceB);
+    glm::vec3 deepestOfB, deepestOfA;
+    const float depthIntoA = deepestBehind(b, a[0], nA, deepestOfB);
+    const float depthIntoB = deepestBehind(a, b[0], nB, deepestOfA);
+
+    if (depthIntoA <= depthIntoB) {
+        // b is pushed out through a's face
+        normal = nA;
+        depth = depthIntoA;
+        point = deepestOfB + 0.5f * depth * nA;
+    } else {
+        // a is pushed out through b's face
+        normal = -nB;
+        depth = depthIntoB;
+        point = deepestOfA + 0.5f * depth * nB;
     }
+    return true;
+}
 
-    contacts = std::move(reduced);
+static std::array<glm::vec3, 3> meshTriangle(const sauce::modeling::Mesh& mesh, uint32_t triangle) {
+    const auto& vertices = mesh.getVertices();
+    const auto& indices = mesh.getIndices();
+    return {
+        vertices[indices[triangle * 3 + 0]].position,
+        vertices[indices[triangle * 3 + 1]].position,
+        vertices[indices[triangle * 3 + 2]].position,
+    };
 }
 
-// ── SphereBVHNode ────────────────────────────────────────────────────
+// Vertices of the triangles in one leaf, placed by pose
+struct LeafVertices {
+    std::array<glm::vec3, 3 * MAX_TRIANGLES_PER_LEAF> points;
+    uint32_t triangleCount = 0;
+};
 
-bool SphereBVHNode::isLeaf() const {
-    return left == nullptr && right == nullptr;
+static LeafVertices leafVertices(const SphereBVH& tree, const sauce::modeling::Mesh& mesh,
+                                 const SphereBVHNode& leaf, const RigidPose& pose) {
+    LeafVertices vertices;
+    vertices.triangleCount = leaf.triangleCount;
+    for (uint32_t i = 0; i < leaf.triangleCount; ++i) {
+        const auto triangle = meshTriangle(mesh, tree.getTriangleIndices()[leaf.firstTriangle + i]);
+        for (uint32_t k = 0; k < 3; ++k) {
+            vertices.points[3 * i + k] = pose.transformPoint(triangle[k]);
+        }
+    }
+    return vertices;
 }
 
-bool SphereBVHNode::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
-    const auto* otherSphere = dynamic_cast<const SphereCollider*>(&collider);
-    if (!otherSphere) return false;
+// Overlap of the two leaves' vertex extents along n, which points from A toward B
+static float leafOverlap(const LeafVertices& leafA, const LeafVertices& leafB, const glm::vec3& n) {
+    float maxA = -std::numeric_limits<float>::max();
+    for (uint32_t v = 0; v < 3 * leafA.triangleCount; ++v) {
+        maxA = std::max(maxA, glm::dot(leafA.points[v], n));
+    }
+    float minB = std::numeric_limits<float>::max();
+    for (uint32_t v = 0; v < 3 * leafB.triangleCount; ++v) {
+        minB = std::min(minB, glm::dot(leafB.points[v], n));
+    }
+    return maxA - minB;
+}
 
-    if (!spheresOverlap(sphere, *otherSphere)) {
-        return false;
+// Contacts [first, end) came from the leaf pair (nodeA, nodeB)
+struct ContactLeafPair {
+    uint32_t nodeA, nodeB;
+    size_t first, end;
+};
+
+// Triangle pairs only see local features, so an edge crossing can report a
+// face normal far from the true separating direction. The distinct normals
+// of the shallowest contacts, plus the leaves' own face normals, are
+// candidate axes; each overlapping leaf pair measures the overlap of its two
+// leaves' vertex extents along every candidate and turns its contacts onto
+// the axis with the least overlap, no deeper than it. Only the leaves that
+// produced the contacts are visited, and leaf pairs choose independently, so
+// a body resting in a concave region keeps a contact patch against each
+// surface it touches for reduceManifold to reduce separately.
+static void selectLeafPairNormals(std::vector<ContactInfo>& contacts, size_t first,
+                                  const std::vector<ContactLeafPair>& leafPairs,
+                                  const SphereBVH& treeA, const sauce::modeling::Mesh& meshA,
+                                  const SphereBVH& treeB, const sauce::modeling::Mesh& meshB,
+                                  const RigidPose& bInA) {
+    constexpr size_t MAX_NORMAL_CANDIDATES = 8;
+    constexpr float SAME_NORMAL_COS = 0.999f;
+
+    struct Candidate {
+        glm::vec3 normal;
+        float depth;
+    };
+    std::array<Candidate, MAX_NORMAL_CANDIDATES> candidates;
+    size_t candidateCount = 0;
+    for (auto it = contacts.begin() + static_cast<std::ptrdiff_t>(first); it != contacts.end(); ++it) {
+        const auto end = candidates.begin() + static_cast<std::ptrdiff_t>(candidateCount);
+        const auto same = std::find_if(candidates.begin(), end, [&](const Candidate& c) {
+            return glm::dot(c.normal, it->contactNormal) > SAME_NORMAL_COS;
+        });
+        if (same != end) {
+            same->depth = std::min(same->depth, it->depth);
+        } else if (candidateCount < MAX_NORMAL_CANDIDATES) {
+            candidates[candidateCount++] = { it->contactNormal, it->depth };
+        } else {
+            // Full: the deepest candidate gives way to a shallower normal
+            const auto deepest = std::max_element(candidates.begin(), end, [](const Candidate& l, const Candidate& r) {
+                return l.depth < r.depth;
+            });
+            if (it->depth < deepest->depth) {
+                *deepest = { it->contactNormal, it->depth };
+            }
+        }
     }
 
-    if (isLeaf()) {
-        return sphere.checkCollision(*otherSphere, info);
+    const RigidPose identity;
+    for (const ContactLeafPair& pair : leafPairs) {
+        const LeafVertices leafA = leafVertices(treeA, meshA, treeA.getNodes()[pair.nodeA], identity);
+        const LeafVertices leafB = leafVertices(treeB, meshB, treeB.getNodes()[pair.nodeB], bInA);
+
+        glm::vec3 bestNormal = contacts[pair.first].contactNormal;
+        float bestOverlap = leafOverlap(leafA, leafB, bestNormal);
+        auto tryAxis = [&](const glm::vec3& n) {
+            const float overlap = leafOverlap(leafA, leafB, n);
+            if (overlap < bestOverlap) {
+                bestOverlap = overlap;
+                bestNormal = n;
+            }
+        };
+        for (size_t c = 0; c < candidateCount; ++c) {
+            tryAxis(candidates[c].normal);
+        }
+        // A's faces point toward B as they are; B's are flipped
+        for (const auto* leaf : { &leafA, &leafB }) {
+            const float sign = leaf == &leafA ? 1.0f : -1.0f;
+            for (uint32_t t = 0; t < leaf->triangleCount; ++t) {
+                const glm::vec3* v = &leaf->points[3 * t];
+                const glm::vec3 face = glm::cross(v[1] - v[0], v[2] - v[0]);
+                const float lengthSq = glm::length2(face);
+                if (lengthSq > 1e-12f) {
+                    tryAxis(face * (sign / std::sqrt(lengthSq)));
+                }
+            }
+        }
+
+        for (size_t i = pair.first; i < pair.end; ++i) {
+            contacts[i].contactNormal = bestNormal;
+            contacts[i].depth = std::clamp(bestOverlap, 0.0f, contacts[i].depth);
+        }
     }
+}
+
+// ── SphereBVH ────────────────────────────────────────────────────────
 
-    bool hitLeft  = left  ? left->checkCollision(collider, info)  : false;
-    bool hitRight = right ? right->checkCollision(collider, info) : false;
-    return hitLeft || hitRight;
+SphereBVH SphereBVH::fromMesh(const sauce::modeling::Mesh& mesh, BuildStrategy strategy) {
+    std::vector<TriangleInfo> triangles;
+    triangles.reserve(mesh.getIndices().size() / 3);
+    appendTriangles(mesh, triangles);
+
+    SphereBVH bvh;
+    bvh.strategy = strategy;
+    buildFlat(triangles, strategy, bvh.nodes, bvh.triangleIndices);
+    bvh.buildCost = bvh.getCost();
+    return bvh;
 }
 
-std::unique_ptr<SphereBVHNode> SphereBVHNode::fromMesh(sauce::modeling::Mesh& mesh) {
+void SphereBVH::refit(const sauce::modeling::Mesh& mesh) {
     const auto &vertices = mesh.getVertices();
     const auto &indices = mesh.getIndices();
 
-    if (indices.empty() || vertices.empty()) {
-        return nullptr;
+    // Children follow their parent in depth-first order, so a reverse sweep
+    // sees both children of a node before the node itself
+    for (size_t n = nodes.size(); n-- > 0;) {
+        SphereBVHNode &node = nodes[n];
+        if (!node.isLeaf()) {
+            const SphereBVHNode &left = nodes[n + 1];
+            mergeSpheres(node, left, nodes[left.skipIndex]);
+            continue;
+        }
+
+        glm::vec3 minExt(std::numeric_limits<float>::max());
+        glm::vec3 maxExt(std::numeric_limits<float>::lowest());
+        for (uint32_t t = node.firstTriangle; t < node.firstTriangle + node.triangleCount; ++t) {
+            for (uint32_t k = 0; k < 3; ++k) {
+                const glm::vec3 &p = vertices[indices[triangleIndices[t] * 3 + k]].position;
+                minExt = glm::min(minExt, p);
+                maxExt = glm::max(maxExt, p);
+            }
+        }
+
+        node.center = (minExt + maxExt) / 2.0f;
+        float maxRadiusSq = 0.0f;
+        for (uint32_t t = node.firstTriangle; t < node.firstTriangle + node.triangleCount; ++t) {
+            for (uint32_t k = 0; k < 3; ++k) {
+                const glm::vec3 &p = vertices[indices[triangleIndices[t] * 3 + k]].position;
+                maxRadiusSq = std::max(maxRadiusSq, glm::length2(node.center - p));
+            }
+        }
+        node.radius = std::sqrt(maxRadiusSq);
     }
+}
 
-    std::vector<TriangleInfo> triangles;
-    size_t numTriangles = indices.size() / 3;
-    triangles.reserve(numTriangles);
-
-    for (size_t i = 0; i < numTriangles; ++i) {
-        glm::vec3 p0 = vertices[indices[i * 3 + 0]].position;
-        glm::vec3 p1 = vertices[indices[i * 3 + 1]].position;
-        glm::vec3 p2 = vertices[indices[i * 3 + 2]].position;
-
-        triangles.push_back({
-            .idx = static_cast<uint32_t>(i),
-            .v0 = p0, 
-            .v1 = p1, 
-            .v2 = p2,
-            .centroid = (p0 + p1 + p2) / 3.0f 
-        });
+bool SphereBVH::refitOrRebuild(const sauce::modeling::Mesh& mesh, float maxCostGrowth) {
+    if (nodes.empty() || triangleIndices.size() != mesh.getIndices().size() / 3) {
+        *this = fromMesh(mesh, strategy);
+        return true;
     }
 
-    return buildNode(triangles, 0, triangles.size());
+    refit(mesh);
+    if (getCost() > maxCostGrowth * buildCost) {
+        *this = fromMesh(mesh, strategy);
+        return true;
+    }
+    return false;
 }
 
+float SphereBVH::getCost() const {
+    float cost = 0.0f;
+    for (const auto &node : nodes) {
+        cost += node.radius * node.radius;
+    }
+    return cost;
+}
 
-// SphereBVH
-SphereBVH SphereBVH::fromScene(const sauce::Scene& scene) {
-    
-    // make BVH for every mesh
-    std::vector<std::unique_ptr<SphereBVHNode>> spheres;
-    auto &entities = scene.getEntities();
-    for (auto& entity : entities) {
+SphereBVH SphereBVH::fromScene(const sauce::Scene& scene, BuildStrategy strategy) {
+    // Triangle indices run across the meshes in entity order
+    std::vector<TriangleInfo> triangles;
+    for (auto& entity : scene.getEntities()) {
         auto mesh_renderer = entity.getComponent<sauce::MeshRendererComponent>();
-        if (mesh_renderer != nullptr) {
-            spheres.push_back(SphereBVHNode::fromMesh(*mesh_renderer->getMesh()));
+        if (mesh_renderer != nullptr && mesh_renderer->getMesh()) {
+            appendTriangles(*mesh_renderer->getMesh(), triangles);
         }
     }
 
-    
-    // Combine every BVH into a large one or the scene
-    return SphereBVH(buildBVH(spheres, 0, static_cast<int>(spheres.size())));
-
+    SphereBVH bvh;
+    bvh.strategy = strategy;
+    buildFlat(triangles, strategy, bvh.nodes, bvh.triangleIndices);
+    bvh.buildCost = bvh.getCost();
+    return bvh;
 }
 
 bool SphereBVH::checkCollision(const Collider& collider, std::vector<ContactInfo>& info) const {
-    if (!root) return false;
+    if (collider.getType() != ColliderType::Sphere || nodes.empty()) return false;
+    const auto* otherSphere = static_cast<const SphereCollider*>(&collider);
+
+    // Stackless walk: descend into overlapping nodes, jump over the rest.
+    // Leaf contacts are gathered straight into info and reduced there.
+    const size_t first = info.size();
+    SphereCollider leafSphere;
+    for (uint32_t i = 0; i < nodes.size();) {
+        const SphereBVHNode& node = nodes[i];
+        if (!spheresOverlap(node.center, node.radius, otherSphere->center, otherSphere->radius)) {
+            i = node.skipIndex;
+            continue;
+        }
+        if (!node.isLeaf()) {
+            ++i;
+            continue;
+        }
 
-    // Collect all raw contacts from the tree
-    std::vector<ContactInfo> rawContacts;
-    bool hit = root->checkCollision(collider, rawContacts);
+        leafSphere.center = node.center;
+        leafSphere.radius = node.radius;
+        if (leafSphere.checkCollision(*otherSphere, info)) {
+            info.back().pCollider1 = this;
+        }
+        i = node.skipIndex;
+    }
 
-    if (hit && !rawContacts.empty()) {
-        reduceManifold(rawContacts);
-        info.insert(info.end(), rawContacts.begin(), rawContacts.end());
+    if (info.size() == first) {
+        return false;
     }
 
-    return hit;
+    reduceManifold(info, first);
+    return true;
 }
 
-SphereBVHNode *SphereBVH::getRoot() const {
-    return root.get();
+bool SphereBVH::collide(const SphereBVH& treeA, const sauce::modeling::Mesh& meshA, const RigidPose& poseA,
+                        const SphereBVH& treeB, const sauce::modeling::Mesh& meshB, const RigidPose& poseB,
+                        std::vector<ContactInfo>& info) {
+    if (treeA.nodes.empty() || treeB.nodes.empty()) {
+        return false;
+    }
+
+    // Work in A's local frame so only B's spheres and triangles need transforming
+    const RigidPose bInA = poseA.relative(poseB);
+    const auto& nodesA = treeA.nodes;
+    const auto& nodesB = treeB.nodes;
+
+    // Each split replaces one pair with two, so the stack holds up to the two
+    // tree heights combined. SAH trees over skewed meshes can be arbitrarily
+    // deep, so the stack grows; it is kept per thread so steady steps reuse
+    // its capacity instead of allocating.
+    thread_local std::vector<std::pair<uint32_t, uint32_t>> stack;
+    thread_local std::vector<ContactLeafPair> leafPairs;
+    stack.clear();
+    stack.push_back({ 0, 0 });
+    leafPairs.clear();
+
+    const size_t first = info.size();
+    while (!stack.empty()) {
+        const auto [indexA, indexB] = stack.back();
+        stack.pop_back();
+        const SphereBVHNode& nodeA = nodesA[indexA];
+        const SphereBVHNode& nodeB = nodesB[indexB];
+
+        if (!spheresOverlap(nodeA.center, nodeA.radius, bInA.transformPoint(nodeB.center), nodeB.radius)) {
+            continue;
+        }
+
+        if (nodeA.isLeaf() && nodeB.isLeaf()) {
+            const LeafVertices leafA = leafVertices(treeA, meshA, nodeA, RigidPose());
+            const LeafVertices leafB = leafVertices(treeB, meshB, nodeB, bInA);
+            const size_t pairFirst = info.size();
+            for (uint32_t i = 0; i < nodeA.triangleCount; ++i) {
+                const std::array<glm::vec3, 3> triA { leafA.points[3 * i], leafA.points[3 * i + 1], leafA.points[3 * i + 2] };
+                for (uint32_t j = 0; j < nodeB.triangleCount; ++j) {
+                    const std::array<glm::vec3, 3> triB { leafB.points[3 * j], leafB.points[3 * j + 1], leafB.points[3 * j + 2] };
+                    glm::vec3 normal, point;
+                    float depth;
+                    if (triangleTriangleContact(triA, triB, normal, depth, point)) {
+                        info.emplace_back(point, normal, &treeA, &treeB, depth);
+                    }
+                }
+            }
+            if (info.size() > pairFirst) {
+                leafPairs.push_back({ indexA, indexB, pairFirst, info.size() });
+            }
+            continue;
+        }
+
+        // Descend the larger node first so both spheres shrink at a similar rate.
+        // Left child is the next node; the right child starts where the left subtree ends.
+        const bool splitA = nodeB.isLeaf() || (!nodeA.isLeaf() && nodeA.radius >= nodeB.radius);
+        if (splitA) {
+            stack.push_back({ nodesA[indexA + 1].skipIndex, indexB });
+            stack.push_back({ indexA + 1, indexB });
+        } else {
+            stack.push_back({ indexA, nodesB[indexB + 1].skipIndex });
+            stack.push_back({ indexA, indexB + 1 });
+        }
+    }
+
+    if (info.size() == first) {
+        return false;
+    }
+
+    selectLeafPairNormals(info, first, leafPairs, treeA, meshA, treeB, meshB, bInA);
+    reduceManifold(info, first);
+    for (auto it = info.begin() + static_cast<std::ptrdiff_t>(first); it != info.end(); ++it) {
+        it->contactPoint = poseA.transformPoint(it->contactPoint);
+        it->contactNormal = poseA.transformVector(it->contactNormal);
+    }
+    return true;
 }
 
 };
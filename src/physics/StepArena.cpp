@@ -0,0 +1,84 @@
+#include <physics/StepArena.hpp>
+
+#include <algorithm>
+#include <new>
+
+namespace physics {
+
+namespace {
+
+// Alignment of the owned block; larger requests always overflow to the heap
+constexpr size_t kBlockAlignment = 64;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+// Header in front of every heap allocation made past the end of the block
+struct StepArena::Overflow {
+  Overflow* next;
+  size_t size;
+  size_t alignment;
+};
+
+StepArena::StepArena(size_t initialCapacity) {
+  if (initialCapacity > 0) {
+    blockSize = alignUp(initialCapacity, kBlockAlignment);
+    block = static_cast<std::byte*>(::operator new(blockSize, std::align_val_t { kBlockAlignment }));
+  }
+}
+
+StepArena::~StepArena() {
+  releaseOverflow();
+  if (block) {
+    ::operator delete(block, blockSize, std::align_val_t { kBlockAlignment });
+  }
+}
+
+void StepArena::reset() {
+  if (overflowBytes > 0) {
+    // Grow past this step's total so the same workload fits in the block next time
+    const size_t needed = offset + overflowBytes;
+    const size_t grown = alignUp(std::max(needed + needed / 2, blockSize * 2), kBlockAlignment);
+    releaseOverflow();
+    if (block) {
+      ::operator delete(block, blockSize, std::align_val_t { kBlockAlignment });
+    }
+    block = static_cast<std::byte*>(::operator new(grown, std::align_val_t { kBlockAlignment }));
+    blockSize = grown;
+  }
+  offset = 0;
+  overflowBytes = 0;
+}
+
+void* StepArena::do_allocate(size_t bytes, size_t alignment) {
+  if (alignment <= kBlockAlignment) {
+    const size_t start = alignUp(offset, alignment);
+    if (start + bytes <= blockSize) {
+      offset = start + bytes;
+      return block + start;
+    }
+  }
+
+  alignment = std::max(alignment, alignof(Overflow));
+  const size_t header = alignUp(sizeof(Overflow), alignment);
+  const size_t size = header + bytes;
+  auto* chunk = static_cast<Overflow*>(::operator new(size, std::align_val_t { alignment }));
+  *chunk = { overflowChunks, size, alignment };
+  overflowChunks = chunk;
+  overflowBytes += bytes + alignment;
+  ++overflows;
+  return reinterpret_cast<std::byte*>(chunk) + header;
+}
+
+void StepArena::releaseOverflow() {
+  while (overflowChunks) {
+    Overflow* chunk = overflowChunks;
+    overflowChunks = chunk->next;
+    ::operator delete(chunk, chunk->size, std::align_val_t { chunk->alignment });
+  }
+}
+
+} // namespace physics
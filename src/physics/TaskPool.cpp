@@ -0,0 +1,112 @@
+#include <physics/TaskPool.hpp>
+
+#include <algorithm>
+
+namespace physics {
+
+namespace {
+
+thread_local bool tInsideJob = false;
+
+} // namespace
+
+TaskPool::TaskPool(unsigned threadCount) {
+  if (threadCount == 0) {
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+  }
+
+  workers.reserve(threadCount);
+  for (unsigned i = 0; i < threadCount; ++i) {
+    workers.emplace_back([this] { workerLoop(); });
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wakeCondition.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+TaskPool& TaskPool::shared() {
+  static TaskPool pool;
+  return pool;
+}
+
+void TaskPool::runIndices(const std::function<void(size_t)>& fn, size_t count) {
+  const bool wasInsideJob = tInsideJob;
+  tInsideJob = true;
+  for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+    fn(i);
+  }
+  tInsideJob = wasInsideJob;
+}
+
+void TaskPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+  if (count == 0) {
+    return;
+  }
+
+  if (count == 1 || workers.empty() || tInsideJob) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  // Only one job is in flight at a time; concurrent callers queue up here
+  std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobCount = count;
+    nextIndex.store(0);
+    ++generation;
+  }
+  wakeCondition.notify_all();
+
+  runIndices(fn, count);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCondition.wait(lock, [this] { return activeWorkers == 0; });
+  job = nullptr;
+  jobCount = 0;
+}
+
+void TaskPool::workerLoop() {
+  uint64_t seenGeneration = 0;
+
+  while (true) {
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+    if (stopping) {
+      return;
+    }
+
+    seenGeneration = generation;
+    // Woke up after the caller already finished this job
+    if (!job) {
+      continue;
+    }
+
+    const auto* fn = job;
+    const size_t count = jobCount;
+    ++activeWorkers;
+    lock.unlock();
+
+    runIndices(*fn, count);
+
+    lock.lock();
+    if (--activeWorkers == 0) {
+      doneCondition.notify_all();
+    }
+  }
+}
+
+} // namespace physics
@@ -1,6 +1,18 @@
 #include <physics/XPBD.hpp>
+#include <physics/BoxCollider.hpp>
+#include <physics/CapsuleCollider.hpp>
 #include <physics/Cloth.hpp>
+#include <physics/ClothCCD.hpp>
+#include <physics/ContactManifold.hpp>
+#include <physics/ConvexCollider.hpp>
+#include <physics/HeightfieldCollider.hpp>
+#include <physics/Narrowphase.hpp>
+#include <physics/OverlapKernels.hpp>
+#include <physics/PhysicsProfiler.hpp>
+#include <physics/PlaneCollider.hpp>
+#include <physics/SphereBVH.hpp>
 #include <physics/SphereCollider.hpp>
+#include <physics/TaskPool.hpp>
 #include <physics/ContactInfo.hpp>
 #include <physics/Vertex.hpp>
 #include <physics/constraints/Constraint.hpp>
@@ -16,13 +28,31 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <variant>
 
 namespace physics {
 
+// Constraints one narrowphase chunk emitted, each with the active island slot
+// it belongs to
+struct NarrowphaseChunk {
+  std::vector<ContactInfo> contacts;
+  std::pmr::vector<CollisionConstraint> constraints;
+  std::vector<uint32_t> islandSlots;
+  uint32_t contactPairs = 0;
+};
+
 namespace {
 
 constexpr float kBendEps = 1e-10f;
 
+// Narrowphase items per chunk: enough to amortize dispatching a chunk, few
+// enough that a step with a handful of contact-heavy pairs still splits
+constexpr size_t kNarrowphaseChunkItems = 16;
+
 void resetClothLambdas(ClothData& cloth) {
   for (auto& c : cloth.stretchConstraints) {
     c.resetLambda();
@@ -160,40 +190,807 @@ void projectBend(std::vector<ClothParticle>& particles, BendConstraint& c, float
   }
 }
 
-} // namespace
+// Pushes each free particle that ended the substep closer than thickness to a
+// static field's surface (or inside it) back out along the field's gradient.
+// Fields store distance in their local frame, so the particle is moved there
+// and the correction rotated back.
+void projectDistanceFields(std::vector<ClothParticle>& particles,
+                           std::span<const DistanceFieldCollider> fields,
+                           float thickness) {
+  for (const auto& collider : fields) {
+    if (!collider.field || collider.field->empty()) {
+      continue;
+    }
+    const SignedDistanceField& field = *collider.field;
+    for (auto& p : particles) {
+      if (p.isStatic()) {
+        continue;
+      }
+      const auto sample = field.sample(collider.pose.inverseTransformPoint(p.predictedPosition));
+      if (sample.distance >= thickness || sample.gradient == glm::vec3(0.0f)) {
+        continue;
+      }
+      p.predictedPosition += collider.pose.transformVector(sample.gradient) * (thickness - sample.distance);
+    }
+  }
+}
+
+// Keeps each free particle at least thickness above every terrain it is over
+void projectHeightfields(std::vector<ClothParticle>& particles,
+                         std::span<const std::shared_ptr<const HeightfieldCollider>> heightfields,
+                         float thickness) {
+  for (const auto& terrain : heightfields) {
+    if (!terrain) {
+      continue;
+    }
+    for (auto& p : particles) {
+      float distance;
+      glm::vec3 normal;
+      if (p.isStatic() || !terrain->pointDistance(p.predictedPosition, distance, normal) || distance >= thickness) {
+        continue;
+      }
+      p.predictedPosition += normal * (thickness - distance);
+    }
+  }
+}
+
+bool hasCollisionMesh(sauce::RigidBodyComponent& rigidBody) {
+  auto* owner = rigidBody.getOwner();
+  auto* meshRenderer = owner ? owner->getComponent<sauce::MeshRendererComponent>() : nullptr;
+  return meshRenderer && meshRenderer->getMesh() && !meshRenderer->getMesh()->getVertices().empty();
+}
+
+// Bodies collide through an analytic collider when they have one, else through their mesh
+bool hasCollisionShape(sauce::RigidBodyComponent& rigidBody) {
+  return rigidBody.getCollider().has_value() || hasCollisionMesh(rigidBody);
+}
 
-void XPBDSolver::solvePositions(
+using PrimitiveShape =
+    std::variant<std::monostate, SphereCollider, BoxCollider, CapsuleCollider, PlaneCollider, ConvexCollider>;
+
+const Collider* asCollider(const PrimitiveShape& primitive) {
+  return std::visit([](const auto& shape) -> const Collider* {
+    if constexpr (std::is_same_v<std::decay_t<decltype(shape)>, std::monostate>) {
+      return nullptr;
+    } else {
+      return &shape;
+    }
+  }, primitive);
+}
+
+// Bounding sphere for each rigid body, indexed like rigidBodies. Bodies with an
+// analytic collider also carry it in world space; planes have no finite bound.
+// With speculative contacts the shapes sit at the start-of-step pose and sweep
+// is the displacement the body integrates to this step.
+struct BodySphere {
+  bool valid = false;
+  SphereCollider sphere;
+  std::shared_ptr<sauce::modeling::Mesh> mesh;
+  RigidPose pose;
+  PrimitiveShape primitive;
+  glm::vec3 sweep = glm::vec3(0.0f);
+
+  const Collider* primitiveCollider() const { return asCollider(primitive); }
+  const PlaneCollider* plane() const { return std::get_if<PlaneCollider>(&primitive); }
+  bool convex() const { return std::holds_alternative<ConvexCollider>(primitive); }
+};
+
+// Places a body's ColliderInfo in world space and returns its bounding radius.
+// A ConvexHull collider without a hull leaves primitive empty.
+float placePrimitive(const sauce::modeling::ColliderInfo& info, const RigidPose& pose,
+                     const std::shared_ptr<const sauce::modeling::ConvexHull>& hull, PrimitiveShape& primitive) {
+  using Shape = sauce::modeling::ColliderInfo::Shape;
+  const glm::vec3 center = pose.transformPoint(info.offset);
+
+  switch (info.shape) {
+    case Shape::Sphere: {
+      SphereCollider sphere;
+      sphere.center = center;
+      sphere.radius = info.radius;
+      primitive = sphere;
+      return glm::length(info.offset) + info.radius;
+    }
+    case Shape::Box: {
+      BoxCollider box;
+      box.center = center;
+      box.halfExtents = info.halfExtents;
+      box.orientation = pose.orientation;
+      primitive = box;
+      return glm::length(info.offset) + glm::length(info.halfExtents);
+    }
+    case Shape::Capsule: {
+      CapsuleCollider capsule;
+      capsule.center = center;
+      capsule.orientation = pose.orientation;
+      capsule.halfHeight = info.halfHeight;
+      capsule.radius = info.radius;
+      primitive = capsule;
+      return glm::length(info.offset) + info.halfHeight + info.radius;
+    }
+    case Shape::Plane: {
+      PlaneCollider plane;
+      plane.normal = pose.transformVector(info.normal);
+      plane.offset = glm::dot(plane.normal, center);
+      primitive = plane;
+      return std::numeric_limits<float>::infinity();
+    }
+    case Shape::ConvexHull: {
+      if (!hull || hull->empty()) {
+        return 0.0f;
+      }
+      ConvexCollider convex;
+      convex.hull = hull;
+      convex.pose = { center, pose.orientation };
+      primitive = convex;
+      return glm::length(info.offset) + hull->boundingRadius();
+    }
+  }
+  return 0.0f;
+}
+
+// displacements, when given, holds each body's integrated motion this step;
+// the shapes are then placed where the step started
+std::pmr::vector<BodySphere> computeBodySpheres(
     std::vector<sauce::RigidBodyComponent>& rigidBodies,
-    std::vector<std::unique_ptr<Constraint>>& constraints,
-    float deltatime) {
+    std::span<const glm::vec3> displacements = {},
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+  std::pmr::vector<BodySphere> spheres(rigidBodies.size(), resource);
+
+  for (size_t i = 0; i < rigidBodies.size(); ++i) {
+    auto& rb = rigidBodies[i];
+    const bool hasMesh = hasCollisionMesh(rb);
+    if (!hasMesh && !rb.getCollider()) continue;
+
+    const glm::vec3 sweep = displacements.empty() ? glm::vec3(0.0f) : displacements[i];
+    spheres[i].valid = true;
+    spheres[i].sweep = sweep;
+    spheres[i].sphere.center = rb.getPosition() - sweep;
+    spheres[i].pose = { rb.getPosition() - sweep, rb.getOrientation() };
+    if (hasMesh) {
+      spheres[i].mesh = rb.getOwner()->getComponent<sauce::MeshRendererComponent>()->getMesh();
+    }
+
+    if (rb.getCollider()) {
+      const bool convex = rb.getCollider()->shape == sauce::modeling::ColliderInfo::Shape::ConvexHull;
+      const auto hull = convex && hasMesh ? spheres[i].mesh->getConvexHull() : nullptr;
+      spheres[i].sphere.radius = placePrimitive(*rb.getCollider(), spheres[i].pose, hull, spheres[i].primitive);
+      if (spheres[i].primitiveCollider()) {
+        continue;
+      }
+      if (!hasMesh) {
+        spheres[i].valid = false;
+        continue;
+      }
+    }
+
+    // Mesh vertices are in the body's local frame, so the radius is measured
+    // from the local origin and the sphere follows the body position
+    float maxRadiusSq = 0.0f;
+    for (const auto& v : spheres[i].mesh->getVertices()) {
+      maxRadiusSq = std::max(maxRadiusSq, glm::length2(v.position));
+    }
+    spheres[i].sphere.radius = std::sqrt(maxRadiusSq);
+  }
+
+  return spheres;
+}
+
+bool isAwakeDynamic(const sauce::RigidBodyComponent& rb) {
+  return rb.getInvMass() > 0.0f && !rb.isSleeping();
+}
+
+// Bounds cover the whole swept motion: a sphere around the midpoint of the
+// sweep, grown by half its length
+bool boundsOverlap(const BodySphere& a, const BodySphere& b) {
+  const glm::vec3 centerA = a.sphere.center + 0.5f * a.sweep;
+  const glm::vec3 centerB = b.sphere.center + 0.5f * b.sweep;
+  const float radiusA = a.sphere.radius + 0.5f * glm::length(a.sweep);
+  const float radiusB = b.sphere.radius + 0.5f * glm::length(b.sweep);
+
+  const PlaneCollider* planeA = a.plane();
+  const PlaneCollider* planeB = b.plane();
+  if (planeA && planeB) {
+    return false;
+  }
+  if (planeA) {
+    return planeA->signedDistance(centerB) <= radiusB;
+  }
+  if (planeB) {
+    return planeB->signedDistance(centerA) <= radiusA;
+  }
+
+  const float radiusSum = radiusA + radiusB;
+  return glm::length2(centerB - centerA) <= radiusSum * radiusSum;
+}
+
+// Grows a shape by margin so the narrowphase also reports pairs that are up to
+// margin apart; their contact depths come back offset by margin
+void inflate(PrimitiveShape& primitive, float margin) {
+  std::visit([margin](auto& shape) {
+    using Shape = std::decay_t<decltype(shape)>;
+    if constexpr (std::is_same_v<Shape, SphereCollider> || std::is_same_v<Shape, CapsuleCollider>) {
+      shape.radius += margin;
+    } else if constexpr (std::is_same_v<Shape, BoxCollider>) {
+      shape.halfExtents += glm::vec3(margin);
+    } else if constexpr (std::is_same_v<Shape, PlaneCollider>) {
+      shape.offset += margin;
+    } else if constexpr (std::is_same_v<Shape, ConvexCollider>) {
+      shape.margin += margin;
+    }
+  }, primitive);
+}
+
+uint64_t pairKey(const BodyPair& pair) {
+  return (static_cast<uint64_t>(pair.a) << 32) | pair.b;
+}
+
+// Broadphase pairs with at least one dynamic body. Pairs of two sleeping
+// bodies are skipped, as nothing in them can move, unless keepSleeping: the
+// step builds islands from them so that waking one body wakes every body
+// resting on it in the same step.
+std::pmr::vector<BodyPair> overlappingPairs(
+    const std::vector<sauce::RigidBodyComponent>& rigidBodies,
+    std::span<const BodySphere> spheres,
+    bool keepSleeping = false,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+  std::pmr::vector<BodyPair> pairs(resource);
+  const size_t count = spheres.size();
+
+  // Swept bounds of every non-plane body, structure-of-arrays so each body is
+  // tested against all later ones with the batched kernel. Planes and bodies
+  // without a shape sit at infinity where nothing reaches them; planes are
+  // paired separately through boundsOverlap.
+  std::pmr::vector<float> x(count, std::numeric_limits<float>::infinity(), resource);
+  std::pmr::vector<float> y(count, 0.0f, resource);
+  std::pmr::vector<float> z(count, 0.0f, resource);
+  std::pmr::vector<float> radius(count, 0.0f, resource);
+  std::pmr::vector<uint32_t> planes(resource);
+  for (uint32_t i = 0; i < static_cast<uint32_t>(count); ++i) {
+    if (!spheres[i].valid) continue;
+    if (spheres[i].plane()) {
+      planes.push_back(i);
+      continue;
+    }
+    const glm::vec3 center = spheres[i].sphere.center + 0.5f * spheres[i].sweep;
+    x[i] = center.x;
+    y[i] = center.y;
+    z[i] = center.z;
+    radius[i] = spheres[i].sphere.radius + 0.5f * glm::length(spheres[i].sweep);
+  }
+  const SphereSoA bounds { x.data(), y.data(), z.data(), radius.data() };
+
+  std::pmr::vector<uint32_t> candidates(count, resource);
+  for (uint32_t i = 0; i < static_cast<uint32_t>(count); ++i) {
+    if (!spheres[i].valid) continue;
+
+    size_t candidateCount = 0;
+    if (spheres[i].plane()) {
+      for (uint32_t j = i + 1; j < static_cast<uint32_t>(count); ++j) {
+        if (spheres[j].valid && boundsOverlap(spheres[i], spheres[j])) {
+          candidates[candidateCount++] = j;
+        }
+      }
+    } else {
+      candidateCount = overlapSphereSpheres(glm::vec3(x[i], y[i], z[i]), radius[i], bounds,
+                                            i + 1, count, candidates.data());
+      // Merge in the later planes so pairs stay ordered by j
+      const size_t sphereCount = candidateCount;
+      for (auto p = std::upper_bound(planes.begin(), planes.end(), i); p != planes.end(); ++p) {
+        if (boundsOverlap(spheres[i], spheres[*p])) {
+          candidates[candidateCount++] = *p;
+        }
+      }
+      std::inplace_merge(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(sphereCount),
+                         candidates.begin() + static_cast<std::ptrdiff_t>(candidateCount));
+    }
+
+    for (size_t c = 0; c < candidateCount; ++c) {
+      const uint32_t j = candidates[c];
+      const bool dynamicPair = rigidBodies[i].getInvMass() > 0.0f || rigidBodies[j].getInvMass() > 0.0f;
+      if (!dynamicPair || (!keepSleeping && !isAwakeDynamic(rigidBodies[i]) && !isAwakeDynamic(rigidBodies[j]))) {
+        continue;
+      }
+      pairs.push_back({ i, j });
+    }
+  }
+
+  return pairs;
+}
+
+// Narrowphase for one broadphase pair. If either body has an analytic collider
+// the pair goes through the primitive pair table, with a mesh body standing in
+// as its bounding sphere. Otherwise, with a mesh BVH source the triangle meshes
+// are tested against each other, or when either mesh has no hierarchy the
+// bounding spheres are used. For every contact produced, emit a CollisionConstraint.
+// contacts is scratch space, cleared on entry.
+//
+// Shapes that sweep this step are tested at their start poses, grown by the
+// relative sweep length. A contact may then have negative depth (a gap); its
+// constraint lets the bodies close the gap but not pass through each other.
+// Triangle meshes have no margin and are tested at their end-of-step poses.
+// Substeps move each body along its own path within the step, so there the
+// margin covers both sweeps: resting bodies that fall together keep their
+// contact instead of losing it whenever they end a step just apart.
+//
+// A pair with a convex hull gets one GJK/EPA contact per step. With a
+// manifold, that contact joins the points kept from earlier steps and the
+// pair emits all of them.
+void emitContactConstraints(const BodyPair& pair,
+                            std::span<const BodySphere> spheres,
+                            XPBDSolver* meshBVHSource,
+                            bool substepping,
+                            ContactManifold* manifold,
+                            std::vector<ContactInfo>& contacts,
+                            std::pmr::vector<CollisionConstraint>& constraints) {
+  const auto& a = spheres[pair.a];
+  const auto& b = spheres[pair.b];
+
+  const float margin = substepping ? glm::length(a.sweep) + glm::length(b.sweep)
+                                   : glm::length(b.sweep - a.sweep);
+  RigidPose poseA = a.pose;
+  RigidPose poseB = b.pose;
+
+  contacts.clear();
+  if (a.primitiveCollider() || b.primitiveCollider()) {
+    PrimitiveShape shapeA = a.primitive;
+    if (std::holds_alternative<std::monostate>(shapeA)) {
+      shapeA = a.sphere;
+    }
+    inflate(shapeA, margin);
+    const Collider* primitiveB = b.primitiveCollider();
+    if (!collide(*asCollider(shapeA), primitiveB ? *primitiveB : b.sphere, contacts)) {
+      if (manifold) {
+        manifold->clear();
+      }
+      return;
+    }
+    for (auto& c : contacts) {
+      c.depth -= margin;
+    }
+    // Hull-vs-plane contacts already cover the whole face
+    if (manifold && contacts.size() == 1) {
+      const ContactInfo c = contacts[0];
+      manifold->refresh(poseA, poseB, margin);
+      manifold->add(poseA, poseB, c.contactPoint + c.contactNormal * (0.5f * (c.depth - margin)),
+                    c.contactPoint - c.contactNormal * (0.5f * (c.depth + margin)), c.contactNormal);
+      contacts.clear();
+      manifold->appendContacts(c.pCollider1, c.pCollider2, contacts);
+    }
+  } else {
+    const SphereBVH* treeA = meshBVHSource ? meshBVHSource->getMeshBVH(a.mesh) : nullptr;
+    const SphereBVH* treeB = meshBVHSource ? meshBVHSource->getMeshBVH(b.mesh) : nullptr;
+
+    if (treeA && treeB) {
+      poseA.position += a.sweep;
+      poseB.position += b.sweep;
+      if (!SphereBVH::collide(*treeA, *a.mesh, poseA, *treeB, *b.mesh, poseB, contacts)) {
+        return;
+      }
+    } else {
+      SphereCollider inflatedA = a.sphere;
+      inflatedA.radius += margin;
+      if (!inflatedA.checkCollision(b.sphere, contacts)) {
+        return;
+      }
+      for (auto& c : contacts) {
+        c.depth -= margin;
+      }
+    }
+  }
+
+  for (const auto& c : contacts) {
+    // Substeps carry angular velocity, so there each body takes the contact
+    // point along as it moves and turns, and a push off its center spins it.
+    // A single step keeps no angular velocity and pushes the centers alone.
+    // Either way the two attached points must separate by the contact depth.
+    const glm::vec3 armA = substepping ? poseA.inverseTransformPoint(c.contactPoint) : glm::vec3(0.0f);
+    const glm::vec3 armB = substepping ? poseB.inverseTransformPoint(c.contactPoint) : glm::vec3(0.0f);
+    const float restDistance =
+        glm::dot(poseB.transformPoint(armB) - poseA.transformPoint(armA), c.contactNormal) + c.depth;
+    constraints.emplace_back(
+        pair.a,
+        pair.b,
+        c.contactNormal,
+        c.depth,
+        armA,
+        armB,
+        0.0f, // zero compliance = perfectly rigid contact
+        restDistance
+    );
+  }
+}
+
+// Contacts between one dynamic body and the terrain, its shape grown by its
+// sweep like emitContactConstraints. Terrain never moves, so every contact
+// becomes a static constraint: the body center may close a gap of the
+// contact's depth along the normal but not move past it.
+void emitHeightfieldConstraints(uint32_t body,
+                                const BodySphere& bounds,
+                                std::span<const std::shared_ptr<const HeightfieldCollider>> heightfields,
+                                std::vector<ContactInfo>& contacts,
+                                std::pmr::vector<CollisionConstraint>& constraints) {
+  if (!bounds.valid || bounds.plane()) {
+    return;
+  }
+  const float margin = glm::length(bounds.sweep);
+  PrimitiveShape shape = bounds.primitive;
+  if (std::holds_alternative<std::monostate>(shape)) {
+    shape = bounds.sphere;
+  }
+  inflate(shape, margin);
+
+  for (const auto& terrain : heightfields) {
+    contacts.clear();
+    if (!terrain || !terrain->checkCollision(*asCollider(shape), contacts)) {
+      continue;
+    }
+    for (const auto& c : contacts) {
+      constraints.emplace_back(body, bounds.pose.position + c.contactNormal * (c.depth - margin), c.contactNormal);
+    }
+  }
+}
+
+// One unit of narrowphase work: a body pair, or a dynamic body against the
+// terrain, whose constraints go to the list of active island slot
+struct NarrowphaseItem {
+  uint32_t slot;
+  uint32_t index;
+  bool terrain;
+};
+
+// Runs the items in chunks of kNarrowphaseChunkItems, concurrently when
+// parallel is set, then appends every chunk's constraints in item order to
+// islandConstraints[slot]. Chunk boundaries only depend on the item count,
+// and each chunk only touches its own buffers and the manifolds of its own
+// pairs, so the merged lists match a serial run. Mesh hierarchies must
+// already be cached in meshBVHSource. Returns the number of items that
+// produced a contact.
+uint32_t runNarrowphase(std::span<const NarrowphaseItem> items,
+                        std::span<const BodySphere> spheres,
+                        std::span<const BodyPair> pairs,
+                        XPBDSolver* meshBVHSource,
+                        bool substepping,
+                        std::unordered_map<uint64_t, ContactManifold>* manifolds,
+                        std::span<const std::shared_ptr<const HeightfieldCollider>> heightfields,
+                        bool parallel,
+                        std::vector<NarrowphaseChunk>& chunks,
+                        std::span<std::pmr::vector<CollisionConstraint>> islandConstraints) {
+  const size_t chunkCount = (items.size() + kNarrowphaseChunkItems - 1) / kNarrowphaseChunkItems;
+  if (chunks.size() < chunkCount) {
+    chunks.resize(chunkCount);
+  }
+
+  auto runChunk = [&](size_t c) {
+    NarrowphaseChunk& chunk = chunks[c];
+    chunk.constraints.clear();
+    chunk.islandSlots.clear();
+    chunk.contactPairs = 0;
+
+    const size_t end = std::min(items.size(), (c + 1) * kNarrowphaseChunkItems);
+    for (size_t k = c * kNarrowphaseChunkItems; k < end; ++k) {
+      const NarrowphaseItem& item = items[k];
+      const size_t before = chunk.constraints.size();
+      if (item.terrain) {
+        emitHeightfieldConstraints(item.index, spheres[item.index], heightfields, chunk.contacts,
+                                   chunk.constraints);
+      } else {
+        const BodyPair& pair = pairs[item.index];
+        ContactManifold* manifold = nullptr;
+        if (manifolds) {
+          auto it = manifolds->find(pairKey(pair));
+          manifold = it != manifolds->end() ? &it->second : nullptr;
+        }
+        emitContactConstraints(pair, spheres, meshBVHSource, substepping, manifold, chunk.contacts,
+                               chunk.constraints);
+      }
+      const size_t emitted = chunk.constraints.size() - before;
+      chunk.islandSlots.insert(chunk.islandSlots.end(), emitted, item.slot);
+      chunk.contactPairs += emitted > 0 ? 1 : 0;
+    }
+  };
+  if (parallel && chunkCount > 1) {
+    TaskPool::shared().parallelFor(chunkCount, std::ref(runChunk));
+  } else {
+    for (size_t c = 0; c < chunkCount; ++c) {
+      runChunk(c);
+    }
+  }
+
+  uint32_t contactPairs = 0;
+  for (size_t c = 0; c < chunkCount; ++c) {
+    const NarrowphaseChunk& chunk = chunks[c];
+    for (size_t k = 0; k < chunk.constraints.size(); ++k) {
+      islandConstraints[chunk.islandSlots[k]].push_back(chunk.constraints[k]);
+    }
+    contactPairs += chunk.contactPairs;
+  }
+  return contactPairs;
+}
+
+// projectConstraints for one island's contacts, stored by value so the calls
+// are direct
+void projectContacts(std::span<physics::Vertex> vertices,
+                     std::span<CollisionConstraint> contacts,
+                     int iterations,
+                     float deltatime) {
+  if (vertices.empty() || contacts.empty()) {
+    return;
+  }
+
+  for (auto& contact : contacts) {
+    contact.resetLambda();
+  }
+  for (int iter = 0; iter < iterations; ++iter) {
+    for (auto& contact : contacts) {
+      contact.solve(vertices, deltatime);
+    }
+  }
+}
+
+// Small-steps XPBD for one island. Each substep predicts with its share of the
+// external acceleration and the angular velocity, projects every contact once
+// at the substep's compliance and derives both velocities from the motion,
+// then stops the normal velocity at every contact that pushed.
+// substepStart holds each body's pose at the start of the current substep.
+// Each body covers its own step length; contacts are rigid, so they do not
+// depend on it.
+void substepIsland(std::span<physics::Vertex> vertices,
+                   std::span<const uint32_t> bodies,
+                   std::span<CollisionConstraint> contacts,
+                   std::span<const glm::vec3> accelerations,
+                   std::span<physics::Vertex> substepStart,
+                   std::span<const float> stepSeconds,
+                   int substeps,
+                   float deltatime) {
+  const float contactH = deltatime / static_cast<float>(substeps);
+
+  for (int s = 0; s < substeps; ++s) {
+    for (uint32_t b : bodies) {
+      const float h = stepSeconds[b] / static_cast<float>(substeps);
+      physics::Vertex& body = vertices[b];
+      substepStart[b] = body;
+      body.velocity += h * accelerations[b];
+      body.position += h * body.velocity;
+      body.orientation = glm::normalize(
+          body.orientation + (0.5f * h) * glm::quat(0.0f, body.angularVelocity) * body.orientation);
+    }
+
+    for (auto& contact : contacts) {
+      contact.resetLambda();
+      contact.solve(vertices, contactH);
+    }
+
+    for (uint32_t b : bodies) {
+      const float h = stepSeconds[b] / static_cast<float>(substeps);
+      physics::Vertex& body = vertices[b];
+      body.velocity = (body.position - substepStart[b].position) / h;
+      // Angular velocity from the rotation this substep: dq = q * q0^-1 = (cos, sin * axis)
+      const glm::quat dq = body.orientation * glm::conjugate(substepStart[b].orientation);
+      const float scale = (dq.w >= 0.0f ? 2.0f : -2.0f) / h;
+      body.angularVelocity = scale * glm::vec3(dq.x, dq.y, dq.z);
+    }
+
+    for (const auto& contact : contacts) {
+      contact.solveVelocity(vertices);
+    }
+  }
+}
+
+} // namespace
+
+XPBDSolver::XPBDSolver() = default;
+XPBDSolver::~XPBDSolver() = default;
+
+void XPBDSolver::solvePositions(std::vector<sauce::RigidBodyComponent>& rigidBodies,
+                                float deltatime,
+                                std::span<const float> bodyDeltaTimes) {
   /*
    * adapted from https://matthias-research.github.io/pages/publications/posBasedDyn.pdf
    */
-  glm::vec3 velocity;
-  float w = 0.0f;
-  std::vector<physics::Vertex> centers;
-
-  centers.reserve(rigidBodies.size());
-  for (auto& rigidBody : rigidBodies) {
-    auto* owner = rigidBody.getOwner();
-    auto* meshRenderer = owner ? owner->getComponent<sauce::MeshRendererComponent>() : nullptr;
-    if (!meshRenderer || !meshRenderer->getMesh()) {
-      continue;
+  // The previous step's islands live in the arena, so drop them before reusing it
+  std::pmr::vector<Island>(&stepArena).swap(islands);
+  stepArena.reset();
+  std::pmr::memory_resource* arena = &stepArena;
+  const size_t overflowsBefore = stepArena.overflowCount();
+
+  const size_t bodyCount = rigidBodies.size();
+  const bool substepping = substeps > 1;
+  std::pmr::vector<physics::Vertex> centers(bodyCount, arena);
+  std::pmr::vector<glm::vec3> previousPositions(bodyCount, arena);
+  std::pmr::vector<uint8_t> isStatic(bodyCount, 0, arena);
+  // Substeps apply the external forces themselves, starting from the step's start state
+  std::pmr::vector<glm::vec3> accelerations(substepping ? bodyCount : 0, arena);
+  std::pmr::vector<physics::Vertex> substepStart(substepping ? bodyCount : 0, arena);
+  // How far each body steps; a body held this step stands still like a static one
+  std::pmr::vector<float> stepSeconds(bodyCount, deltatime, arena);
+  if (bodyDeltaTimes.size() == bodyCount) {
+    std::copy(bodyDeltaTimes.begin(), bodyDeltaTimes.end(), stepSeconds.begin());
+  }
+
+  for (size_t i = 0; i < bodyCount; ++i) {
+    auto& rigidBody = rigidBodies[i];
+    const float dt = stepSeconds[i];
+    isStatic[i] = !hasCollisionShape(rigidBody) || rigidBody.getInvMass() <= 0.0f || dt <= 0.0f;
+    previousPositions[i] = rigidBody.getPosition();
+    const glm::vec3 startVelocity = rigidBody.getVelocity();
+
+    if (hasCollisionShape(rigidBody) && !rigidBody.isSleeping() && dt > 0.0f) {
+      const float w = rigidBody.getInvMass();
+      const glm::vec3 velocity = rigidBody.getVelocity() + dt * (w * rigidBody.getExternalForces());
+      rigidBody.setVelocity(velocity);
+      rigidBody.setPosition(rigidBody.getPosition() + velocity * dt);
+    }
+
+    // Contacts act along world-space directions, so the body-space inverse
+    // inertia is rotated into the world frame: R I^-1 R^T
+    const glm::mat3 rotation = glm::mat3_cast(rigidBody.getOrientation());
+    centers[i] = {
+        substepping ? previousPositions[i] : rigidBody.getPosition(),
+        substepping ? startVelocity : rigidBody.getVelocity(),
+        isStatic[i] ? 0.0f : rigidBody.getInvMass(),
+        rigidBody.getOrientation(),
+        rigidBody.getAngularVelocity(),
+        rotation * rigidBody.getInvInertiaTensor() * glm::transpose(rotation),
+    };
+    if (substepping && !isStatic[i]) {
+      accelerations[i] = rigidBody.getInvMass() * rigidBody.getExternalForces();
+    }
+  }
+
+  // Speculative contacts detect at the start of the step over the swept motion
+  std::pmr::vector<BodySphere> spheres(arena);
+  std::pmr::vector<BodyPair> pairs(arena);
+  std::pmr::vector<uint32_t> activeIslands(arena);
+  {
+    ProfileScope broadphase(profiler, ProfileStage::Broadphase);
+    std::pmr::vector<glm::vec3> displacements(arena);
+    if (speculativeContacts) {
+      displacements.resize(bodyCount);
+      for (size_t i = 0; i < bodyCount; ++i) {
+        displacements[i] = rigidBodies[i].getPosition() - previousPositions[i];
+      }
+    }
+    spheres = computeBodySpheres(rigidBodies, displacements, arena);
+    pairs = overlappingPairs(rigidBodies, spheres, true, arena);
+    islands = buildIslands(bodyCount, pairs, isStatic, arena);
+
+    // An island is simulated this step if any of its bodies is awake; touching a
+    // sleeping body wakes its whole island, and islands left all asleep are
+    // dropped here along with their pairs
+    activeIslands.reserve(islands.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(islands.size()); ++i) {
+      const auto& island = islands[i];
+      const bool anyAwake = std::any_of(island.bodyIndices.begin(), island.bodyIndices.end(),
+          [&](uint32_t b) { return !rigidBodies[b].isSleeping(); });
+      if (!anyAwake) {
+        continue;
+      }
+      for (uint32_t b : island.bodyIndices) {
+        if (rigidBodies[b].isSleeping()) {
+          rigidBodies[b].wake();
+        }
+      }
+      activeIslands.push_back(i);
     }
+  }
+
+  // Contact constraints by value, one list per active island
+  std::pmr::vector<std::pmr::vector<CollisionConstraint>> islandConstraints(activeIslands.size(), arena);
+  uint32_t contactPairs = 0;
+  size_t constraintCount = 0;
+  {
+    ProfileScope narrowphase(profiler, ProfileStage::Narrowphase);
+    // Pairs with a hull keep their manifold for as long as they stay active
+    // broadphase pairs. Manifolds and mesh hierarchies are created here, before
+    // the chunks look them up concurrently.
+    ++stepIndex;
+    std::pmr::vector<NarrowphaseItem> items(arena);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(activeIslands.size()); ++i) {
+      const auto& island = islands[activeIslands[i]];
+      for (uint32_t p : island.pairIndices) {
+        const BodySphere& a = spheres[pairs[p].a];
+        const BodySphere& b = spheres[pairs[p].b];
+        if ((a.convex() || b.convex()) && !a.plane() && !b.plane()) {
+          contactManifolds[pairKey(pairs[p])].lastStep = stepIndex;
+        }
+        if (meshContacts && !a.primitiveCollider() && !b.primitiveCollider()) {
+          getMeshBVH(a.mesh);
+          getMeshBVH(b.mesh);
+        }
+        items.push_back({ i, p, false });
+      }
+      if (!heightfields.empty()) {
+        for (uint32_t b : island.bodyIndices) {
+          if (!isStatic[b]) {
+            items.push_back({ i, b, true });
+          }
+        }
+      }
+    }
+    std::erase_if(contactManifolds, [this](const auto& entry) { return entry.second.lastStep != stepIndex; });
 
-    w = rigidBody.getInvMass();
-    velocity = rigidBody.getVelocity() + deltatime * (w * rigidBody.getExternalForces());
-    rigidBody.setPosition(rigidBody.getPosition() + velocity * deltatime);
+    contactPairs = runNarrowphase(items, spheres, pairs, meshContacts ? this : nullptr, substepping,
+                                  &contactManifolds, heightfields, parallelNarrowphase, narrowphaseChunks,
+                                  islandConstraints);
+    for (const auto& constraints : islandConstraints) {
+      constraintCount += constraints.size();
+    }
+  }
 
-    centers.push_back({
-        rigidBody.getCenterOfMass(),
-        glm::vec3(0.0f),
-        rigidBody.getInvMass(),
-    });
+  ProfileScope solve(profiler, ProfileStage::Solve);
+  // Largest violation left in each island, only measured when profiling
+  std::pmr::vector<float> islandResiduals(profiler ? activeIslands.size() : 0, 0.0f, arena);
+  auto solveIsland = [&](size_t i) {
+    if (substepping) {
+      substepIsland(centers, islands[activeIslands[i]].bodyIndices, islandConstraints[i], accelerations,
+                    substepStart, stepSeconds, substeps, deltatime);
+    } else {
+      projectContacts(centers, islandConstraints[i], solverIterations, deltatime);
+    }
+    if (profiler) {
+      for (const auto& constraint : islandConstraints[i]) {
+        islandResiduals[i] = std::max(islandResiduals[i], constraint.residual(centers));
+      }
+    }
+  };
+  if (parallelIslands) {
+    // std::ref keeps the std::function from copying the closure to the heap
+    TaskPool::shared().parallelFor(activeIslands.size(), std::ref(solveIsland));
+  } else {
+    for (size_t i = 0; i < activeIslands.size(); ++i) {
+      solveIsland(i);
+    }
   }
 
-  constraints = generateCollisionConstraints(rigidBodies);
-  projectConstraints(centers, constraints, deltatime);
+  // Derive velocities from the projected positions (substeps already did) and
+  // update sleep state per island
+  for (uint32_t islandIndex : activeIslands) {
+    const auto& island = islands[islandIndex];
+    int minSleepCounter = std::numeric_limits<int>::max();
+
+    for (uint32_t b : island.bodyIndices) {
+      auto& rigidBody = rigidBodies[b];
+      const glm::vec3 velocity =
+          substepping ? centers[b].velocity : (centers[b].position - previousPositions[b]) / stepSeconds[b];
+      rigidBody.setPosition(centers[b].position);
+      rigidBody.setOrientation(centers[b].orientation);
+      rigidBody.setVelocity(velocity);
+      if (substepping) {
+        rigidBody.setAngularVelocity(centers[b].angularVelocity);
+      }
+
+      const bool slow =
+          glm::length2(velocity) < sleepLinearThreshold * sleepLinearThreshold &&
+          glm::length2(rigidBody.getAngularVelocity()) < sleepAngularThreshold * sleepAngularThreshold;
+      rigidBody.setSleepCounter(slow ? rigidBody.getSleepCounter() + 1 : 0);
+      minSleepCounter = std::min(minSleepCounter, rigidBody.getSleepCounter());
+    }
+
+    if (enableSleeping && minSleepCounter >= sleepStepThreshold) {
+      for (uint32_t b : island.bodyIndices) {
+        auto& rigidBody = rigidBodies[b];
+        rigidBody.setSleeping(true);
+        rigidBody.setVelocity(glm::vec3(0.0f));
+        rigidBody.setAngularVelocity(glm::vec3(0.0f));
+      }
+    }
+  }
+
+  if (profiler) {
+    PhysicsSample& sample = profiler->current();
+    sample.steps += 1;
+    sample.bodies += static_cast<uint32_t>(bodyCount);
+    sample.pairs += static_cast<uint32_t>(pairs.size());
+    sample.contacts += contactPairs;
+    sample.constraints += static_cast<uint32_t>(constraintCount);
+    // A substep projects every contact once
+    const int passes = substepping ? substeps : solverIterations;
+    sample.iterations += constraintCount == 0 ? 0u : static_cast<uint32_t>(passes);
+    sample.arenaOverflows += static_cast<uint32_t>(stepArena.overflowCount() - overflowsBefore);
+    for (float residual : islandResiduals) {
+      sample.residual = std::max(sample.residual, residual);
+    }
+  }
 }
 
 void XPBDSolver::projectConstraints(
@@ -217,71 +1014,62 @@ void XPBDSolver::projectConstraints(
   }
 }
 
-std::vector<std::unique_ptr<Constraint>> XPBDSolver::generateCollisionConstraints(
-    std::vector<sauce::RigidBodyComponent>& rigidBodies
-) {
-    std::vector<std::unique_ptr<Constraint>> constraints;
-
-    // Build a bounding sphere for each rigid body from its mesh vertices.
-    struct BodySphere {
-        uint32_t index;
-        SphereCollider sphere;
-    };
-
-    std::vector<BodySphere> bodies;
-    bodies.reserve(rigidBodies.size());
-
-    for (uint32_t i = 0; i < static_cast<uint32_t>(rigidBodies.size()); ++i) {
-        auto& rb = rigidBodies[i];
+const SphereBVH* XPBDSolver::getMeshBVH(const std::shared_ptr<sauce::modeling::Mesh>& mesh) {
+  if (!mesh) {
+    return nullptr;
+  }
 
-        auto* owner = rb.getOwner();
-        if (!owner) continue;
+  auto it = meshBVHs.find(mesh.get());
+  if (it == meshBVHs.end()) {
+    it = meshBVHs.emplace(mesh.get(), MeshBVH { mesh, std::make_unique<SphereBVH>(SphereBVH::fromMesh(*mesh)) }).first;
+  }
+  // Meshes without triangles fall back to the bounding-sphere narrowphase
+  return it->second.tree->empty() ? nullptr : it->second.tree.get();
+}
 
-        auto* meshComp = owner->getComponent<sauce::MeshRendererComponent>();
-        if (!meshComp || !meshComp->getMesh()) continue;
+void XPBDSolver::updateMeshBVH(const std::shared_ptr<sauce::modeling::Mesh>& mesh) {
+  if (!mesh) {
+    return;
+  }
 
-        const auto& verts = meshComp->getMesh()->getVertices();
-        if (verts.empty()) continue;
+  auto it = meshBVHs.find(mesh.get());
+  if (it != meshBVHs.end()) {
+    it->second.tree->refitOrRebuild(*mesh, meshBVHRebuildThreshold);
+  }
+}
 
-        glm::vec3 center = rb.getPosition();
+std::vector<BodyPair> XPBDSolver::findBroadphasePairs(
+    std::vector<sauce::RigidBodyComponent>& rigidBodies) {
+  const auto pairs = overlappingPairs(rigidBodies, computeBodySpheres(rigidBodies));
+  return { pairs.begin(), pairs.end() };
+}
 
-        float maxRadiusSq = 0.0f;
-        for (const auto& v : verts) {
-            float dSq = glm::length2(v.position - center);
-            if (dSq > maxRadiusSq) {
-                maxRadiusSq = dSq;
-            }
+std::vector<std::unique_ptr<Constraint>> XPBDSolver::generateCollisionConstraints(
+    std::vector<sauce::RigidBodyComponent>& rigidBodies
+) {
+    const auto spheres = computeBodySpheres(rigidBodies);
+    const auto pairs = overlappingPairs(rigidBodies, spheres);
+    std::vector<NarrowphaseItem> items;
+    items.reserve(pairs.size());
+    for (uint32_t p = 0; p < static_cast<uint32_t>(pairs.size()); ++p) {
+        const BodySphere& a = spheres[pairs[p].a];
+        const BodySphere& b = spheres[pairs[p].b];
+        if (meshContacts && !a.primitiveCollider() && !b.primitiveCollider()) {
+            getMeshBVH(a.mesh);
+            getMeshBVH(b.mesh);
         }
-
-        SphereCollider sphere;
-        sphere.center = center;
-        sphere.radius = std::sqrt(maxRadiusSq);
-
-        bodies.push_back({ i, sphere });
+        items.push_back({ 0, p, false });
     }
 
-    // Pairwise collision detection using SphereCollider::checkCollision.
-    // For every contact produced, emit a CollisionConstraint.
-    for (size_t i = 0; i < bodies.size(); ++i) {
-        for (size_t j = i + 1; j < bodies.size(); ++j) {
-            std::vector<ContactInfo> contacts;
-
-            if (!bodies[i].sphere.checkCollision(bodies[j].sphere, contacts)) {
-                continue;
-            }
+    std::pmr::vector<CollisionConstraint> contacts;
+    runNarrowphase(items, spheres, pairs, meshContacts ? this : nullptr, false, nullptr, {}, parallelNarrowphase,
+                   narrowphaseChunks, std::span(&contacts, 1));
 
-            for (const auto& c : contacts) {
-                constraints.push_back(std::make_unique<CollisionConstraint>(
-                    bodies[i].index,
-                    bodies[j].index,
-                    c.contactNormal,
-                    c.depth,
-                    0.0f // zero compliance = perfectly rigid contact
-                ));
-            }
-        }
+    std::vector<std::unique_ptr<Constraint>> constraints;
+    constraints.reserve(contacts.size());
+    for (const auto& contact : contacts) {
+        constraints.push_back(std::make_unique<CollisionConstraint>(contact));
     }
-
     return constraints;
 }
 
@@ -294,6 +1082,7 @@ void XPBDSolver::solveCloth(
     return;
   }
 
+  ProfileScope clothScope(profiler, ProfileStage::ClothSubsteps);
   const int substeps = std::max(1, settings.solverSubsteps);
   const float h = deltatime / static_cast<float>(substeps);
   const float dampingScale = std::clamp(1.0f - settings.damping, 0.0f, 1.0f);
@@ -333,6 +1122,19 @@ void XPBDSolver::solveCloth(
       }
     }
 
+    if (!distanceFields.empty()) {
+      projectDistanceFields(particles, distanceFields, settings.collisionThickness);
+    }
+    if (!heightfields.empty()) {
+      projectHeightfields(particles, heightfields, settings.collisionThickness);
+    }
+    if (!clothObstacles.empty()) {
+      const float stepBegin = static_cast<float>(s) / static_cast<float>(substeps);
+      const float stepEnd = static_cast<float>(s + 1) / static_cast<float>(substeps);
+      solveClothCCD(particles, cloth.topology, clothObstacles, stepBegin, stepEnd, settings.collisionThickness,
+                    clothCCDScratch);
+    }
+
     for (auto& p : particles) {
       if (p.isStatic()) {
         p.predictedPosition = p.position;
@@ -0,0 +1,323 @@
+#include <app/Entity.hpp>
+#include <app/components/RigidBodyComponent.hpp>
+#include <app/modeling/ColliderInfo.hpp>
+
+#include <physics/PhysicsProfiler.hpp>
+#include <physics/XPBD.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Headless rigid-body throughput: builds scenes procedurally against
+// XPBDSolver and RigidBodyComponent, steps them at a fixed rate and reports
+// ms/step, contacts/step and energy drift, as a table and as JSON.
+//
+//   rigidbody_bench [--scene pyramid|pile|all] [--bodies N[,N...]] [--steps N] [--substeps N]
+//                   [--output file.json]
+//
+// The broadphase is all-pairs, so very large counts (100k) take seconds per step.
+
+namespace {
+
+using sauce::modeling::ColliderInfo;
+
+constexpr float kStepDt = 1.0f / 60.0f;
+const glm::vec3 kGravity(0.0f, -9.81f, 0.0f);
+
+struct Options {
+  std::vector<std::string> scenes { "pyramid", "pile" };
+  std::vector<size_t> bodyCounts { 1000 };
+  int steps = 120;
+  int substeps = 1;
+  std::string output = "rigidbody_bench.json";
+};
+
+// Owns the entities the solver's RigidBodyComponent copies point back to
+struct BenchScene {
+  std::vector<std::unique_ptr<sauce::Entity>> entities;
+  std::vector<sauce::RigidBodyComponent> bodies;
+
+  void add(const ColliderInfo& collider, const glm::vec3& position, float invMass,
+           const glm::vec3& velocity = glm::vec3(0.0f)) {
+    auto entity = std::make_unique<sauce::Entity>("Body" + std::to_string(entities.size()));
+    // Gravity as a force: the solver scales external forces by inverse mass
+    const glm::vec3 weight = invMass > 0.0f ? kGravity / invMass : glm::vec3(0.0f);
+    entity->addComponent<sauce::RigidBodyComponent>(
+        position, velocity, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.0f), weight, invMass);
+    entity->getComponent<sauce::RigidBodyComponent>()->setCollider(collider);
+    bodies.push_back(*entity->getComponent<sauce::RigidBodyComponent>());
+    entities.push_back(std::move(entity));
+  }
+
+  void addGround() {
+    ColliderInfo plane;
+    plane.shape = ColliderInfo::Shape::Plane;
+    add(plane, glm::vec3(0.0f), 0.0f);
+  }
+};
+
+// Square layers of unit boxes, each layer one box narrower, until bodyCount
+// boxes are placed; wide counts spread over several pyramids side by side
+BenchScene makePyramid(size_t bodyCount) {
+  BenchScene scene;
+  scene.addGround();
+
+  ColliderInfo box;
+  box.shape = ColliderInfo::Shape::Box;
+  constexpr float kSpacing = 1.02f;
+  constexpr int kMaxBase = 12;
+
+  size_t placed = 0;
+  for (int pyramid = 0; placed < bodyCount; ++pyramid) {
+    const glm::vec3 origin(static_cast<float>(pyramid % 8) * (kMaxBase + 2) * kSpacing, 0.0f,
+                           static_cast<float>(pyramid / 8) * (kMaxBase + 2) * kSpacing);
+    for (int layer = 0; layer < kMaxBase && placed < bodyCount; ++layer) {
+      const int width = kMaxBase - layer;
+      const float inset = 0.5f * static_cast<float>(layer) * kSpacing;
+      for (int z = 0; z < width && placed < bodyCount; ++z) {
+        for (int x = 0; x < width && placed < bodyCount; ++x) {
+          const glm::vec3 position = origin + glm::vec3(inset + static_cast<float>(x) * kSpacing,
+                                                        0.5f + static_cast<float>(layer),
+                                                        inset + static_cast<float>(z) * kSpacing);
+          scene.add(box, position, 1.0f);
+          ++placed;
+        }
+      }
+    }
+  }
+  return scene;
+}
+
+// Mixed spheres, boxes and capsules on a jittered grid above the ground,
+// dropped with small random velocities
+BenchScene makePile(size_t bodyCount) {
+  BenchScene scene;
+  scene.addGround();
+
+  std::mt19937 rng(2024);
+  std::uniform_real_distribution<float> jitter(-0.15f, 0.15f);
+  std::uniform_real_distribution<float> speed(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> size(0.3f, 0.5f);
+  std::uniform_int_distribution<int> shape(0, 2);
+
+  constexpr float kSpacing = 1.3f;
+  const int width = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(bodyCount) / 8.0f))));
+  for (size_t i = 0; i < bodyCount; ++i) {
+    const int x = static_cast<int>(i) % width;
+    const int z = (static_cast<int>(i) / width) % width;
+    const int y = static_cast<int>(i) / (width * width);
+
+    ColliderInfo collider;
+    switch (shape(rng)) {
+      case 0:
+        collider.shape = ColliderInfo::Shape::Sphere;
+        collider.radius = size(rng);
+        break;
+      case 1:
+        collider.shape = ColliderInfo::Shape::Box;
+        collider.halfExtents = glm::vec3(size(rng), size(rng), size(rng));
+        break;
+      default:
+        collider.shape = ColliderInfo::Shape::Capsule;
+        collider.radius = 0.6f * size(rng);
+        collider.halfHeight = size(rng) - collider.radius;
+        break;
+    }
+    const glm::vec3 position(static_cast<float>(x) * kSpacing + jitter(rng),
+                             1.0f + static_cast<float>(y) * kSpacing + jitter(rng),
+                             static_cast<float>(z) * kSpacing + jitter(rng));
+    scene.add(collider, position, 1.0f, glm::vec3(speed(rng), 0.0f, speed(rng)));
+  }
+  return scene;
+}
+
+// Kinetic plus gravitational potential energy of the dynamic bodies
+double totalEnergy(const std::vector<sauce::RigidBodyComponent>& bodies) {
+  double energy = 0.0;
+  for (const auto& body : bodies) {
+    if (body.getInvMass() <= 0.0f) continue;
+    const double mass = 1.0 / body.getInvMass();
+    const glm::vec3& v = body.getVelocity();
+    energy += 0.5 * mass * static_cast<double>(glm::dot(v, v));
+    energy -= mass * static_cast<double>(glm::dot(kGravity, body.getPosition()));
+  }
+  return energy;
+}
+
+bool allFinite(const std::vector<sauce::RigidBodyComponent>& bodies) {
+  return std::all_of(bodies.begin(), bodies.end(), [](const sauce::RigidBodyComponent& body) {
+    const glm::vec3& p = body.getPosition();
+    return std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+  });
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0.0;
+  const size_t index = std::min(values.size() - 1, static_cast<size_t>(std::ceil(p * static_cast<double>(values.size()))) - 1);
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+  return values[index];
+}
+
+double mean(const std::vector<double>& values) {
+  if (values.empty()) return 0.0;
+  double sum = 0.0;
+  for (double v : values) sum += v;
+  return sum / static_cast<double>(values.size());
+}
+
+// Steps one scene and returns its JSON record; sets ok to false on a blow-up
+nlohmann::ordered_json runScene(const std::string& name, size_t bodyCount, int steps, int substeps, bool& ok) {
+  BenchScene scene = name == "pyramid" ? makePyramid(bodyCount) : makePile(bodyCount);
+
+  physics::XPBDSolver solver;
+  solver.substeps = substeps;
+  physics::PhysicsProfiler profiler;
+  solver.profiler = &profiler;
+  const double initialEnergy = totalEnergy(scene.bodies);
+  std::vector<double> stepMs;
+  std::vector<double> contacts;
+  std::vector<double> pairs;
+  std::vector<double> broadphaseMs, narrowphaseMs, solveMs;
+  stepMs.reserve(static_cast<size_t>(steps));
+  float maxResidual = 0.0f;
+
+  for (int step = 0; step < steps; ++step) {
+    profiler.beginSample();
+    const auto start = std::chrono::steady_clock::now();
+    solver.solvePositions(scene.bodies, kStepDt);
+    const auto end = std::chrono::steady_clock::now();
+    profiler.endSample();
+
+    const physics::PhysicsSample& sample = profiler.sample(0);
+    stepMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    contacts.push_back(sample.contacts);
+    pairs.push_back(sample.pairs);
+    broadphaseMs.push_back(sample.stage(physics::ProfileStage::Broadphase));
+    narrowphaseMs.push_back(sample.stage(physics::ProfileStage::Narrowphase));
+    solveMs.push_back(sample.stage(physics::ProfileStage::Solve));
+    maxResidual = std::max(maxResidual, sample.residual);
+  }
+
+  const double finalEnergy = totalEnergy(scene.bodies);
+  const double energyDrift = (finalEnergy - initialEnergy) / std::max(std::fabs(initialEnergy), 1e-9);
+  const bool finite = allFinite(scene.bodies);
+  ok = ok && finite;
+
+  std::cout << std::left << std::setw(10) << name << std::right << std::fixed
+            << std::setw(9) << scene.bodies.size() - 1
+            << std::setprecision(3) << std::setw(12) << mean(stepMs)
+            << std::setw(12) << percentile(stepMs, 0.99)
+            << std::setprecision(1) << std::setw(14) << mean(contacts)
+            << std::setprecision(4) << std::setw(14) << energyDrift
+            << (finite ? "" : "  non-finite positions") << "\n";
+
+  nlohmann::ordered_json record;
+  record["scene"] = name;
+  record["bodies"] = scene.bodies.size() - 1;
+  record["steps"] = steps;
+  record["dt"] = kStepDt;
+  record["substeps"] = substeps;
+  record["ms_per_step"] = { { "mean", mean(stepMs) }, { "p99", percentile(stepMs, 0.99) },
+                            { "max", percentile(stepMs, 1.0) } };
+  record["stage_ms"] = { { "broadphase", mean(broadphaseMs) }, { "narrowphase", mean(narrowphaseMs) },
+                         { "solve", mean(solveMs) } };
+  record["pairs_per_step"] = mean(pairs);
+  record["contacts_per_step"] = mean(contacts);
+  record["max_residual"] = maxResidual;
+  record["energy"] = { { "initial", initialEnergy }, { "final", finalEnergy }, { "drift", energyDrift } };
+  record["finite"] = finite;
+  return record;
+}
+
+std::vector<size_t> parseCounts(const std::string& text) {
+  std::vector<size_t> counts;
+  size_t start = 0;
+  while (start < text.size()) {
+    size_t end = text.find(',', start);
+    if (end == std::string::npos) end = text.size();
+    counts.push_back(static_cast<size_t>(std::stoul(text.substr(start, end - start))));
+    start = end + 1;
+  }
+  return counts;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--scene" && hasValue) {
+      const std::string scene = argv[++i];
+      if (scene == "all") {
+        options.scenes = { "pyramid", "pile" };
+      } else if (scene == "pyramid" || scene == "pile") {
+        options.scenes = { scene };
+      } else {
+        std::cerr << "Unknown scene: " << scene << "\n";
+        return false;
+      }
+    } else if (arg == "--bodies" && hasValue) {
+      options.bodyCounts = parseCounts(argv[++i]);
+    } else if (arg == "--steps" && hasValue) {
+      options.steps = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--substeps" && hasValue) {
+      options.substeps = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--output" && hasValue) {
+      options.output = argv[++i];
+    } else {
+      std::cerr << "Usage: rigidbody_bench [--scene pyramid|pile|all] [--bodies N[,N...]] "
+                   "[--steps N] [--substeps N] [--output file.json]\n";
+      return false;
+    }
+  }
+  return !options.bodyCounts.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    return 2;
+  }
+
+  std::cout << "Rigid-body benchmark: " << options.steps << " steps at " << 1.0f / kStepDt << " Hz\n";
+  std::cout << std::left << std::setw(10) << "scene" << std::right
+            << std::setw(9) << "bodies"
+            << std::setw(12) << "ms/step"
+            << std::setw(12) << "p99 ms"
+            << std::setw(14) << "contacts"
+            << std::setw(14) << "energy drift" << "\n";
+
+  bool ok = true;
+  nlohmann::ordered_json results = nlohmann::ordered_json::array();
+  for (const auto& scene : options.scenes) {
+    for (size_t count : options.bodyCounts) {
+      results.push_back(runScene(scene, count, options.steps, options.substeps, ok));
+    }
+  }
+
+  std::ofstream out(options.output);
+  if (!out) {
+    std::cerr << "Could not write " << options.output << "\n";
+    return 1;
+  }
+  out << nlohmann::ordered_json { { "benchmark", "rigidbody" }, { "results", results } }.dump(2) << "\n";
+  std::cout << "Wrote " << options.output << "\n";
+
+  return ok ? 0 : 1;
+}
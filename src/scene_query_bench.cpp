@@ -0,0 +1,143 @@
+#include <physics/SceneQuery.hpp>
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Rays per second through SceneQuery on a synthetic city block: a grid of
+// buildings with props scattered between them, traced by a coherent camera
+// fan and by incoherent random rays, one at a time and in batches.
+
+namespace {
+
+using physics::QueryRay;
+using physics::RaycastHit;
+using physics::SceneQuery;
+
+constexpr int kGridSize = 100;
+constexpr float kBlockSpacing = 10.0f;
+constexpr int kPropCount = 10000;
+constexpr int kImageSize = 512;
+constexpr int kRepeats = 3;
+
+std::vector<SceneQuery::Proxy> makeCity() {
+  std::mt19937 rng(99);
+  std::uniform_real_distribution<float> height(4.0f, 40.0f);
+  std::uniform_real_distribution<float> footprint(2.0f, 4.5f);
+  std::uniform_real_distribution<float> site(0.0f, kGridSize * kBlockSpacing);
+  std::uniform_real_distribution<float> propSize(0.2f, 1.0f);
+
+  std::vector<SceneQuery::Proxy> proxies;
+  for (int z = 0; z < kGridSize; ++z) {
+    for (int x = 0; x < kGridSize; ++x) {
+      const glm::vec3 base(x * kBlockSpacing, 0.0f, z * kBlockSpacing);
+      const glm::vec3 half(footprint(rng), height(rng) * 0.5f, footprint(rng));
+      proxies.push_back({ { base - glm::vec3(half.x, 0.0f, half.z), base + glm::vec3(half.x, 2.0f * half.y, half.z) },
+                          static_cast<uint32_t>(proxies.size()) });
+    }
+  }
+  for (int i = 0; i < kPropCount; ++i) {
+    const glm::vec3 center(site(rng), propSize(rng), site(rng));
+    const glm::vec3 half(propSize(rng));
+    proxies.push_back({ { center - half, center + half }, static_cast<uint32_t>(proxies.size()) });
+  }
+  return proxies;
+}
+
+std::vector<QueryRay> makeCameraRays() {
+  const glm::vec3 eye(-20.0f, 30.0f, -20.0f);
+  const glm::vec3 forward = glm::normalize(glm::vec3(1.0f, -0.35f, 1.0f));
+  const glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+  const glm::vec3 up = glm::cross(right, forward);
+
+  std::vector<QueryRay> rays;
+  rays.reserve(kImageSize * kImageSize);
+  for (int y = 0; y < kImageSize; ++y) {
+    for (int x = 0; x < kImageSize; ++x) {
+      const float u = (static_cast<float>(x) + 0.5f) / kImageSize * 2.0f - 1.0f;
+      const float v = (static_cast<float>(y) + 0.5f) / kImageSize * 2.0f - 1.0f;
+      rays.push_back({ eye, glm::normalize(forward + 0.6f * u * right + 0.6f * v * up), 2000.0f });
+    }
+  }
+  return rays;
+}
+
+std::vector<QueryRay> makeRandomRays(size_t count) {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> site(0.0f, kGridSize * kBlockSpacing);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<QueryRay> rays(count);
+  for (auto& ray : rays) {
+    ray.origin = glm::vec3(site(rng), 1.0f + std::fabs(unit(rng)) * 30.0f, site(rng));
+    ray.direction = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)));
+    ray.maxDistance = 200.0f;
+  }
+  return rays;
+}
+
+void report(const std::string& name, double seconds, size_t rays, size_t hits) {
+  std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(14) << static_cast<double>(rays) / seconds / 1e6
+            << std::setw(12) << static_cast<double>(hits) * 100.0 / static_cast<double>(rays) << "\n";
+}
+
+void runRays(const std::string& name, const SceneQuery& query, const std::vector<QueryRay>& rays) {
+  double bestSingle = 0.0;
+  double bestBatch = 0.0;
+  size_t singleHits = 0;
+  size_t batchHits = 0;
+  std::vector<RaycastHit> hits;
+
+  for (int r = 0; r < kRepeats; ++r) {
+    singleHits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& ray : rays) {
+      RaycastHit hit;
+      singleHits += query.raycast(ray, hit) ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double single = std::chrono::duration<double>(end - start).count();
+    bestSingle = r == 0 ? single : std::min(bestSingle, single);
+
+    start = std::chrono::steady_clock::now();
+    query.raycastBatch(rays, hits);
+    end = std::chrono::steady_clock::now();
+    const double batch = std::chrono::duration<double>(end - start).count();
+    bestBatch = r == 0 ? batch : std::min(bestBatch, batch);
+  }
+
+  batchHits = 0;
+  for (const auto& hit : hits) {
+    batchHits += hit.hit() ? 1 : 0;
+  }
+  report(name + " single", bestSingle, rays.size(), singleHits);
+  report(name + " batch", bestBatch, rays.size(), batchHits);
+}
+
+} // namespace
+
+int main() {
+  SceneQuery query;
+  const auto start = std::chrono::steady_clock::now();
+  query.build(makeCity());
+  const auto end = std::chrono::steady_clock::now();
+
+  std::cout << "SceneQuery raycast benchmark: " << query.getProxyCount() << " proxies, built in "
+            << std::fixed << std::setprecision(2)
+            << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+  std::cout << std::left << std::setw(22) << "rays" << std::right
+            << std::setw(14) << "Mrays/s"
+            << std::setw(12) << "hit %" << "\n";
+
+  const auto cameraRays = makeCameraRays();
+  runRays("camera", query, cameraRays);
+  runRays("random", query, makeRandomRays(cameraRays.size()));
+  return 0;
+}
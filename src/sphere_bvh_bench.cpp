@@ -0,0 +1,188 @@
+#include <app/modeling/Mesh.hpp>
+
+#include <physics/SphereBVH.hpp>
+#include <physics/SphereCollider.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares SphereBVH build strategies on a synthetic environment: a wavy
+// terrain grid with dense clusters of small debris triangles scattered over it,
+// the uneven density that separates SAH from median splits.
+
+namespace {
+
+using physics::SphereBVH;
+
+constexpr int kTerrainCells = 256;
+constexpr float kTerrainSize = 256.0f;
+constexpr int kClusterCount = 48;
+constexpr int kTrianglesPerCluster = 1500;
+constexpr int kBuildRepeats = 3;
+constexpr int kQueryCount = 20000;
+constexpr float kQueryRadius = 0.75f;
+
+sauce::Vertex makeVertex(const glm::vec3& position) {
+  return sauce::Vertex {
+      .position = position,
+      .normal = glm::vec3(0.0f, 1.0f, 0.0f),
+      .texCoords = glm::vec2(0.0f),
+      .color = glm::vec3(1.0f),
+      .tangent = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
+  };
+}
+
+float terrainHeight(float x, float z) {
+  return 4.0f * std::sin(x * 0.05f) * std::cos(z * 0.04f) + 0.5f * std::sin(x * 0.7f + z * 0.3f);
+}
+
+sauce::modeling::Mesh makeEnvironment() {
+  std::vector<sauce::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  const float cell = kTerrainSize / kTerrainCells;
+
+  for (int z = 0; z <= kTerrainCells; ++z) {
+    for (int x = 0; x <= kTerrainCells; ++x) {
+      const float px = static_cast<float>(x) * cell;
+      const float pz = static_cast<float>(z) * cell;
+      vertices.push_back(makeVertex(glm::vec3(px, terrainHeight(px, pz), pz)));
+    }
+  }
+  const uint32_t row = kTerrainCells + 1;
+  for (int z = 0; z < kTerrainCells; ++z) {
+    for (int x = 0; x < kTerrainCells; ++x) {
+      const uint32_t i = static_cast<uint32_t>(z) * row + static_cast<uint32_t>(x);
+      indices.insert(indices.end(), { i, i + row, i + 1, i + 1, i + row, i + row + 1 });
+    }
+  }
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> site(0.0f, kTerrainSize);
+  std::normal_distribution<float> spread(0.0f, 1.5f);
+  std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+  for (int c = 0; c < kClusterCount; ++c) {
+    const float cx = site(rng);
+    const float cz = site(rng);
+    const glm::vec3 center(cx, terrainHeight(cx, cz) + 1.0f, cz);
+    for (int t = 0; t < kTrianglesPerCluster; ++t) {
+      const glm::vec3 p = center + glm::vec3(spread(rng), std::fabs(spread(rng)), spread(rng));
+      const uint32_t base = static_cast<uint32_t>(vertices.size());
+      vertices.push_back(makeVertex(p));
+      vertices.push_back(makeVertex(p + glm::vec3(jitter(rng), jitter(rng), jitter(rng))));
+      vertices.push_back(makeVertex(p + glm::vec3(jitter(rng), jitter(rng), jitter(rng))));
+      indices.insert(indices.end(), { base, base + 1, base + 2 });
+    }
+  }
+
+  return sauce::modeling::Mesh(vertices, indices);
+}
+
+struct QueryStats {
+  double nodesVisited = 0.0;
+  double leavesTested = 0.0;
+  double microseconds = 0.0;
+};
+
+// Mirrors SphereBVH::checkCollision's stackless walk to count the work it does
+QueryStats measureQueries(const SphereBVH& bvh, const std::vector<physics::SphereCollider>& probes) {
+  QueryStats stats;
+  const auto& nodes = bvh.getNodes();
+  uint64_t visited = 0;
+  uint64_t leaves = 0;
+
+  for (const auto& probe : probes) {
+    for (uint32_t i = 0; i < nodes.size();) {
+      const auto& node = nodes[i];
+      ++visited;
+      const float radiusSum = node.radius + probe.radius;
+      const glm::vec3 d = probe.center - node.center;
+      if (glm::dot(d, d) >= radiusSum * radiusSum) {
+        i = node.skipIndex;
+        continue;
+      }
+      if (node.isLeaf()) {
+        ++leaves;
+        i = node.skipIndex;
+        continue;
+      }
+      ++i;
+    }
+  }
+
+  std::vector<physics::ContactInfo> contacts;
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& probe : probes) {
+    contacts.clear();
+    bvh.checkCollision(probe, contacts);
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  stats.nodesVisited = static_cast<double>(visited) / static_cast<double>(probes.size());
+  stats.leavesTested = static_cast<double>(leaves) / static_cast<double>(probes.size());
+  stats.microseconds = std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(probes.size());
+  return stats;
+}
+
+void runStrategy(const std::string& name,
+                 SphereBVH::BuildStrategy strategy,
+                 const sauce::modeling::Mesh& mesh,
+                 const std::vector<physics::SphereCollider>& probes) {
+  double bestBuildMs = 0.0;
+  SphereBVH bvh;
+  for (int r = 0; r < kBuildRepeats; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    bvh = SphereBVH::fromMesh(mesh, strategy);
+    const auto end = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    bestBuildMs = r == 0 ? ms : std::min(bestBuildMs, ms);
+  }
+
+  const QueryStats stats = measureQueries(bvh, probes);
+  std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << bestBuildMs
+            << std::setw(10) << bvh.getNodes().size()
+            << std::setw(14) << bvh.getCost()
+            << std::setw(14) << stats.nodesVisited
+            << std::setw(14) << stats.leavesTested
+            << std::setw(12) << stats.microseconds << "\n";
+}
+
+} // namespace
+
+int main() {
+  const sauce::modeling::Mesh mesh = makeEnvironment();
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> site(0.0f, kTerrainSize);
+  std::uniform_real_distribution<float> lift(-1.0f, 4.0f);
+  std::vector<physics::SphereCollider> probes(kQueryCount);
+  for (auto& probe : probes) {
+    const float x = site(rng);
+    const float z = site(rng);
+    probe.center = glm::vec3(x, terrainHeight(x, z) + lift(rng), z);
+    probe.radius = kQueryRadius;
+  }
+
+  std::cout << "SphereBVH build benchmark: " << mesh.getIndexCount() / 3 << " triangles, "
+            << probes.size() << " sphere queries\n";
+  std::cout << std::left << std::setw(12) << "strategy" << std::right
+            << std::setw(12) << "build ms"
+            << std::setw(10) << "nodes"
+            << std::setw(14) << "cost"
+            << std::setw(14) << "nodes/query"
+            << std::setw(14) << "leaves/query"
+            << std::setw(12) << "us/query" << "\n";
+
+  runStrategy("median", SphereBVH::BuildStrategy::Median, mesh, probes);
+  runStrategy("binned-sah", SphereBVH::BuildStrategy::BinnedSAH, mesh, probes);
+  return 0;
+}
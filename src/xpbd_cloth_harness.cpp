@@ -4,15 +4,20 @@
 #include <app/modeling/Mesh.hpp>
 
 #include <physics/Cloth.hpp>
+#include <physics/ClothCCD.hpp>
+#include <physics/SignedDistanceField.hpp>
 #include <physics/XPBD.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <array>
 #include <cmath>
+#include <filesystem>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -86,6 +91,21 @@ std::shared_ptr<sauce::modeling::Mesh> makeQuadMesh() {
   return mesh;
 }
 
+// Closed box centered on the origin, wound counter-clockwise seen from outside
+std::shared_ptr<sauce::modeling::Mesh> makeBoxMesh(const glm::vec3& halfExtents) {
+  std::vector<sauce::Vertex> vertices;
+  for (int i = 0; i < 8; ++i) {
+    const glm::vec3 corner((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+    vertices.push_back(makeRenderVertex(corner * halfExtents, glm::vec2(0.0f)));
+  }
+  std::vector<uint32_t> indices {
+      0, 4, 6,  0, 6, 2,  1, 3, 7,  1, 7, 5,
+      0, 1, 5,  0, 5, 4,  2, 6, 7,  2, 7, 3,
+      0, 2, 3,  0, 3, 1,  4, 5, 7,  4, 7, 6,
+  };
+  return std::make_shared<sauce::modeling::Mesh>(vertices, indices);
+}
+
 sauce::ClothSettings makeClothSettings(
     int solverSubsteps = 4,
     float stretchCompliance = 0.0f,
@@ -568,6 +588,153 @@ bool testClothComponentRuntimeMeshTangentSyncModes(std::vector<std::string>& err
 
 } // namespace
 
+bool testDistanceFieldCollider(std::vector<std::string>& errors) {
+  using physics::SignedDistanceField;
+  const auto box = makeBoxMesh(glm::vec3(0.5f));
+  constexpr float kCell = 0.05f;
+  constexpr float kBand = 0.2f;
+  const SignedDistanceField field = SignedDistanceField::fromMesh(*box, kCell, kBand);
+
+  // Beside a face the field is linear, so trilinear lookups are exact up to
+  // quantization; deep inside and past the grid it is clamped to the band
+  if (field.empty() || !approxEqual(field.distance(glm::vec3(0.1f, 0.63f, -0.2f)), 0.13f, 1e-3f) ||
+      !approxEqual(field.distance(glm::vec3(0.1f, -0.2f, 0.44f)), -0.06f, 1e-3f) ||
+      !approxEqual(field.distance(glm::vec3(0.0f)), -kBand) ||
+      !approxEqual(field.distance(glm::vec3(5.0f, 0.0f, 0.0f)), kBand)) {
+    appendError(errors, "distance field did not reproduce box distances");
+    return false;
+  }
+  if (!approxEqual(field.sample(glm::vec3(-0.58f, 0.1f, 0.2f)).gradient, glm::vec3(-1.0f, 0.0f, 0.0f), 1e-3f)) {
+    appendError(errors, "distance field gradient did not point out of the nearest face");
+    return false;
+  }
+  // Only the band is stored, so a large box costs far less than a dense float grid
+  const SignedDistanceField large = SignedDistanceField::fromMesh(*makeBoxMesh(glm::vec3(4.0f)), kCell, 2.0f * kCell);
+  const size_t denseBytes = static_cast<size_t>(std::pow(8.0f / kCell, 3.0f)) * sizeof(float);
+  if (large.getMemoryBytes() >= denseBytes / 4) {
+    appendError(errors, "distance field stored more than a quarter of a dense grid");
+    return false;
+  }
+
+  // Cache round trip: the second call reads the file the first one wrote
+  const std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "sauce_sdf_harness";
+  std::filesystem::remove_all(cacheDirectory);
+  const SignedDistanceField baked = SignedDistanceField::loadOrBake(*box, kCell, kBand, cacheDirectory);
+  const uint64_t key = SignedDistanceField::cacheKey(*box, kCell, kBand);
+  const auto cached = SignedDistanceField::load(
+      std::filesystem::directory_iterator(cacheDirectory)->path(), key);
+  const bool staleRejected = !SignedDistanceField::load(
+      std::filesystem::directory_iterator(cacheDirectory)->path(), key + 1).has_value();
+  std::filesystem::remove_all(cacheDirectory);
+  if (!cached || !staleRejected || cached->getBrickCount() != baked.getBrickCount() ||
+      cached->distance(glm::vec3(0.2f, 0.52f, 0.0f)) != baked.distance(glm::vec3(0.2f, 0.52f, 0.0f))) {
+    appendError(errors, "distance field cache did not round-trip or accepted a stale key");
+    return false;
+  }
+
+  // A particle dropped onto the box, placed away from the origin, comes to
+  // rest on its top face
+  ClothData cloth;
+  cloth.particles.push_back(makeParticle(glm::vec3(3.1f, 1.5f, -0.2f)));
+  XPBDSolver solver;
+  solver.distanceFields.push_back({ std::make_shared<SignedDistanceField>(field),
+                                    physics::RigidPose { glm::vec3(3.0f, 0.0f, 0.0f) } });
+  sauce::ClothSettings settings = makeClothSettings(4);
+  for (int step = 0; step < 120; ++step) {
+    solver.solveCloth(cloth, settings, 1.0f / 60.0f, glm::vec3(0.0f, -9.81f, 0.0f));
+  }
+  const float restHeight = 0.5f + settings.collisionThickness;
+  if (!approxEqual(cloth.particles[0].position, glm::vec3(3.1f, restHeight, -0.2f), 2e-3f)) {
+    appendError(errors, "particle did not come to rest on the distance field's surface");
+    return false;
+  }
+
+  return true;
+}
+
+bool testClothContinuousCollision(std::vector<std::string>& errors) {
+  // Swept primitives: a point through a still triangle, a still point hit by
+  // a moving triangle, and two crossing edges, all meeting halfway
+  const std::array<glm::vec3, 3> triangle { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+  std::array<glm::vec3, 3> below = triangle;
+  std::array<glm::vec3, 3> above = triangle;
+  for (int i = 0; i < 3; ++i) {
+    below[i].z = -1.0f;
+    above[i].z = 1.0f;
+  }
+  physics::TimeOfImpact impact;
+  const bool pointHit = physics::pointTriangleImpact(glm::vec3(0.25f, 0.25f, 1.0f), glm::vec3(0.25f, 0.25f, -1.0f),
+                                                     triangle, triangle, impact);
+  if (!pointHit || !approxEqual(impact.time, 0.5f) ||
+      !approxEqual(impact.coordinates, glm::vec3(0.5f, 0.25f, 0.25f))) {
+    appendError(errors, "point-triangle time of impact was wrong");
+    return false;
+  }
+  if (!physics::pointTriangleImpact(glm::vec3(0.25f, 0.25f, 0.0f), glm::vec3(0.25f, 0.25f, 0.0f), below, above,
+                                    impact) || !approxEqual(impact.time, 0.5f) ||
+      physics::pointTriangleImpact(glm::vec3(0.9f, 0.9f, 1.0f), glm::vec3(0.9f, 0.9f, -1.0f), triangle, triangle,
+                                   impact)) {
+    appendError(errors, "moving triangle impact was wrong or a point beside the triangle hit it");
+    return false;
+  }
+  const bool edgeHit = physics::edgeEdgeImpact(
+      glm::vec3(-1.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(-1.0f, 0.0f, -1.0f),
+      glm::vec3(1.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+      glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), impact);
+  if (!edgeHit || !approxEqual(impact.time, 0.5f) || !approxEqual(impact.coordinates.x, 0.5f) ||
+      !approxEqual(impact.coordinates.y, 0.5f)) {
+    appendError(errors, "edge-edge time of impact was wrong");
+    return false;
+  }
+
+  // A thin plate crossing the whole cloth within one step, one substep: the
+  // discrete tests never see it, the sweep carries the cloth over it
+  constexpr int kSide = 9;
+  std::vector<sauce::Vertex> vertices;
+  for (int j = 0; j < kSide; ++j) {
+    for (int i = 0; i < kSide; ++i) {
+      const glm::vec2 uv(static_cast<float>(i) / (kSide - 1), static_cast<float>(j) / (kSide - 1));
+      vertices.push_back(makeRenderVertex(glm::vec3(2.0f * uv.x - 1.0f, 0.0f, 2.0f * uv.y - 1.0f), uv));
+    }
+  }
+  std::vector<uint32_t> indices;
+  for (uint32_t j = 0; j + 1 < kSide; ++j) {
+    for (uint32_t i = 0; i + 1 < kSide; ++i) {
+      const uint32_t v = j * kSide + i;
+      indices.insert(indices.end(), { v, v + kSide, v + 1, v + 1, v + kSide, v + kSide + 1 });
+    }
+  }
+  auto cloth = physics::buildClothDataFromMesh(sauce::modeling::Mesh(vertices, indices));
+  if (!cloth) {
+    appendError(errors, "continuous collision cloth failed to build");
+    return false;
+  }
+
+  constexpr float kPlateHalfHeight = 0.05f;
+  XPBDSolver solver;
+  solver.clothObstacles.push_back({ makeBoxMesh(glm::vec3(0.4f, kPlateHalfHeight, 0.4f)),
+                                    physics::RigidPose { glm::vec3(0.0f, -1.0f, 0.0f) },
+                                    physics::RigidPose { glm::vec3(0.0f, 1.0f, 0.0f) } });
+  const sauce::ClothSettings settings = makeClothSettings(1, 0.0f, 0.0f, 0.0f, 0.0f);
+  solver.solveCloth(*cloth, settings, 1.0f / 60.0f);
+
+  const float plateTop = 1.0f + kPlateHalfHeight;
+  for (const auto& particle : cloth->particles) {
+    const bool overPlate = std::fabs(particle.position.x) < 0.4f && std::fabs(particle.position.z) < 0.4f;
+    if (!isFinite(particle.position) || (overPlate && particle.position.y < plateTop)) {
+      appendError(errors, "cloth passed through a fast plate despite continuous collision");
+      return false;
+    }
+  }
+  const auto& center = cloth->particles[(kSide / 2) * kSide + kSide / 2];
+  if (!approxEqual(center.position.y, plateTop + settings.collisionThickness, 1e-3f)) {
+    appendError(errors, "cloth hit by a fast plate did not rest on its top face");
+    return false;
+  }
+
+  return true;
+}
+
 int main() {
   std::vector<std::string> errors;
 
@@ -582,6 +749,8 @@ int main() {
   const bool componentRuntimeMeshSyncOk = testClothComponentRuntimeMeshSync(errors);
   const bool componentRuntimeMeshTangentModesOk =
       testClothComponentRuntimeMeshTangentSyncModes(errors);
+  const bool distanceFieldOk = testDistanceFieldCollider(errors);
+  const bool continuousCollisionOk = testClothContinuousCollision(errors);
 
   if (!errors.empty()) {
     std::cerr << "XPBD cloth harness failed:\n";
@@ -603,5 +772,7 @@ int main() {
   std::cout << "  runtime mesh sync: " << (componentRuntimeMeshSyncOk ? "ok" : "failed") << "\n";
   std::cout << "  runtime tangent sync modes: "
             << (componentRuntimeMeshTangentModesOk ? "ok" : "failed") << "\n";
+  std::cout << "  distance field collider: " << (distanceFieldOk ? "ok" : "failed") << "\n";
+  std::cout << "  continuous collision: " << (continuousCollisionOk ? "ok" : "failed") << "\n";
   return 0;
 }
@@ -0,0 +1,1907 @@
+#include <app/Entity.hpp>
+#include <app/SimulationLODScheduler.hpp>
+#include <app/components/MeshRendererComponent.hpp>
+#include <app/components/RigidBodyComponent.hpp>
+#include <app/modeling/Mesh.hpp>
+
+#include <physics/BoxCollider.hpp>
+#include <physics/CapsuleCollider.hpp>
+#include <physics/ConvexCollider.hpp>
+#include <physics/GJK.hpp>
+#include <physics/HeightfieldCollider.hpp>
+#include <physics/Islands.hpp>
+#include <physics/Narrowphase.hpp>
+#include <physics/OverlapKernels.hpp>
+#include <physics/PhysicsProfiler.hpp>
+#include <physics/PlaneCollider.hpp>
+#include <physics/SceneQuery.hpp>
+#include <physics/SphereBVH.hpp>
+#include <physics/SphereCollider.hpp>
+#include <physics/XPBD.hpp>
+#include <physics/constraints/Constraint.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Global allocation counter for the zero-allocation step test. Every heap
+// allocation in the process goes through these while counting is switched on.
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC pairs the inlined replacement delete with new at each call site
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+namespace {
+std::atomic<bool> gCountAllocations { false };
+std::atomic<size_t> gAllocationCount { 0 };
+
+void* countedAllocate(std::size_t size) {
+  if (gCountAllocations.load(std::memory_order_relaxed)) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* p = std::malloc(std::max<std::size_t>(size, 1));
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+// Over-aligned blocks keep the malloc'd pointer just in front of them
+void* countedAllocateAligned(std::size_t size, std::size_t alignment) {
+  auto* raw = static_cast<std::byte*>(countedAllocate(size + alignment + sizeof(void*)));
+  const auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+  auto* aligned = reinterpret_cast<std::byte*>((address + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
+  reinterpret_cast<void**>(aligned)[-1] = raw;
+  return aligned;
+}
+
+void releaseAligned(void* p) noexcept {
+  if (p) {
+    std::free(static_cast<void**>(p)[-1]);
+  }
+}
+} // namespace
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return countedAllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { releaseAligned(p); }
+
+namespace {
+
+using physics::BodyPair;
+using physics::XPBDSolver;
+
+constexpr float kPositionEpsilon = 1e-4f;
+constexpr float kStepDt = 1.0f / 128.0f;
+
+bool approxEqual(const glm::vec3& actual, const glm::vec3& expected, float epsilon = kPositionEpsilon) {
+  return glm::length(actual - expected) <= epsilon;
+}
+
+void appendError(std::vector<std::string>& errors, const std::string& message) {
+  errors.push_back(message);
+}
+
+sauce::Vertex makeRenderVertex(const glm::vec3& position) {
+  return sauce::Vertex {
+      .position = position,
+      .normal = glm::normalize(position),
+      .texCoords = glm::vec2(0.0f),
+      .color = glm::vec3(1.0f),
+      .tangent = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
+  };
+}
+
+// Octahedron whose vertices lie on a sphere of the given radius around the origin
+std::shared_ptr<sauce::modeling::Mesh> makeOctahedronMesh(float radius) {
+  std::vector<sauce::Vertex> vertices {
+      makeRenderVertex(glm::vec3(radius, 0.0f, 0.0f)),
+      makeRenderVertex(glm::vec3(-radius, 0.0f, 0.0f)),
+      makeRenderVertex(glm::vec3(0.0f, radius, 0.0f)),
+      makeRenderVertex(glm::vec3(0.0f, -radius, 0.0f)),
+      makeRenderVertex(glm::vec3(0.0f, 0.0f, radius)),
+      makeRenderVertex(glm::vec3(0.0f, 0.0f, -radius)),
+  };
+  std::vector<uint32_t> indices {
+      0, 2, 4,  2, 1, 4,  1, 3, 4,  3, 0, 4,
+      2, 0, 5,  1, 2, 5,  3, 1, 5,  0, 3, 5,
+  };
+  return std::make_shared<sauce::modeling::Mesh>(vertices, indices);
+}
+
+// Axis-aligned cube with outward-wound faces
+std::shared_ptr<sauce::modeling::Mesh> makeBoxMesh(float halfExtent) {
+  std::vector<sauce::Vertex> vertices;
+  for (int i = 0; i < 8; ++i) {
+    vertices.push_back(makeRenderVertex(glm::vec3(
+        (i & 1) ? halfExtent : -halfExtent,
+        (i & 2) ? halfExtent : -halfExtent,
+        (i & 4) ? halfExtent : -halfExtent)));
+  }
+  std::vector<uint32_t> indices {
+      0, 2, 1,  1, 2, 3,  4, 5, 6,  5, 7, 6,
+      0, 1, 4,  1, 5, 4,  2, 6, 3,  3, 6, 7,
+      0, 4, 2,  2, 4, 6,  1, 3, 5,  3, 7, 5,
+  };
+  return std::make_shared<sauce::modeling::Mesh>(vertices, indices);
+}
+
+// Owns the entities the solver's RigidBodyComponent copies point back to
+struct RigidBodyFixture {
+  std::vector<std::unique_ptr<sauce::Entity>> entities;
+  std::vector<sauce::RigidBodyComponent> bodies;
+
+  void add(const glm::vec3& position,
+           const glm::vec3& velocity = glm::vec3(0.0f),
+           float invMass = 1.0f,
+           float radius = 0.5f) {
+    addMesh(makeOctahedronMesh(radius), position, velocity, invMass);
+  }
+
+  void addMesh(const std::shared_ptr<sauce::modeling::Mesh>& mesh,
+               const glm::vec3& position,
+               const glm::vec3& velocity = glm::vec3(0.0f),
+               float invMass = 1.0f) {
+    auto entity = std::make_unique<sauce::Entity>("Body" + std::to_string(entities.size()));
+    entity->addComponent<sauce::MeshRendererComponent>(mesh, nullptr);
+    entity->addComponent<sauce::RigidBodyComponent>(
+        position, velocity, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.0f),
+        glm::vec3(0.0f), invMass);
+    bodies.push_back(*entity->getComponent<sauce::RigidBodyComponent>());
+    entities.push_back(std::move(entity));
+  }
+
+  // Body with an analytic collider and no mesh
+  void addPrimitive(const sauce::modeling::ColliderInfo& collider,
+                    const glm::vec3& position,
+                    const glm::vec3& velocity = glm::vec3(0.0f),
+                    float invMass = 1.0f) {
+    auto entity = std::make_unique<sauce::Entity>("Body" + std::to_string(entities.size()));
+    entity->addComponent<sauce::RigidBodyComponent>(
+        position, velocity, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.0f),
+        glm::vec3(0.0f), invMass);
+    entity->getComponent<sauce::RigidBodyComponent>()->setCollider(collider);
+    bodies.push_back(*entity->getComponent<sauce::RigidBodyComponent>());
+    entities.push_back(std::move(entity));
+  }
+
+  void step(XPBDSolver& solver, int steps = 1) {
+    for (int i = 0; i < steps; ++i) {
+      solver.solvePositions(bodies, kStepDt);
+    }
+  }
+};
+
+bool testUnionFindIslandsIgnoreStaticBodies(std::vector<std::string>& errors) {
+  // 0-1 and 2-3 touch each other, and both groups rest on static body 4
+  const std::vector<BodyPair> pairs { { 0, 1 }, { 2, 3 }, { 1, 4 }, { 3, 4 } };
+  const std::vector<uint8_t> isStatic { 0, 0, 0, 0, 1, 0 };
+
+  const auto islands = physics::buildIslands(6, pairs, isStatic);
+  if (islands.size() != 3) {
+    appendError(errors, "buildIslands did not produce two contact islands plus one singleton");
+    return false;
+  }
+
+  size_t pairCount = 0;
+  for (const auto& island : islands) {
+    pairCount += island.pairIndices.size();
+    for (uint32_t b : island.bodyIndices) {
+      if (isStatic[b]) {
+        appendError(errors, "buildIslands placed a static body inside an island");
+        return false;
+      }
+    }
+  }
+  if (pairCount != pairs.size()) {
+    appendError(errors, "buildIslands did not assign every dynamic pair to exactly one island");
+    return false;
+  }
+
+  if (islands[0].bodyIndices != std::pmr::vector<uint32_t> { 0, 1 } ||
+      islands[1].bodyIndices != std::pmr::vector<uint32_t> { 2, 3 } ||
+      islands[2].bodyIndices != std::pmr::vector<uint32_t> { 5 }) {
+    appendError(errors, "buildIslands grouped bodies incorrectly");
+    return false;
+  }
+
+  return true;
+}
+
+bool testContactSeparatesOverlappingBodies(std::vector<std::string>& errors) {
+  RigidBodyFixture fixture;
+  fixture.add(glm::vec3(0.0f));
+  fixture.add(glm::vec3(0.6f, 0.0f, 0.0f));
+
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  fixture.step(solver);
+
+  const float separation = glm::length(fixture.bodies[1].getPosition() - fixture.bodies[0].getPosition());
+  if (std::fabs(separation - 1.0f) > 1e-3f) {
+    appendError(errors, "contact constraint did not push overlapping bodies apart to their radius sum");
+    return false;
+  }
+
+  if (!approxEqual(fixture.bodies[0].getPosition() + fixture.bodies[1].getPosition(),
+                   glm::vec3(0.6f, 0.0f, 0.0f))) {
+    appendError(errors, "contact constraint did not split the correction by inverse mass");
+    return false;
+  }
+
+  return true;
+}
+
+bool testParallelIslandsMatchSerial(std::vector<std::string>& errors) {
+  auto buildScene = [](RigidBodyFixture& fixture) {
+    for (int i = 0; i < 16; ++i) {
+      const glm::vec3 base(static_cast<float>(i) * 5.0f, 0.0f, 0.0f);
+      fixture.add(base);
+      fixture.add(base + glm::vec3(0.7f, 0.1f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f));
+    }
+  };
+
+  RigidBodyFixture serial;
+  RigidBodyFixture parallel;
+  buildScene(serial);
+  buildScene(parallel);
+
+  XPBDSolver serialSolver;
+  serialSolver.parallelIslands = false;
+  XPBDSolver parallelSolver;
+  parallelSolver.parallelIslands = true;
+
+  serial.step(serialSolver);
+  parallel.step(parallelSolver);
+
+  if (parallelSolver.getIslands().size() != 16) {
+    appendError(errors, "solver did not split independent body pairs into separate islands");
+    return false;
+  }
+
+  serial.step(serialSolver, 7);
+  parallel.step(parallelSolver, 7);
+
+  for (size_t i = 0; i < serial.bodies.size(); ++i) {
+    if (serial.bodies[i].getPosition() != parallel.bodies[i].getPosition()) {
+      appendError(errors, "parallel island solve diverged from the serial solve");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool testParallelNarrowphaseMatchesSerial(std::vector<std::string>& errors) {
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo box;
+  box.shape = sauce::modeling::ColliderInfo::Shape::Box;
+  sauce::modeling::ColliderInfo sphere;
+  sphere.radius = 0.5f;
+
+  // One contact-heavy island: a pile with far more pairs than fit one chunk
+  auto buildScene = [&](RigidBodyFixture& fixture) {
+    fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+    for (int i = 0; i < 48; ++i) {
+      const glm::vec3 position(0.9f * static_cast<float>(i % 4), 0.5f + 0.9f * static_cast<float>(i / 16),
+                               0.9f * static_cast<float>((i / 4) % 4));
+      fixture.addPrimitive(i % 2 == 0 ? box : sphere, position);
+    }
+    for (auto& body : fixture.bodies) {
+      if (body.getInvMass() > 0.0f) {
+        body.setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f) / body.getInvMass());
+      }
+    }
+  };
+
+  RigidBodyFixture serial;
+  RigidBodyFixture parallel;
+  buildScene(serial);
+  buildScene(parallel);
+
+  XPBDSolver serialSolver;
+  serialSolver.parallelNarrowphase = false;
+  XPBDSolver parallelSolver;
+  parallelSolver.parallelNarrowphase = true;
+
+  const auto serialConstraints = serialSolver.generateCollisionConstraints(serial.bodies);
+  const auto parallelConstraints = parallelSolver.generateCollisionConstraints(parallel.bodies);
+  if (serialConstraints.size() < 64 || serialConstraints.size() != parallelConstraints.size()) {
+    appendError(errors, "parallel narrowphase produced a different contact list");
+    return false;
+  }
+
+  serial.step(serialSolver, 30);
+  parallel.step(parallelSolver, 30);
+  for (size_t i = 0; i < serial.bodies.size(); ++i) {
+    if (serial.bodies[i].getPosition() != parallel.bodies[i].getPosition()) {
+      appendError(errors, "parallel narrowphase diverged from the serial narrowphase");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool testRestingIslandFallsAsleep(std::vector<std::string>& errors) {
+  RigidBodyFixture fixture;
+  fixture.add(glm::vec3(0.0f));
+  fixture.add(glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f), 0.0f);
+
+  XPBDSolver solver;
+  solver.sleepStepThreshold = 10;
+  fixture.step(solver, solver.sleepStepThreshold - 1);
+  if (fixture.bodies[0].isSleeping()) {
+    appendError(errors, "resting body fell asleep before the sleep step threshold");
+    return false;
+  }
+
+  fixture.step(solver);
+  if (!fixture.bodies[0].isSleeping()) {
+    appendError(errors, "resting body did not fall asleep after the sleep step threshold");
+    return false;
+  }
+
+  // A sleeping body must not integrate even with external forces applied
+  fixture.bodies[0].setExternalForces(glm::vec3(0.0f, 0.0f, -9.81f));
+  fixture.step(solver, 5);
+  if (!approxEqual(fixture.bodies[0].getPosition(), glm::vec3(0.0f))) {
+    appendError(errors, "sleeping body was integrated");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSleepingIslandWakesWhenTouched(std::vector<std::string>& errors) {
+  RigidBodyFixture fixture;
+  fixture.add(glm::vec3(0.0f));
+  fixture.add(glm::vec3(3.0f, 0.0f, 0.0f));
+
+  XPBDSolver solver;
+  solver.sleepStepThreshold = 4;
+  fixture.step(solver, 4);
+  if (!fixture.bodies[0].isSleeping() || !fixture.bodies[1].isSleeping()) {
+    appendError(errors, "wake fixture bodies did not fall asleep");
+    return false;
+  }
+
+  fixture.bodies[1].wake();
+  fixture.bodies[1].setVelocity(glm::vec3(-100.0f, 0.0f, 0.0f));
+  fixture.step(solver, 3);
+
+  if (fixture.bodies[0].isSleeping()) {
+    appendError(errors, "sleeping body was not woken when an awake body touched it");
+    return false;
+  }
+  if (fixture.bodies[0].getPosition().x >= 0.0f) {
+    appendError(errors, "woken body did not respond to the contact");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSleepingStackWakesTogether(std::vector<std::string>& errors) {
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo box;
+  box.shape = sauce::modeling::ColliderInfo::Shape::Box;
+
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+  for (int i = 0; i < 3; ++i) {
+    fixture.addPrimitive(box, glm::vec3(0.0f, 0.5f + static_cast<float>(i), 0.0f));
+  }
+  for (auto& body : fixture.bodies) {
+    if (body.getInvMass() > 0.0f) {
+      body.setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f) / body.getInvMass());
+    }
+  }
+  auto stackAsleep = [&] {
+    return fixture.bodies[1].isSleeping() && fixture.bodies[2].isSleeping() && fixture.bodies[3].isSleeping();
+  };
+
+  XPBDSolver solver;
+  solver.sleepStepThreshold = 10;
+  for (int step = 0; step < 200 && !stackAsleep(); ++step) {
+    fixture.step(solver);
+  }
+  if (!stackAsleep()) {
+    appendError(errors, "stack did not fall asleep");
+    return false;
+  }
+
+  // Only the top box touches the falling one, yet the whole stack must wake
+  // with it; waking a layer per step would let the lower boxes sink
+  fixture.addPrimitive(box, glm::vec3(0.0f, 3.7f, 0.0f), glm::vec3(0.0f, -4.0f, 0.0f));
+  fixture.bodies[4].setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f) / fixture.bodies[4].getInvMass());
+  for (int step = 0; step < 20 && fixture.bodies[3].isSleeping(); ++step) {
+    fixture.step(solver);
+  }
+  if (fixture.bodies[3].isSleeping()) {
+    appendError(errors, "falling body did not wake the top of the stack");
+    return false;
+  }
+  if (fixture.bodies[1].isSleeping() || fixture.bodies[2].isSleeping()) {
+    appendError(errors, "sleeping stack did not wake in the same step as its top");
+    return false;
+  }
+
+  fixture.step(solver, 30);
+  for (int i = 1; i <= 4; ++i) {
+    const float below = i == 1 ? 0.0f : fixture.bodies[i - 1].getPosition().y + 0.5f;
+    if (fixture.bodies[i].getPosition().y - 0.5f < below - 2e-2f) {
+      appendError(errors, "woken stack sank into itself or the ground");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool testMeshContactsUseTriangleFeatures(std::vector<std::string>& errors) {
+  // Bounding spheres of these cubes overlap along the center offset; the
+  // triangle manifold must instead resolve the shallow overlap along +x
+  RigidBodyFixture fixture;
+  const auto box = makeBoxMesh(0.5f);
+  fixture.addMesh(box, glm::vec3(0.0f));
+  fixture.addMesh(box, glm::vec3(0.9f, 0.05f, 0.02f));
+
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  solver.meshContacts = true;
+  fixture.step(solver);
+
+  const glm::vec3 offset = fixture.bodies[1].getPosition() - fixture.bodies[0].getPosition();
+  if (std::fabs(offset.x - 1.0f) > 1e-3f) {
+    appendError(errors, "mesh contact did not separate the cubes along their shallowest face");
+    return false;
+  }
+  if (!approxEqual(glm::vec3(0.0f, offset.y, offset.z), glm::vec3(0.0f, 0.05f, 0.02f))) {
+    appendError(errors, "mesh contact pushed the cubes along a non-separating axis");
+    return false;
+  }
+
+  // Separated cubes whose bounding spheres still overlap produce no contacts
+  std::vector<physics::ContactInfo> contacts;
+  const auto tree = physics::SphereBVH::fromMesh(*box);
+  physics::RigidPose poseA;
+  physics::RigidPose poseB;
+  poseB.position = glm::vec3(1.05f, 0.0f, 0.0f);
+  if (physics::SphereBVH::collide(tree, *box, poseA, tree, *box, poseB, contacts)) {
+    appendError(errors, "dual-tree traversal reported contacts between separated cubes");
+    return false;
+  }
+
+  return true;
+}
+
+bool testMeshContactsKeepConcavePatches(std::vector<std::string>& errors) {
+  // Floor and wall meeting in a concave corner, each a grid of triangles so
+  // they land in separate leaves
+  constexpr int kCells = 4;
+  constexpr float kCellSize = 0.5f;
+  std::vector<sauce::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  auto addGrid = [&](const glm::vec3& u, const glm::vec3& v) {
+    const uint32_t base = static_cast<uint32_t>(vertices.size());
+    for (int j = 0; j <= kCells; ++j) {
+      for (int i = 0; i <= kCells; ++i) {
+        vertices.push_back(makeRenderVertex(u * (static_cast<float>(i) * kCellSize) +
+                                            v * (static_cast<float>(j) * kCellSize - 1.0f)));
+      }
+    }
+    for (int j = 0; j < kCells; ++j) {
+      for (int i = 0; i < kCells; ++i) {
+        const uint32_t k = base + static_cast<uint32_t>(j * (kCells + 1) + i);
+        const uint32_t row = kCells + 1;
+        indices.insert(indices.end(), { k, k + row, k + 1, k + 1, k + row, k + row + 1 });
+      }
+    }
+  };
+  addGrid(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+  addGrid(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+  const sauce::modeling::Mesh corner(vertices, indices);
+  const auto cornerTree = physics::SphereBVH::fromMesh(corner);
+
+  // A cube pressed 0.05 into both the floor and the wall
+  const auto box = makeBoxMesh(0.5f);
+  const auto boxTree = physics::SphereBVH::fromMesh(*box);
+  physics::RigidPose cornerPose;
+  physics::RigidPose boxPose;
+  boxPose.position = glm::vec3(0.45f, 0.45f, 0.0f);
+  std::vector<physics::ContactInfo> contacts;
+  if (!physics::SphereBVH::collide(cornerTree, corner, cornerPose, boxTree, *box, boxPose, contacts)) {
+    appendError(errors, "cube pressed into a concave corner reported no contacts");
+    return false;
+  }
+
+  bool floorPatch = false;
+  bool wallPatch = false;
+  for (const auto& contact : contacts) {
+    floorPatch = floorPatch || glm::dot(contact.contactNormal, glm::vec3(0.0f, 1.0f, 0.0f)) > 0.99f;
+    wallPatch = wallPatch || glm::dot(contact.contactNormal, glm::vec3(1.0f, 0.0f, 0.0f)) > 0.99f;
+    if (contact.depth > 0.05f + kPositionEpsilon) {
+      appendError(errors, "concave mesh contact is deeper than the overlap");
+      return false;
+    }
+  }
+  if (!floorPatch || !wallPatch) {
+    appendError(errors, "concave mesh contacts dropped the patch against one surface");
+    return false;
+  }
+
+  return true;
+}
+
+// Skip indices stay inside each subtree, interior nodes have two children, and
+// every triangle sits in exactly one leaf
+bool checkFlatLayout(const physics::SphereBVH& bvh, size_t triangleCount, std::vector<std::string>& errors) {
+  const auto& nodes = bvh.getNodes();
+  std::vector<int> triangleSeen(triangleCount, 0);
+  for (uint32_t i = 0; i < nodes.size(); ++i) {
+    const auto& node = nodes[i];
+    if (node.skipIndex <= i || node.skipIndex > nodes.size()) {
+      appendError(errors, "flattened BVH node has a skip index outside its subtree");
+      return false;
+    }
+    if (node.isLeaf()) {
+      if (node.skipIndex != i + 1) {
+        appendError(errors, "flattened BVH leaf does not skip to the next node");
+        return false;
+      }
+      for (uint32_t t = 0; t < node.triangleCount; ++t) {
+        ++triangleSeen[bvh.getTriangleIndices()[node.firstTriangle + t]];
+      }
+    } else if (nodes[i + 1].skipIndex >= node.skipIndex) {
+      appendError(errors, "flattened BVH interior node has no right child");
+      return false;
+    }
+  }
+  if (nodes.front().skipIndex != nodes.size() ||
+      std::any_of(triangleSeen.begin(), triangleSeen.end(), [](int n) { return n != 1; })) {
+    appendError(errors, "flattened BVH does not cover every triangle exactly once");
+    return false;
+  }
+  return true;
+}
+
+bool testFlatSphereBVHLayout(std::vector<std::string>& errors) {
+  const auto mesh = makeOctahedronMesh(1.0f);
+  // Sixteen octahedra on a grid give a tree several levels deep
+  std::vector<sauce::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  for (int copy = 0; copy < 16; ++copy) {
+    const glm::vec3 offset(static_cast<float>(copy % 4) * 3.0f, static_cast<float>(copy / 4) * 3.0f, 0.0f);
+    const uint32_t base = static_cast<uint32_t>(vertices.size());
+    for (const auto& v : mesh->getVertices()) {
+      vertices.push_back(makeRenderVertex(v.position + offset));
+    }
+    for (uint32_t index : mesh->getIndices()) {
+      indices.push_back(base + index);
+    }
+  }
+  const sauce::modeling::Mesh grid(vertices, indices);
+  const auto bvh = physics::SphereBVH::fromMesh(grid);
+  if (!checkFlatLayout(bvh, indices.size() / 3, errors)) {
+    return false;
+  }
+
+  // A probe touching only the first octahedron must only hit leaves near it
+  physics::SphereCollider probe;
+  probe.center = glm::vec3(-1.2f, 0.0f, 0.0f);
+  probe.radius = 0.5f;
+  std::vector<physics::ContactInfo> contacts;
+  if (!bvh.checkCollision(probe, contacts) || contacts.empty()) {
+    appendError(errors, "flattened BVH sphere query missed an overlapping leaf");
+    return false;
+  }
+  probe.center = glm::vec3(1.5f, 1.5f, 5.0f);
+  contacts.clear();
+  if (bvh.checkCollision(probe, contacts)) {
+    appendError(errors, "flattened BVH sphere query hit a distant leaf");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSphereBVHTinyCentroidExtent(std::vector<std::string>& errors) {
+  // A row of triangles whose centroids differ along z by denormals only: the
+  // SAH must not bin along an axis that narrow
+  std::vector<sauce::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  for (int i = 0; i < 8; ++i) {
+    const glm::vec3 offset(2.0f * static_cast<float>(i), 0.0f, 1e-40f * static_cast<float>(i));
+    const uint32_t base = static_cast<uint32_t>(vertices.size());
+    vertices.push_back(makeRenderVertex(offset));
+    vertices.push_back(makeRenderVertex(offset + glm::vec3(1.0f, 0.0f, 0.0f)));
+    vertices.push_back(makeRenderVertex(offset + glm::vec3(0.0f, 1.0f, 0.0f)));
+    indices.insert(indices.end(), { base, base + 1, base + 2 });
+  }
+  const sauce::modeling::Mesh row(vertices, indices);
+  const auto bvh = physics::SphereBVH::fromMesh(row);
+  if (!checkFlatLayout(bvh, indices.size() / 3, errors)) {
+    return false;
+  }
+  if (bvh.getNodes().front().isLeaf()) {
+    appendError(errors, "BVH over centroids with a tiny extent did not split along the wide axis");
+    return false;
+  }
+  return true;
+}
+
+bool testSphereBVHBuildStrategiesAgree(std::vector<std::string>& errors) {
+  // Wavy grid large enough for the builder to fork subtrees onto the task pool
+  constexpr int kCells = 96;
+  std::vector<sauce::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  for (int z = 0; z <= kCells; ++z) {
+    for (int x = 0; x <= kCells; ++x) {
+      const float height = 0.5f * std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(z) * 0.2f);
+      vertices.push_back(makeRenderVertex(glm::vec3(static_cast<float>(x), height, static_cast<float>(z)) + 0.01f));
+    }
+  }
+  for (int z = 0; z < kCells; ++z) {
+    for (int x = 0; x < kCells; ++x) {
+      const uint32_t i = static_cast<uint32_t>(z * (kCells + 1) + x);
+      const uint32_t row = kCells + 1;
+      indices.insert(indices.end(), { i, i + row, i + 1, i + 1, i + row, i + row + 1 });
+    }
+  }
+  const sauce::modeling::Mesh grid(vertices, indices);
+
+  const auto median = physics::SphereBVH::fromMesh(grid, physics::SphereBVH::BuildStrategy::Median);
+  const auto sah = physics::SphereBVH::fromMesh(grid, physics::SphereBVH::BuildStrategy::BinnedSAH);
+  if (!checkFlatLayout(median, indices.size() / 3, errors) || !checkFlatLayout(sah, indices.size() / 3, errors)) {
+    return false;
+  }
+
+  // Both strategies must bound every triangle by its leaf sphere
+  for (const auto* bvh : { &median, &sah }) {
+    for (const auto& node : bvh->getNodes()) {
+      for (uint32_t t = 0; t < node.triangleCount; ++t) {
+        const uint32_t triangle = bvh->getTriangleIndices()[node.firstTriangle + t];
+        for (uint32_t k = 0; k < 3; ++k) {
+          const glm::vec3& p = vertices[indices[triangle * 3 + k]].position;
+          if (glm::length(p - node.center) > node.radius + kPositionEpsilon) {
+            appendError(errors, "sphere BVH leaf does not enclose its triangles");
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+// Depth of the deepest leaf, walking the flattened layout
+size_t sphereBVHDepth(const physics::SphereBVH& bvh, uint32_t node = 0) {
+  const auto& nodes = bvh.getNodes();
+  if (nodes[node].isLeaf()) {
+    return 1;
+  }
+  const uint32_t left = node + 1;
+  return 1 + std::max(sphereBVHDepth(bvh, left), sphereBVHDepth(bvh, nodes[left].skipIndex));
+}
+
+bool testSphereBVHDeepTreeCollides(std::vector<std::string>& errors) {
+  // Small triangles at doubling distances along each axis in turn: every SAH
+  // split peels the farthest few off the rest, so the tree degenerates into a
+  // chain far deeper than a median split's
+  constexpr int kTriangles = 72;
+  std::vector<sauce::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  float distance = 1.0f;
+  for (int i = 0; i < kTriangles; ++i) {
+    glm::vec3 corner(0.0f);
+    corner[i % 3] = distance;
+    if (i % 3 == 2) {
+      distance *= 2.0f;
+    }
+    const uint32_t base = static_cast<uint32_t>(vertices.size());
+    vertices.push_back(makeRenderVertex(corner));
+    vertices.push_back(makeRenderVertex(corner + glm::vec3(0.1f, 0.0f, 0.0f)));
+    vertices.push_back(makeRenderVertex(corner + glm::vec3(0.0f, 0.1f, 0.1f)));
+    indices.insert(indices.end(), { base, base + 1, base + 2 });
+  }
+  const sauce::modeling::Mesh skewed(vertices, indices);
+  const auto deep = physics::SphereBVH::fromMesh(skewed, physics::SphereBVH::BuildStrategy::BinnedSAH);
+  const auto balanced = physics::SphereBVH::fromMesh(skewed, physics::SphereBVH::BuildStrategy::Median);
+  if (!checkFlatLayout(deep, kTriangles, errors)) {
+    return false;
+  }
+  if (sphereBVHDepth(deep) < 2 * sphereBVHDepth(balanced)) {
+    appendError(errors, "skewed mesh did not produce a degenerate SAH sphere BVH");
+    return false;
+  }
+
+  // A box at the bottom of the chain is only reached after descending it fully
+  physics::RigidPose identity;
+  const auto box = makeBoxMesh(0.2f);
+  const auto boxTree = physics::SphereBVH::fromMesh(*box);
+  physics::RigidPose boxPose;
+  boxPose.position = glm::vec3(1.05f, 0.25f, 0.0f);
+  std::vector<physics::ContactInfo> contacts;
+  if (!physics::SphereBVH::collide(deep, skewed, identity, boxTree, *box, boxPose, contacts) ||
+      !physics::SphereBVH::collide(boxTree, *box, boxPose, deep, skewed, identity, contacts)) {
+    appendError(errors, "dual-tree traversal of a deep sphere BVH missed the overlapping triangle");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSphereBVHRefitTracksDeformation(std::vector<std::string>& errors) {
+  auto mesh = makeOctahedronMesh(1.0f);
+  auto bvh = physics::SphereBVH::fromMesh(*mesh);
+
+  // Small motion keeps the topology and just moves the spheres
+  for (auto& v : mesh->getVerticesMutable()) {
+    v.position = v.position * 1.1f + glm::vec3(5.0f, 0.0f, 0.0f);
+  }
+  if (bvh.refitOrRebuild(*mesh)) {
+    appendError(errors, "refit rebuilt the tree for a small deformation");
+    return false;
+  }
+
+  const auto& indices = mesh->getIndices();
+  for (const auto& node : bvh.getNodes()) {
+    if (!node.isLeaf()) continue;
+    for (uint32_t t = 0; t < node.triangleCount; ++t) {
+      const uint32_t triangle = bvh.getTriangleIndices()[node.firstTriangle + t];
+      for (uint32_t k = 0; k < 3; ++k) {
+        const glm::vec3& p = mesh->getVertices()[indices[triangle * 3 + k]].position;
+        if (glm::length(p - node.center) > node.radius + kPositionEpsilon) {
+          appendError(errors, "refitted leaf sphere does not enclose its triangles");
+          return false;
+        }
+      }
+    }
+  }
+  if (!approxEqual(bvh.getNodes().front().center, glm::vec3(5.0f, 0.0f, 0.0f), 1e-3f)) {
+    appendError(errors, "refitted root sphere did not follow the mesh");
+    return false;
+  }
+
+  // Scattering the vertices degrades the refitted tree past the threshold
+  auto& vertices = mesh->getVerticesMutable();
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    vertices[i].position *= (i % 2 == 0) ? 20.0f : 1.0f;
+  }
+  if (!bvh.refitOrRebuild(*mesh)) {
+    appendError(errors, "degraded refit did not trigger a rebuild");
+    return false;
+  }
+
+  return true;
+}
+
+bool testPrimitivePairContacts(std::vector<std::string>& errors) {
+  physics::PlaneCollider ground;
+
+  physics::BoxCollider box;
+  box.center = glm::vec3(0.0f, 0.45f, 0.0f);
+  std::vector<physics::ContactInfo> contacts;
+  if (!physics::collide(box, ground, contacts) || contacts.size() != 4) {
+    appendError(errors, "box resting on a plane should produce a four-point manifold");
+    return false;
+  }
+  for (const auto& c : contacts) {
+    if (!approxEqual(c.contactNormal, glm::vec3(0.0f, -1.0f, 0.0f)) || std::fabs(c.depth - 0.05f) > 1e-4f) {
+      appendError(errors, "box-plane contacts should point from the box into the plane by the overlap");
+      return false;
+    }
+  }
+
+  // The mirrored pair reuses the table entry with flipped normals
+  contacts.clear();
+  if (!physics::collide(ground, box, contacts) || contacts.size() != 4 ||
+      !approxEqual(contacts[0].contactNormal, glm::vec3(0.0f, 1.0f, 0.0f)) ||
+      contacts[0].pCollider1 != &ground) {
+    appendError(errors, "plane-box contacts should mirror box-plane contacts");
+    return false;
+  }
+
+  // A capsule lying on its side touches the plane at both end caps
+  physics::CapsuleCollider capsule;
+  capsule.center = glm::vec3(0.0f, 0.45f, 0.0f);
+  capsule.orientation = glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+  contacts.clear();
+  if (!physics::collide(capsule, ground, contacts) || contacts.size() != 2) {
+    appendError(errors, "lying capsule should touch the plane at both ends");
+    return false;
+  }
+
+  // A sphere beside a box is pushed out through the box face it touches
+  physics::SphereCollider sphere;
+  sphere.center = glm::vec3(0.9f, 0.0f, 0.0f);
+  sphere.radius = 0.5f;
+  box.center = glm::vec3(0.0f);
+  contacts.clear();
+  if (!physics::collide(sphere, box, contacts) || contacts.size() != 1 ||
+      !approxEqual(contacts[0].contactNormal, glm::vec3(-1.0f, 0.0f, 0.0f)) ||
+      std::fabs(contacts[0].depth - 0.1f) > 1e-4f) {
+    appendError(errors, "sphere-box contact should use the box face normal");
+    return false;
+  }
+
+  // Stacked boxes keep a face normal, even with a slight twist
+  physics::BoxCollider upper;
+  upper.center = glm::vec3(0.1f, 0.95f, 0.0f);
+  upper.orientation = glm::angleAxis(glm::radians(10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+  contacts.clear();
+  if (!physics::collide(box, upper, contacts) || contacts.empty() || contacts.size() > 4) {
+    appendError(errors, "stacked boxes should produce a reduced manifold");
+    return false;
+  }
+  for (const auto& c : contacts) {
+    if (!approxEqual(c.contactNormal, glm::vec3(0.0f, 1.0f, 0.0f)) || c.depth > 0.05f + 1e-4f) {
+      appendError(errors, "stacked box contacts should push along the shared face normal");
+      return false;
+    }
+  }
+
+  // Separated primitives leave info untouched
+  upper.center = glm::vec3(0.0f, 1.5f, 0.0f);
+  contacts.clear();
+  if (physics::collide(box, upper, contacts) || !contacts.empty()) {
+    appendError(errors, "separated boxes should not report contacts");
+    return false;
+  }
+
+  return true;
+}
+
+bool testPrimitiveBodiesRestOnPlane(std::vector<std::string>& errors) {
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo box;
+  box.shape = sauce::modeling::ColliderInfo::Shape::Box;
+  sauce::modeling::ColliderInfo capsule;
+  capsule.shape = sauce::modeling::ColliderInfo::Shape::Capsule;
+  capsule.radius = 0.25f;
+
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+  fixture.addPrimitive(box, glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+  fixture.addPrimitive(box, glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+  fixture.addPrimitive(capsule, glm::vec3(3.0f, 0.75f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  fixture.step(solver, 30);
+
+  if (!approxEqual(fixture.bodies[1].getPosition(), glm::vec3(0.0f, 0.5f, 0.0f), 1e-3f) ||
+      !approxEqual(fixture.bodies[2].getPosition(), glm::vec3(0.0f, 1.5f, 0.0f), 1e-3f)) {
+    appendError(errors, "box stack should rest on the plane without sinking or drifting");
+    return false;
+  }
+  if (!approxEqual(fixture.bodies[3].getPosition(), glm::vec3(3.0f, 0.75f, 0.0f), 1e-3f)) {
+    appendError(errors, "upright capsule should rest on its lower cap");
+    return false;
+  }
+  if (fixture.bodies[0].getPosition() != glm::vec3(0.0f)) {
+    appendError(errors, "static plane should not move");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSpeculativeContactsStopTunneling(std::vector<std::string>& errors) {
+  // A small projectile covers more than the wall's thickness in one 60 Hz step
+  constexpr float kSlowDt = 1.0f / 60.0f;
+  sauce::modeling::ColliderInfo wall;
+  wall.shape = sauce::modeling::ColliderInfo::Shape::Box;
+  wall.halfExtents = glm::vec3(0.05f, 1.0f, 1.0f);
+  sauce::modeling::ColliderInfo projectile;
+  projectile.radius = 0.1f;
+
+  auto run = [&](bool speculative) {
+    RigidBodyFixture fixture;
+    fixture.addPrimitive(wall, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+    fixture.addPrimitive(projectile, glm::vec3(-0.6f, 0.0f, 0.0f), glm::vec3(30.0f, 0.0f, 0.0f));
+
+    XPBDSolver solver;
+    solver.enableSleeping = false;
+    solver.speculativeContacts = speculative;
+    for (int i = 0; i < 4; ++i) {
+      solver.solvePositions(fixture.bodies, kSlowDt);
+    }
+    return fixture.bodies[1].getPosition();
+  };
+
+  if (run(false).x < 0.0f) {
+    appendError(errors, "projectile should tunnel through the wall without speculative contacts");
+    return false;
+  }
+  const glm::vec3 stopped = run(true);
+  if (std::fabs(stopped.x + 0.15f) > 1e-3f) {
+    appendError(errors, "speculative contact should stop the projectile at the wall face");
+    return false;
+  }
+
+  // Bodies moving apart or passing at a distance get no constraint to fight
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(projectile, glm::vec3(-0.3f, 0.0f, 0.0f), glm::vec3(-30.0f, 0.0f, 0.0f));
+  fixture.addPrimitive(projectile, glm::vec3(0.3f, 0.0f, 0.0f), glm::vec3(30.0f, 0.0f, 0.0f));
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  solver.solvePositions(fixture.bodies, kSlowDt);
+  if (!approxEqual(fixture.bodies[0].getPosition(), glm::vec3(-0.8f, 0.0f, 0.0f)) ||
+      !approxEqual(fixture.bodies[1].getPosition(), glm::vec3(0.8f, 0.0f, 0.0f))) {
+    appendError(errors, "separating bodies should not be slowed by speculative contacts");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSceneQueryMatchesBruteForce(std::vector<std::string>& errors) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> site(-20.0f, 20.0f);
+  std::uniform_real_distribution<float> size(0.2f, 2.0f);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+  std::vector<physics::SceneQuery::Proxy> proxies(300);
+  for (uint32_t i = 0; i < proxies.size(); ++i) {
+    const glm::vec3 center(site(rng), site(rng), site(rng));
+    const glm::vec3 half(size(rng), size(rng), size(rng));
+    proxies[i] = { { center - half, center + half }, 1000 + i };
+  }
+  physics::SceneQuery query;
+  query.build(proxies);
+
+  // Reference: every proxy tested with the same slab convention
+  auto bruteForce = [&](const physics::QueryRay& ray, physics::RaycastHit& best) {
+    best = {};
+    float closest = ray.maxDistance;
+    for (const auto& proxy : proxies) {
+      physics::SceneQuery single;
+      single.build({ proxy });
+      physics::RaycastHit hit;
+      if (single.raycast(ray, hit) && hit.distance <= closest) {
+        closest = hit.distance;
+        best = hit;
+      }
+    }
+    return best.hit();
+  };
+
+  std::vector<physics::QueryRay> rays(601);
+  for (auto& ray : rays) {
+    ray.origin = glm::vec3(site(rng), site(rng), site(rng));
+    ray.direction = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)));
+    ray.maxDistance = 30.0f;
+  }
+  rays[0].direction = glm::vec3(1.0f, 0.0f, 0.0f); // axis-aligned rays take the zero-component path
+
+  std::vector<physics::RaycastHit> batch;
+  query.raycastBatch(rays, batch);
+  for (size_t r = 0; r < rays.size(); ++r) {
+    physics::RaycastHit expected;
+    physics::RaycastHit hit;
+    const bool expectedHit = bruteForce(rays[r], expected);
+    if (query.raycast(rays[r], hit) != expectedHit || query.raycastAny(rays[r]) != expectedHit ||
+        batch[r].hit() != expectedHit) {
+      appendError(errors, "scene query raycast hit/miss disagrees with brute force");
+      return false;
+    }
+    if (expectedHit && (std::fabs(hit.distance - expected.distance) > 1e-4f ||
+                        std::fabs(batch[r].distance - expected.distance) > 1e-4f)) {
+      appendError(errors, "scene query raycast distance disagrees with brute force");
+      return false;
+    }
+  }
+
+  for (int q = 0; q < 50; ++q) {
+    const glm::vec3 center(site(rng), site(rng), site(rng));
+    const float radius = size(rng) * 3.0f;
+    std::vector<uint32_t> ids;
+    query.overlapSphere(center, radius, ids);
+    std::vector<uint32_t> expected;
+    for (const auto& proxy : proxies) {
+      const glm::vec3 d = center - glm::clamp(center, proxy.bounds.min, proxy.bounds.max);
+      if (glm::dot(d, d) <= radius * radius) expected.push_back(proxy.id);
+    }
+    std::sort(ids.begin(), ids.end());
+    std::sort(expected.begin(), expected.end());
+    if (ids != expected) {
+      appendError(errors, "scene query sphere overlap disagrees with brute force");
+      return false;
+    }
+
+    const physics::AABB box { center - glm::vec3(radius), center + glm::vec3(radius) };
+    ids.clear();
+    query.overlapAABB(box, ids);
+    expected.clear();
+    for (const auto& proxy : proxies) {
+      if (box.overlaps(proxy.bounds)) expected.push_back(proxy.id);
+    }
+    std::sort(ids.begin(), ids.end());
+    std::sort(expected.begin(), expected.end());
+    if (ids != expected) {
+      appendError(errors, "scene query box overlap disagrees with brute force");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The vector kernels must report exactly what the scalar reference does,
+// including ranges that start mid-register and tails shorter than a register
+bool testOverlapKernelsMatchScalar(std::vector<std::string>& errors) {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> site(-5.0f, 5.0f);
+  std::uniform_real_distribution<float> size(0.1f, 1.5f);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+  constexpr size_t kCount = 37;
+  std::vector<float> x(kCount), y(kCount), z(kCount), radius(kCount);
+  std::vector<float> minX(kCount), minY(kCount), minZ(kCount), maxX(kCount), maxY(kCount), maxZ(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    x[i] = site(rng);
+    y[i] = site(rng);
+    z[i] = site(rng);
+    radius[i] = size(rng);
+    minX[i] = x[i] - size(rng);
+    minY[i] = y[i] - size(rng);
+    minZ[i] = z[i] - size(rng);
+    maxX[i] = x[i] + size(rng);
+    maxY[i] = y[i] + size(rng);
+    maxZ[i] = z[i] + size(rng);
+  }
+  // Exactly touching: sphere 3 and box 3 meet the first query at one point
+  x[3] = 3.0f; y[3] = 0.0f; z[3] = 0.0f; radius[3] = 2.0f;
+  minX[3] = 1.0f; minY[3] = -1.0f; minZ[3] = -1.0f; maxX[3] = 2.0f; maxY[3] = 1.0f; maxZ[3] = 1.0f;
+
+  const physics::SphereSoA spheres { x.data(), y.data(), z.data(), radius.data() };
+  const physics::AABBSoA boxes { minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data() };
+
+  std::vector<uint32_t> simd(kCount), reference(kCount);
+  std::vector<float> simdT(kCount), referenceT(kCount);
+  auto sameIndices = [&](size_t a, size_t b) {
+    return a == b && std::equal(simd.begin(), simd.begin() + static_cast<std::ptrdiff_t>(a), reference.begin());
+  };
+
+  const size_t begins[] = { 0, 1, 5, 30, kCount };
+  for (int q = 0; q < 40; ++q) {
+    glm::vec3 center(site(rng), site(rng), site(rng));
+    float queryRadius = size(rng);
+    if (q == 0) {
+      center = glm::vec3(0.0f);
+      queryRadius = 1.0f;
+    }
+    const physics::AABB queryBox { center - glm::vec3(queryRadius), center + glm::vec3(queryRadius) };
+    glm::vec3 direction(unit(rng), unit(rng), unit(rng));
+    if (q == 1) {
+      direction = glm::vec3(0.0f, 0.0f, 1.0f);
+    }
+    const glm::vec3 invDirection(1.0f / (direction.x == 0.0f ? 1e-12f : direction.x),
+                                 1.0f / (direction.y == 0.0f ? 1e-12f : direction.y),
+                                 1.0f / (direction.z == 0.0f ? 1e-12f : direction.z));
+
+    for (size_t begin : begins) {
+      size_t a = physics::overlapSphereSpheres(center, queryRadius, spheres, begin, kCount, simd.data());
+      size_t b = physics::scalar::overlapSphereSpheres(center, queryRadius, spheres, begin, kCount, reference.data());
+      if (!sameIndices(a, b)) {
+        appendError(errors, "sphere-sphere kernel disagrees with the scalar reference");
+        return false;
+      }
+      a = physics::overlapSphereAABBs(center, queryRadius, boxes, begin, kCount, simd.data());
+      b = physics::scalar::overlapSphereAABBs(center, queryRadius, boxes, begin, kCount, reference.data());
+      if (!sameIndices(a, b)) {
+        appendError(errors, "sphere-AABB kernel disagrees with the scalar reference");
+        return false;
+      }
+      a = physics::overlapAABBAABBs(queryBox, boxes, begin, kCount, simd.data());
+      b = physics::scalar::overlapAABBAABBs(queryBox, boxes, begin, kCount, reference.data());
+      if (!sameIndices(a, b)) {
+        appendError(errors, "AABB-AABB kernel disagrees with the scalar reference");
+        return false;
+      }
+      a = physics::intersectRayAABBs(center, invDirection, 8.0f, boxes, begin, kCount, simd.data(), simdT.data());
+      b = physics::scalar::intersectRayAABBs(center, invDirection, 8.0f, boxes, begin, kCount,
+                                             reference.data(), referenceT.data());
+      if (!sameIndices(a, b)) {
+        appendError(errors, "ray-AABB kernel disagrees with the scalar reference");
+        return false;
+      }
+      for (size_t h = 0; h < a; ++h) {
+        if (std::fabs(simdT[h] - referenceT[h]) > 1e-5f) {
+          appendError(errors, "ray-AABB kernel entry distance disagrees with the scalar reference");
+          return false;
+        }
+      }
+    }
+
+    if (q == 0) {
+      const bool touching = physics::overlapSphereSpheres(center, queryRadius, spheres, 3, 4, simd.data()) == 1 &&
+                            physics::overlapSphereAABBs(center, queryRadius, boxes, 3, 4, simd.data()) == 1;
+      if (!touching) {
+        appendError(errors, "overlap kernels should count touching shapes as overlapping");
+        return false;
+      }
+    }
+
+    // Lane 3 has an empty interval, like the padding lanes of a short packet
+    physics::RayPacketSoA packet {};
+    float maxDistance[physics::kRayPacketWidth];
+    for (size_t lane = 0; lane < physics::kRayPacketWidth; ++lane) {
+      packet.originX[lane] = center.x + unit(rng);
+      packet.originY[lane] = center.y + unit(rng);
+      packet.originZ[lane] = center.z + unit(rng);
+      packet.invDirectionX[lane] = invDirection.x;
+      packet.invDirectionY[lane] = invDirection.y;
+      packet.invDirectionZ[lane] = invDirection.z;
+      maxDistance[lane] = lane == 3 ? -1.0f : 8.0f;
+    }
+    for (size_t i = 0; i < kCount; ++i) {
+      const glm::vec3 min(minX[i], minY[i], minZ[i]);
+      const glm::vec3 max(maxX[i], maxY[i], maxZ[i]);
+      float simdEnter[physics::kRayPacketWidth];
+      float referenceEnter[physics::kRayPacketWidth];
+      const uint32_t simdMask = physics::intersectRayPacketAABB(packet, maxDistance, min, max, simdEnter);
+      const uint32_t referenceMask = physics::scalar::intersectRayPacketAABB(packet, maxDistance, min, max, referenceEnter);
+      if (simdMask != referenceMask || (simdMask & 0x8u) != 0) {
+        appendError(errors, "ray packet kernel disagrees with the scalar reference");
+        return false;
+      }
+      for (size_t lane = 0; lane < physics::kRayPacketWidth; ++lane) {
+        if ((simdMask >> lane & 1u) && std::fabs(simdEnter[lane] - referenceEnter[lane]) > 1e-5f) {
+          appendError(errors, "ray packet kernel entry distance disagrees with the scalar reference");
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool testPhysicsProfilerRecordsSteps(std::vector<std::string>& errors) {
+  // The ring keeps the newest kHistorySize samples
+  physics::PhysicsProfiler profiler;
+  const size_t total = physics::PhysicsProfiler::kHistorySize + 60;
+  for (size_t i = 0; i < total; ++i) {
+    profiler.beginSample();
+    profiler.addTime(physics::ProfileStage::Broadphase, static_cast<float>(i));
+    profiler.endSample();
+  }
+  const float oldest = static_cast<float>(total - physics::PhysicsProfiler::kHistorySize);
+  std::vector<float> history;
+  profiler.stageHistory(physics::ProfileStage::Broadphase, history);
+  if (profiler.size() != physics::PhysicsProfiler::kHistorySize || history.front() != oldest ||
+      profiler.sample(0).stage(physics::ProfileStage::Broadphase) != static_cast<float>(total - 1)) {
+    appendError(errors, "profiler ring buffer did not keep the newest samples in order");
+    return false;
+  }
+  const float expectedAverage = 0.5f * (oldest + static_cast<float>(total - 1));
+  // Nearest rank: the 238th of 240 ascending values
+  const float expectedP99 = oldest + 237.0f;
+  if (std::fabs(profiler.average(physics::ProfileStage::Broadphase) - expectedAverage) > 1e-3f ||
+      profiler.percentile(physics::ProfileStage::Broadphase, 0.99f) != expectedP99 ||
+      profiler.averageTotal() != profiler.average(physics::ProfileStage::Broadphase)) {
+    appendError(errors, "profiler rolling average or p99 is wrong");
+    return false;
+  }
+
+  // The solver adds its counters to the current sample
+  RigidBodyFixture fixture;
+  fixture.add(glm::vec3(0.0f));
+  fixture.add(glm::vec3(0.6f, 0.0f, 0.0f));
+  fixture.add(glm::vec3(10.0f, 0.0f, 0.0f));
+
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  solver.profiler = &profiler;
+  profiler.clear();
+  profiler.beginSample();
+  fixture.step(solver, 2);
+  profiler.endSample();
+
+  const physics::PhysicsSample& sample = profiler.sample(0);
+  if (sample.steps != 2 || sample.bodies != 6 || sample.pairs != 2 || sample.contacts != 2 ||
+      sample.constraints == 0 || sample.iterations != 2 * static_cast<uint32_t>(solver.solverIterations)) {
+    appendError(errors, "solver did not record its step counters in the profiler");
+    return false;
+  }
+  if (sample.residual < 0.0f || sample.residual > 1e-3f) {
+    appendError(errors, "solver recorded an unexpected final residual");
+    return false;
+  }
+  if (sample.stage(physics::ProfileStage::Broadphase) <= 0.0f || sample.stage(physics::ProfileStage::Solve) <= 0.0f) {
+    appendError(errors, "solver did not time its stages");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSteadyStepsDoNotAllocate(std::vector<std::string>& errors) {
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo box;
+  box.shape = sauce::modeling::ColliderInfo::Shape::Box;
+  sauce::modeling::ColliderInfo sphere;
+  sphere.radius = 0.5f;
+  sauce::modeling::ColliderInfo capsule;
+  capsule.shape = sauce::modeling::ColliderInfo::Shape::Capsule;
+  capsule.radius = 0.25f;
+
+  // Stacks that keep every pair type in contact under gravity, kept awake so
+  // each step runs the whole pipeline
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+  for (int i = 0; i < 4; ++i) {
+    const float x = 2.0f * static_cast<float>(i);
+    fixture.addPrimitive(box, glm::vec3(x, 0.5f, 0.0f));
+    fixture.addPrimitive(box, glm::vec3(x + 0.1f, 1.5f, 0.0f));
+    fixture.addPrimitive(sphere, glm::vec3(x, 2.5f, 0.0f));
+    fixture.addPrimitive(capsule, glm::vec3(x, 0.75f, 2.0f));
+  }
+  fixture.add(glm::vec3(0.0f, 0.5f, -2.0f));
+  for (auto& body : fixture.bodies) {
+    if (body.getInvMass() > 0.0f) {
+      body.setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f) / body.getInvMass());
+    }
+  }
+
+  physics::PhysicsProfiler profiler;
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  solver.profiler = &profiler;
+
+  // The first steps grow the arena and the narrowphase buffers to fit the scene
+  profiler.beginSample();
+  fixture.step(solver, 10);
+  profiler.endSample();
+  const size_t overflowsAfterWarmup = solver.getStepArena().overflowCount();
+
+  profiler.beginSample();
+  gAllocationCount = 0;
+  gCountAllocations = true;
+  fixture.step(solver, 60);
+  gCountAllocations = false;
+  profiler.endSample();
+
+  if (profiler.sample(0).constraints == 0) {
+    appendError(errors, "allocation test scene should stay in contact");
+    return false;
+  }
+  if (gAllocationCount != 0) {
+    appendError(errors, "steady-state solver steps made " + std::to_string(gAllocationCount.load()) + " heap allocations");
+    return false;
+  }
+  if (solver.getStepArena().overflowCount() != overflowsAfterWarmup || profiler.sample(0).arenaOverflows != 0) {
+    appendError(errors, "step arena overflowed after warm-up");
+    return false;
+  }
+
+  // A scene that outgrows the arena falls back to the heap once, then fits again
+  for (int i = 0; i < 64; ++i) {
+    fixture.addPrimitive(sphere, glm::vec3(static_cast<float>(i % 8), 4.0f + static_cast<float>(i / 8), 6.0f));
+  }
+  fixture.step(solver, 2);
+  const size_t overflowsAfterGrowth = solver.getStepArena().overflowCount();
+  if (overflowsAfterGrowth == overflowsAfterWarmup) {
+    appendError(errors, "a larger scene should overflow the step arena once");
+    return false;
+  }
+  fixture.step(solver, 2);
+  if (solver.getStepArena().overflowCount() != overflowsAfterGrowth) {
+    appendError(errors, "step arena did not grow to fit the larger scene");
+    return false;
+  }
+
+  return true;
+}
+
+bool approxEqual(const glm::mat3& actual, const glm::mat3& expected, float epsilon) {
+  for (int c = 0; c < 3; ++c) {
+    if (glm::length(actual[c] - expected[c]) > epsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testMeshMassProperties(std::vector<std::string>& errors) {
+  // Unit cube: volume 1, I = m (h^2 + h^2) / 12 about every axis with h = 1
+  auto cube = makeBoxMesh(0.5f);
+  const auto& cubeProperties = cube->getMassProperties();
+  if (std::fabs(cubeProperties.volume - 1.0f) > 1e-5f || !approxEqual(cubeProperties.centerOfMass, glm::vec3(0.0f)) ||
+      !approxEqual(cubeProperties.inertia, glm::mat3(1.0f / 6.0f), 1e-5f)) {
+    appendError(errors, "unit cube mass properties are wrong");
+    return false;
+  }
+  if (&cube->getMassProperties() != &cubeProperties) {
+    appendError(errors, "mesh did not cache its mass properties");
+    return false;
+  }
+
+  // Stretch to a 2 x 1 x 0.5 box, then rotate it and move it off the origin
+  const glm::quat rotation = glm::angleAxis(glm::radians(30.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+  const glm::vec3 offset(3.0f, -1.0f, 2.0f);
+  for (auto& v : cube->getVerticesMutable()) {
+    v.position = offset + rotation * (v.position * glm::vec3(2.0f, 1.0f, 0.5f));
+  }
+  const glm::mat3 bodyInertia(glm::vec3(1.25f / 12.0f, 0.0f, 0.0f),
+                              glm::vec3(0.0f, 4.25f / 12.0f, 0.0f),
+                              glm::vec3(0.0f, 0.0f, 5.0f / 12.0f));
+  const glm::mat3 r = glm::mat3_cast(rotation);
+  const glm::mat3 expectedInertia = r * bodyInertia * glm::transpose(r);
+  const auto& boxProperties = cube->getMassProperties();
+  if (std::fabs(boxProperties.volume - 1.0f) > 1e-4f || !approxEqual(boxProperties.centerOfMass, offset) ||
+      !approxEqual(boxProperties.inertia, expectedInertia, 1e-4f)) {
+    appendError(errors, "rotated, offset box mass properties are wrong");
+    return false;
+  }
+
+  // Reversed winding gives the same result
+  std::vector<uint32_t> reversed = cube->getIndices();
+  for (size_t i = 0; i + 2 < reversed.size(); i += 3) {
+    std::swap(reversed[i + 1], reversed[i + 2]);
+  }
+  const auto inverted = std::make_shared<sauce::modeling::Mesh>(cube->getVertices(), reversed);
+  if (std::fabs(inverted->getMassProperties().volume - boxProperties.volume) > 1e-5f ||
+      !approxEqual(inverted->getMassProperties().inertia, boxProperties.inertia, 1e-5f)) {
+    appendError(errors, "inward winding changed the mass properties");
+    return false;
+  }
+
+  // A body of mass 2 has twice the unit-density inertia
+  const float invMass = sauce::RigidBodyComponent::meshInvMass(cube);
+  const glm::mat3 invInertia = sauce::RigidBodyComponent::meshInvInertiaTensor(cube, 0.5f);
+  if (std::fabs(invMass - 1.0f) > 1e-4f ||
+      !approxEqual(invInertia * (2.0f * expectedInertia), glm::mat3(1.0f), 1e-3f)) {
+    appendError(errors, "rigid body mass or inverse inertia does not match the mesh");
+    return false;
+  }
+
+  // A flat mesh encloses nothing and keeps the identity fallback
+  const std::vector<sauce::Vertex> quad {
+      makeRenderVertex(glm::vec3(-1.0f, -1.0f, 0.0f)), makeRenderVertex(glm::vec3(1.0f, -1.0f, 0.0f)),
+      makeRenderVertex(glm::vec3(1.0f, 1.0f, 0.0f)), makeRenderVertex(glm::vec3(-1.0f, 1.0f, 0.0f)),
+  };
+  const auto flat = std::make_shared<sauce::modeling::Mesh>(quad, std::vector<uint32_t> { 0, 1, 2, 0, 2, 3 });
+  if (flat->getMassProperties().hasVolume() ||
+      !approxEqual(sauce::RigidBodyComponent::meshInvInertiaTensor(flat, 1.0f), glm::mat3(1.0f), 0.0f)) {
+    appendError(errors, "flat mesh should report no volume");
+    return false;
+  }
+
+  return true;
+}
+
+bool testSubstepsStiffenStacks(std::vector<std::string>& errors) {
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo box;
+  box.shape = sauce::modeling::ColliderInfo::Shape::Box;
+  constexpr int kStackHeight = 8;
+  constexpr int kPasses = 4;
+
+  // Same projection budget either way: kPasses iterations of one step, or
+  // kPasses substeps of one projection each
+  auto sinking = [&](int substeps, int iterations) {
+    RigidBodyFixture fixture;
+    fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+    for (int i = 0; i < kStackHeight; ++i) {
+      fixture.addPrimitive(box, glm::vec3(0.0f, 0.5f + static_cast<float>(i), 0.0f));
+      fixture.bodies.back().setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f));
+    }
+    XPBDSolver solver;
+    solver.enableSleeping = false;
+    solver.substeps = substeps;
+    solver.solverIterations = iterations;
+    fixture.step(solver, 120);
+    return static_cast<float>(kStackHeight) - 0.5f - fixture.bodies.back().getPosition().y;
+  };
+
+  const float iterated = sinking(1, kPasses);
+  const float substepped = sinking(kPasses, 1);
+  if (!(substepped < 0.5f * iterated) || substepped > 1e-2f) {
+    appendError(errors, "substeps should hold a stack stiffer than the same number of iterations");
+    return false;
+  }
+
+  // Substeps integrate the orientation: half a turn per second about Z
+  constexpr float kHalfTurn = 3.14159265f;
+  sauce::modeling::ColliderInfo sphere;
+  RigidBodyFixture spinner;
+  spinner.addPrimitive(sphere, glm::vec3(0.0f));
+  spinner.bodies[0].setAngularVelocity(glm::vec3(0.0f, 0.0f, kHalfTurn));
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  solver.substeps = 4;
+  spinner.step(solver, 64);
+  const glm::vec3 axisX = spinner.bodies[0].getOrientation() * glm::vec3(1.0f, 0.0f, 0.0f);
+  // The first-order quaternion update loses a little speed to normalization
+  if (!approxEqual(axisX, glm::vec3(0.0f, 1.0f, 0.0f), 1e-2f) ||
+      !approxEqual(spinner.bodies[0].getAngularVelocity(), glm::vec3(0.0f, 0.0f, kHalfTurn), 1e-2f)) {
+    appendError(errors, "substeps should integrate and keep the angular velocity");
+    return false;
+  }
+
+  return true;
+}
+
+bool testOffCenterContactSpins(std::vector<std::string>& errors) {
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo box;
+  box.shape = sauce::modeling::ColliderInfo::Shape::Box;
+
+  // Tilted 30 degrees about Z, the box lands on the edge left of its center,
+  // so the plane's push turns it clockwise toward lying flat. Stopping that
+  // edge takes about -0.9 rad/s for a unit cube.
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+  fixture.addPrimitive(box, glm::vec3(0.0f, 0.69f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+  fixture.bodies[1].setOrientation(glm::angleAxis(0.5235988f, glm::vec3(0.0f, 0.0f, 1.0f)));
+  // Unit cube of unit mass: I = m (1 + 1) / 12 about every axis
+  fixture.bodies[1].setInvInertiaTensor(glm::mat3(6.0f));
+
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  solver.substeps = 4;
+  fixture.step(solver, 4);
+
+  const glm::vec3 spin = fixture.bodies[1].getAngularVelocity();
+  if (!(spin.z < -0.5f) || std::abs(spin.x) > 1e-2f || std::abs(spin.y) > 1e-2f) {
+    appendError(errors, "an off-center contact should spin the body about the contact's lever arm");
+    return false;
+  }
+
+  return true;
+}
+
+bool testHeightfieldCollider(std::vector<std::string>& errors) {
+  // Rolling terrain sampled on a 65 x 65 grid, quantized to 16 bits over [-1, 1]
+  constexpr uint32_t kSamples = 65;
+  constexpr float kSpacing = 0.25f;
+  constexpr float kHeightScale = 2.0f / 65535.0f;
+  auto terrainHeight = [](float x, float z) { return 0.5f * std::sin(x) * std::cos(0.7f * z); };
+  std::vector<uint16_t> samples(kSamples * kSamples);
+  std::vector<sauce::Vertex> gridVertices;
+  for (uint32_t j = 0; j < kSamples; ++j) {
+    for (uint32_t i = 0; i < kSamples; ++i) {
+      const float x = static_cast<float>(i) * kSpacing;
+      const float z = static_cast<float>(j) * kSpacing;
+      samples[j * kSamples + i] = static_cast<uint16_t>(std::lround((terrainHeight(x, z) + 1.0f) / kHeightScale));
+      gridVertices.push_back(makeRenderVertex(glm::vec3(x, -1.0f + kHeightScale * samples[j * kSamples + i], z)));
+    }
+  }
+  auto field = physics::HeightfieldCollider::fromHeights(samples, kSamples, kSamples, glm::vec2(kSpacing), kHeightScale, -1.0f);
+  if (!field || physics::HeightfieldCollider::fromHeights(samples, kSamples, kSamples - 1, glm::vec2(kSpacing), kHeightScale)) {
+    appendError(errors, "heightfield should accept exactly columns * rows samples");
+    return false;
+  }
+
+  // The same grid as a shuffled mesh triangulated along the other diagonal
+  std::vector<uint32_t> gridIndices;
+  for (uint32_t j = 0; j + 1 < kSamples; ++j) {
+    for (uint32_t i = 0; i + 1 < kSamples; ++i) {
+      const uint32_t v = j * kSamples + i;
+      gridIndices.insert(gridIndices.end(), { v, v + 1, v + kSamples, v + 1, v + kSamples + 1, v + kSamples });
+    }
+  }
+  std::mt19937 rng(7);
+  std::vector<uint32_t> order(gridVertices.size());
+  for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::shuffle(order.begin(), order.end(), rng);
+  std::vector<sauce::Vertex> shuffled(gridVertices.size());
+  std::vector<uint32_t> remap(gridVertices.size());
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    shuffled[i] = gridVertices[order[i]];
+    remap[order[i]] = i;
+  }
+  for (auto& index : gridIndices) index = remap[index];
+  const auto terrainMesh = std::make_shared<sauce::modeling::Mesh>(shuffled, gridIndices);
+  const auto fromMesh = physics::HeightfieldCollider::fromMesh(*terrainMesh);
+  if (!fromMesh || fromMesh->getColumns() != kSamples || fromMesh->getRows() != kSamples ||
+      physics::HeightfieldCollider::fromMesh(*makeOctahedronMesh(0.5f))) {
+    appendError(errors, "heightfield should rebuild a grid mesh and reject other meshes");
+    return false;
+  }
+
+  std::uniform_real_distribution<float> across(0.0f, kSpacing * static_cast<float>(kSamples - 1));
+  for (int n = 0; n < 200; ++n) {
+    const float x = across(rng);
+    const float z = across(rng);
+    const auto surface = field->surface(x, z);
+    const auto meshSurface = fromMesh->surface(x, z);
+    // Piecewise-linear terrain stays within the curvature of the sampled function
+    if (!surface || !meshSurface || std::fabs(surface->height - terrainHeight(x, z)) > 2e-2f ||
+        std::fabs(surface->height - meshSurface->height) > 1e-3f) {
+      appendError(errors, "heightfield surface does not follow the samples");
+      return false;
+    }
+  }
+  if (field->surface(-0.1f, 1.0f) || field->surface(1.0f, 16.1f)) {
+    appendError(errors, "heightfield should have no surface beyond its edges");
+    return false;
+  }
+
+  // Vertical rays land on the surface; oblique rays agree with and without the pyramid
+  const auto cellsOnly = *field;
+  field->buildMipPyramid();
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  for (int n = 0; n < 200; ++n) {
+    const float x = across(rng);
+    const float z = across(rng);
+    float distance = 0.0f;
+    glm::vec3 normal;
+    if (!field->raycast(glm::vec3(x, 3.0f, z), glm::vec3(0.0f, -1.0f, 0.0f), 10.0f, distance, normal) ||
+        std::fabs(3.0f - distance - field->surface(x, z)->height) > 1e-4f || normal.y <= 0.0f) {
+      appendError(errors, "vertical heightfield raycast missed the surface");
+      return false;
+    }
+
+    const glm::vec3 direction = glm::normalize(glm::vec3(unit(rng), -0.3f - std::fabs(unit(rng)), unit(rng)));
+    const glm::vec3 origin(x, 2.0f, z);
+    float cellsDistance = 0.0f;
+    float pyramidDistance = 0.0f;
+    const bool cellsHit = cellsOnly.raycast(origin, direction, 50.0f, cellsDistance, normal);
+    const bool pyramidHit = field->raycast(origin, direction, 50.0f, pyramidDistance, normal);
+    if (cellsHit != pyramidHit || (cellsHit && std::fabs(cellsDistance - pyramidDistance) > 1e-4f)) {
+      appendError(errors, "heightfield pyramid raycast disagrees with the cell walk");
+      return false;
+    }
+  }
+  float distance = 0.0f;
+  glm::vec3 normal;
+  if (field->raycast(glm::vec3(4.0f, 2.0f, 4.0f), glm::vec3(0.0f, 1.0f, 0.0f), 10.0f, distance, normal)) {
+    appendError(errors, "upward heightfield raycast should miss");
+    return false;
+  }
+
+  // Two bytes a sample against the mesh and its hierarchy
+  const physics::SphereBVH tree = physics::SphereBVH::fromMesh(*terrainMesh);
+  const size_t bvhBytes = tree.getNodes().size() * sizeof(physics::SphereBVHNode) +
+                          tree.getTriangleIndices().size() * sizeof(uint32_t) +
+                          terrainMesh->getVertexCount() * sizeof(glm::vec3) +
+                          terrainMesh->getIndexCount() * sizeof(uint32_t);
+  if (field->getMemoryBytes() * 8 > bvhBytes) {
+    appendError(errors, "heightfield should take far less memory than a triangle hierarchy");
+    return false;
+  }
+
+  // Primitive bodies settle on the placed terrain
+  auto terrain = std::make_shared<physics::HeightfieldCollider>(*field);
+  terrain->pose.position = glm::vec3(-8.0f, 0.0f, -8.0f);
+  sauce::modeling::ColliderInfo sphere;
+  sphere.radius = 0.25f;
+  sauce::modeling::ColliderInfo capsule;
+  capsule.shape = sauce::modeling::ColliderInfo::Shape::Capsule;
+  capsule.radius = 0.2f;
+  capsule.halfHeight = 0.3f;
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(sphere, glm::vec3(0.0f, 2.0f, 0.0f));
+  fixture.addPrimitive(capsule, glm::vec3(3.0f, 2.0f, -2.0f));
+  for (auto& body : fixture.bodies) {
+    body.setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f));
+  }
+  XPBDSolver solver;
+  solver.heightfields.push_back(terrain);
+  fixture.step(solver, 120);
+
+  float sphereDistance = 0.0f;
+  float capDistance = 0.0f;
+  const glm::vec3 lowerCap = fixture.bodies[1].getPosition() - glm::vec3(0.0f, capsule.halfHeight, 0.0f);
+  if (!terrain->pointDistance(fixture.bodies[0].getPosition(), sphereDistance, normal) ||
+      !terrain->pointDistance(lowerCap, capDistance, normal) ||
+      std::fabs(sphereDistance - sphere.radius) > 2e-2f || std::fabs(capDistance - capsule.radius) > 2e-2f) {
+    appendError(errors, "bodies should rest on the heightfield");
+    return false;
+  }
+
+  return true;
+}
+
+bool testConvexHullContacts(std::vector<std::string>& errors) {
+  using sauce::modeling::ConvexHull;
+
+  // Cube corners plus interior and face points: only the corners remain
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<glm::vec3> points;
+  for (int corner = 0; corner < 8; ++corner) {
+    points.emplace_back((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f);
+  }
+  for (int i = 0; i < 200; ++i) {
+    points.emplace_back(0.5f * unit(rng), 0.5f * unit(rng), i % 2 ? 0.5f : 0.5f * unit(rng));
+  }
+  const ConvexHull cube = ConvexHull::fromPoints(points);
+  bool contained = cube.vertices.size() == 8 && cube.indices.size() == 36;
+  for (size_t t = 0; contained && t < cube.indices.size(); t += 3) {
+    const glm::vec3 a = cube.vertices[cube.indices[t]];
+    const glm::vec3 normal = glm::cross(cube.vertices[cube.indices[t + 1]] - a, cube.vertices[cube.indices[t + 2]] - a);
+    for (const auto& p : points) {
+      contained = contained && glm::dot(normal, p - a) <= 1e-4f;
+    }
+  }
+  if (!contained) {
+    appendError(errors, "cube hull should keep the 8 corners and enclose every point");
+    return false;
+  }
+
+  // Points on a sphere: the cap bounds the hull's vertex count
+  std::vector<glm::vec3> round;
+  for (int i = 0; i < 500; ++i) {
+    round.push_back(glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng))));
+  }
+  const ConvexHull capped = ConvexHull::fromPoints(round, 32);
+  const ConvexHull full = ConvexHull::fromPoints(round, 1000);
+  if (capped.vertices.size() != 32 || full.vertices.size() <= 32 ||
+      std::fabs(capped.boundingRadius() - 1.0f) > 1e-4f) {
+    appendError(errors, "hull vertex cap should bound the hull");
+    return false;
+  }
+
+  // GJK/EPA on a hull matches the closed forms for the same box
+  auto cubeHull = std::make_shared<const ConvexHull>(cube);
+  for (int n = 0; n < 100; ++n) {
+    const glm::quat orientation = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+    physics::BoxCollider box;
+    box.orientation = orientation;
+    physics::ConvexCollider convex;
+    convex.hull = cubeHull;
+    convex.pose = { box.center, orientation };
+    physics::SphereCollider sphere;
+    sphere.radius = 0.3f;
+    sphere.center = glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.9f;
+
+    std::vector<physics::ContactInfo> expected;
+    std::vector<physics::ContactInfo> actual;
+    const bool boxHit = physics::collide(box, sphere, expected);
+    const bool convexHit = physics::collide(convex, sphere, actual);
+    // Grazing contacts may fall either way
+    if (boxHit && expected[0].depth < 1e-3f) continue;
+    if (boxHit != convexHit ||
+        (boxHit && (std::fabs(expected[0].depth - actual[0].depth) > 2e-3f ||
+                    glm::dot(expected[0].contactNormal, actual[0].contactNormal) < 0.99f))) {
+      appendError(errors, "hull-sphere contact disagrees with the box closed form");
+      return false;
+    }
+  }
+  physics::ConvexCollider apart;
+  apart.hull = cubeHull;
+  apart.pose.position = glm::vec3(1.2f, 0.0f, 0.0f);
+  physics::ConvexCollider origin;
+  origin.hull = cubeHull;
+  std::vector<physics::ContactInfo> contacts;
+  if (physics::collide(origin, apart, contacts)) {
+    appendError(errors, "separated hulls should not touch");
+    return false;
+  }
+  apart.pose.position = glm::vec3(0.9f, 0.05f, 0.0f);
+  if (!physics::collide(origin, apart, contacts) || std::fabs(contacts[0].depth - 0.1f) > 1e-3f ||
+      !approxEqual(contacts[0].contactNormal, glm::vec3(1.0f, 0.0f, 0.0f), 1e-3f)) {
+    appendError(errors, "overlapping hulls should report their overlap along x");
+    return false;
+  }
+
+  // A stack of hull bodies rests on a plane, and each pair builds up a manifold
+  sauce::modeling::ColliderInfo plane;
+  plane.shape = sauce::modeling::ColliderInfo::Shape::Plane;
+  sauce::modeling::ColliderInfo hull;
+  hull.shape = sauce::modeling::ColliderInfo::Shape::ConvexHull;
+  RigidBodyFixture fixture;
+  fixture.addPrimitive(plane, glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+  const auto cubeMesh = makeBoxMesh(0.5f);
+  for (int i = 0; i < 3; ++i) {
+    fixture.addMesh(cubeMesh, glm::vec3(0.1f * static_cast<float>(i), 0.5f + static_cast<float>(i), 0.0f));
+    fixture.bodies.back().setCollider(hull);
+    fixture.bodies.back().setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f));
+  }
+  XPBDSolver solver;
+  solver.enableSleeping = false;
+  fixture.step(solver, 240);
+  for (int i = 0; i < 3; ++i) {
+    if (std::fabs(fixture.bodies[i + 1].getPosition().y - (0.5f + static_cast<float>(i))) > 2e-2f) {
+      appendError(errors, "stacked hull bodies should rest on each other");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool testSimulationLODScheduler(std::vector<std::string>& errors) {
+  sauce::SimulationLODSettings settings;
+  settings.fullRatePixels = 100.0f;
+  settings.farDistance = 200.0f;
+  settings.maxTickDivisor = 8;
+  sauce::SimulationLODScheduler scheduler(settings);
+
+  // A 90 degree view 1000 px tall: a unit sphere 10 m away is 100 px tall
+  const sauce::SimulationLODScheduler::View view { glm::vec3(0.0f), 90.0f, 1000.0f };
+  const sauce::SimulationKey keys[3] { { { 0, 0 } }, { { 1, 0 } }, { { 2, 0 } } };
+  uint64_t tick = 0;
+  std::array<int, 3> covered {};
+  for (int frame = 0; frame < 8; ++frame) {
+    scheduler.beginFrame(view, tick);
+    const size_t nearSlot = scheduler.add(keys[0], glm::vec3(0.0f, 0.0f, -5.0f), 1.0f, 1.0f);
+    const size_t midSlot = scheduler.add(keys[1], glm::vec3(0.0f, 0.0f, -30.0f), 1.0f, 1.0f);
+    const size_t farSlot = scheduler.add(keys[2], glm::vec3(0.0f, 0.0f, -250.0f), 50.0f, 1.0f);
+    scheduler.assign(2);
+    if (scheduler.getLOD(nearSlot).tickDivisor != 1 || scheduler.getLOD(midSlot).tickDivisor != 4 ||
+        scheduler.getLOD(farSlot).tickDivisor != 8) {
+      appendError(errors, "simulation LOD picked the wrong tick divisors from distance and screen size");
+      return false;
+    }
+    for (int step = 0; step < 2; ++step) {
+      ++tick;
+      covered[0] += scheduler.beginStep(nearSlot, tick);
+      covered[1] += scheduler.beginStep(midSlot, tick);
+      covered[2] += scheduler.beginStep(farSlot, tick);
+    }
+  }
+  // Every step covers the ticks skipped since the previous one, so no
+  // simulated time is lost; the far object is behind by less than its divisor
+  if (covered[0] != 16 || covered[1] <= 12 || covered[1] > 16 || covered[2] <= 8 || covered[2] > 16) {
+    appendError(errors, "simulation LOD steps did not cover the elapsed ticks");
+    return false;
+  }
+  const float alpha = scheduler.getInterpolationAlpha(keys[2], tick, 0.5f);
+  if (alpha <= 0.0f || alpha > 1.0f || scheduler.getInterpolationAlpha(keys[0], tick, 0.5f) != 0.5f) {
+    appendError(errors, "simulation LOD interpolation alpha is out of range");
+    return false;
+  }
+  // An entity added in a destroyed one's slot starts without its history
+  if (scheduler.getInterpolationAlpha({ { 2, 1 } }, tick, 0.5f) != 0.5f) {
+    appendError(errors, "simulation LOD history outlived its entity");
+    return false;
+  }
+
+  // Over budget, the least visible objects lose substeps and rate first
+  settings.frameBudgetMs = 1.0f;
+  settings.farDistance = 1000.0f;
+  scheduler.setSettings(settings);
+  scheduler.beginFrame(view, tick);
+  std::array<size_t, 3> slots {};
+  for (int i = 0; i < 3; ++i) {
+    slots[i] = scheduler.add(keys[i], glm::vec3(0.0f, 0.0f, -2.0f - 3.0f * i), 1.0f, 100.0f, 4);
+  }
+  scheduler.assign(1);
+  for (size_t slot : slots) {
+    scheduler.beginStep(slot, tick + 1);
+  }
+  // 300 units of work took 3 ms
+  scheduler.reportFrameCost(3.0);
+  scheduler.beginFrame(view, tick + 1);
+  for (int i = 0; i < 3; ++i) {
+    slots[i] = scheduler.add(keys[i], glm::vec3(0.0f, 0.0f, -2.0f - 3.0f * i), 1.0f, 100.0f, 4);
+  }
+  scheduler.assign(1);
+  const auto& nearest = scheduler.getLOD(slots[0]);
+  const auto& farthest = scheduler.getLOD(slots[2]);
+  if (scheduler.getPredictedFrameMs() > settings.frameBudgetMs + 1e-6 ||
+      farthest.substeps * 8 / farthest.tickDivisor > nearest.substeps * 8 / nearest.tickDivisor) {
+    appendError(errors, "simulation LOD budget did not demote the least visible objects first");
+    return false;
+  }
+
+  // Per-body step lengths: a body stepped every fourth tick over four ticks
+  // keeps pace with one stepped every tick (up to the integration error of
+  // its longer steps), and a held body stays put
+  RigidBodyFixture fixture;
+  fixture.add(glm::vec3(0.0f));
+  fixture.add(glm::vec3(10.0f, 0.0f, 0.0f));
+  fixture.add(glm::vec3(20.0f, 0.0f, 0.0f));
+  for (auto& body : fixture.bodies) {
+    body.setExternalForces(glm::vec3(0.0f, -9.81f, 0.0f));
+  }
+  XPBDSolver solver;
+  for (int t = 1; t <= 16; ++t) {
+    const float deltaTimes[3] = { kStepDt, t % 4 == 0 ? 4.0f * kStepDt : 0.0f, 0.0f };
+    solver.solvePositions(fixture.bodies, kStepDt, deltaTimes);
+  }
+  const float fallEveryTick = fixture.bodies[0].getPosition().y;
+  const float fallEveryFourth = fixture.bodies[1].getPosition().y;
+  if (std::fabs(fixture.bodies[0].getVelocity().y - fixture.bodies[1].getVelocity().y) > 1e-4f ||
+      std::fabs(fallEveryTick - fallEveryFourth) > 0.25f * std::fabs(fallEveryTick) ||
+      fixture.bodies[2].getPosition() != glm::vec3(20.0f, 0.0f, 0.0f)) {
+    appendError(errors, "per-body step lengths did not cover the skipped ticks");
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+int main() {
+  std::vector<std::string> errors;
+
+  const bool islandsOk = testUnionFindIslandsIgnoreStaticBodies(errors);
+  const bool contactOk = testContactSeparatesOverlappingBodies(errors);
+  const bool parallelOk = testParallelIslandsMatchSerial(errors);
+  const bool narrowphaseOk = testParallelNarrowphaseMatchesSerial(errors);
+  const bool sleepOk = testRestingIslandFallsAsleep(errors);
+  const bool wakeOk = testSleepingIslandWakesWhenTouched(errors);
+  const bool stackWakeOk = testSleepingStackWakesTogether(errors);
+  const bool meshOk = testMeshContactsUseTriangleFeatures(errors);
+  const bool concaveOk = testMeshContactsKeepConcavePatches(errors);
+  const bool flatBvhOk = testFlatSphereBVHLayout(errors);
+  const bool tinyExtentOk = testSphereBVHTinyCentroidExtent(errors);
+  const bool refitOk = testSphereBVHRefitTracksDeformation(errors);
+  const bool strategiesOk = testSphereBVHBuildStrategiesAgree(errors);
+  const bool deepBvhOk = testSphereBVHDeepTreeCollides(errors);
+  const bool primitivePairsOk = testPrimitivePairContacts(errors);
+  const bool primitiveRestOk = testPrimitiveBodiesRestOnPlane(errors);
+  const bool speculativeOk = testSpeculativeContactsStopTunneling(errors);
+  const bool sceneQueryOk = testSceneQueryMatchesBruteForce(errors);
+  const bool kernelsOk = testOverlapKernelsMatchScalar(errors);
+  const bool profilerOk = testPhysicsProfilerRecordsSteps(errors);
+  const bool allocationsOk = testSteadyStepsDoNotAllocate(errors);
+  const bool massOk = testMeshMassProperties(errors);
+  const bool substepsOk = testSubstepsStiffenStacks(errors);
+  const bool spinOk = testOffCenterContactSpins(errors);
+  const bool heightfieldOk = testHeightfieldCollider(errors);
+  const bool convexOk = testConvexHullContacts(errors);
+  const bool lodOk = testSimulationLODScheduler(errors);
+
+  if (!errors.empty()) {
+    std::cerr << "XPBD rigid-body harness failed:\n";
+    for (const std::string& error : errors) {
+      std::cerr << "  - " << error << "\n";
+    }
+    return 1;
+  }
+
+  std::cout << "XPBD rigid-body harness passed\n";
+  std::cout << "  islands: " << (islandsOk ? "ok" : "failed") << "\n";
+  std::cout << "  contact: " << (contactOk ? "ok" : "failed") << "\n";
+  std::cout << "  parallel islands: " << (parallelOk ? "ok" : "failed") << "\n";
+  std::cout << "  parallel narrowphase: " << (narrowphaseOk ? "ok" : "failed") << "\n";
+  std::cout << "  sleep: " << (sleepOk ? "ok" : "failed") << "\n";
+  std::cout << "  wake on touch: " << (wakeOk ? "ok" : "failed") << "\n";
+  std::cout << "  sleeping stack wakes together: " << (stackWakeOk ? "ok" : "failed") << "\n";
+  std::cout << "  mesh contacts: " << (meshOk ? "ok" : "failed") << "\n";
+  std::cout << "  concave mesh contacts: " << (concaveOk ? "ok" : "failed") << "\n";
+  std::cout << "  flat sphere BVH: " << (flatBvhOk ? "ok" : "failed") << "\n";
+  std::cout << "  tiny centroid extent: " << (tinyExtentOk ? "ok" : "failed") << "\n";
+  std::cout << "  BVH refit: " << (refitOk ? "ok" : "failed") << "\n";
+  std::cout << "  BVH build strategies: " << (strategiesOk ? "ok" : "failed") << "\n";
+  std::cout << "  deep BVH traversal: " << (deepBvhOk ? "ok" : "failed") << "\n";
+  std::cout << "  primitive pairs: " << (primitivePairsOk ? "ok" : "failed") << "\n";
+  std::cout << "  primitives at rest: " << (primitiveRestOk ? "ok" : "failed") << "\n";
+  std::cout << "  speculative contacts: " << (speculativeOk ? "ok" : "failed") << "\n";
+  std::cout << "  scene query: " << (sceneQueryOk ? "ok" : "failed") << "\n";
+  std::cout << "  overlap kernels (" << physics::overlapKernelWidth() << " lanes): "
+            << (kernelsOk ? "ok" : "failed") << "\n";
+  std::cout << "  physics profiler: " << (profilerOk ? "ok" : "failed") << "\n";
+  std::cout << "  zero-allocation steps: " << (allocationsOk ? "ok" : "failed") << "\n";
+  std::cout << "  mesh mass properties: " << (massOk ? "ok" : "failed") << "\n";
+  std::cout << "  substepped rigid solve: " << (substepsOk ? "ok" : "failed") << "\n";
+  std::cout << "  off-center contact spin: " << (spinOk ? "ok" : "failed") << "\n";
+  std::cout << "  heightfield collider: " << (heightfieldOk ? "ok" : "failed") << "\n";
+  std::cout << "  convex hulls (GJK/EPA): " << (convexOk ? "ok" : "failed") << "\n";
+  std::cout << "  simulation LOD: " << (lodOk ? "ok" : "failed") << "\n";
+  return 0;
+}